@@ -33,6 +33,7 @@ public class PlasticSourceControl : ModuleRules
 				"DeveloperSettings",
 				"ToolMenus",
 				"ContentBrowser",
+				"DirectoryWatcher",
 			}
 		);
 
@@ -0,0 +1,51 @@
+// Copyright (c) 2025 Unity Technologies
+
+#include "PlasticSourceControlChangesetFilesCache.h"
+
+#include "PlasticSourceControlState.h"
+
+#include "Misc/ScopeLock.h"
+
+FPlasticSourceControlChangesetFilesCache::FPlasticSourceControlChangesetFilesCache()
+	: ChangesetsFiles(MaxNumChangesets)
+{
+}
+
+bool FPlasticSourceControlChangesetFilesCache::Find(const FString& InRepositorySpecification, const int32 InChangesetId, TArray<FPlasticSourceControlStateRef>& OutFiles)
+{
+	FScopeLock Lock(&CriticalSection);
+	if (!RepositorySpecification.Equals(InRepositorySpecification, ESearchCase::IgnoreCase))
+	{
+		return false;
+	}
+	if (const TArray<FPlasticSourceControlStateRef>* Files = ChangesetsFiles.FindAndTouch(InChangesetId))
+	{
+		OutFiles = *Files;
+		return true;
+	}
+	return false;
+}
+
+void FPlasticSourceControlChangesetFilesCache::Add(const FString& InRepositorySpecification, const int32 InChangesetId, const TArray<FPlasticSourceControlStateRef>& InFiles)
+{
+	FScopeLock Lock(&CriticalSection);
+	if (!RepositorySpecification.Equals(InRepositorySpecification, ESearchCase::IgnoreCase))
+	{
+		ChangesetsFiles.Empty(MaxNumChangesets);
+		RepositorySpecification = InRepositorySpecification;
+	}
+	ChangesetsFiles.Add(InChangesetId, InFiles);
+}
+
+void FPlasticSourceControlChangesetFilesCache::Empty()
+{
+	FScopeLock Lock(&CriticalSection);
+	ChangesetsFiles.Empty(MaxNumChangesets);
+	RepositorySpecification.Reset();
+}
+
+int32 FPlasticSourceControlChangesetFilesCache::Num() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return ChangesetsFiles.Num();
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2025 Unity Technologies
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+
+typedef TSharedRef<class FPlasticSourceControlState, ESPMode::ThreadSafe> FPlasticSourceControlStateRef;
+
+/**
+ * Bounded cache of the files of the changesets of the current repository, as listed by "cm log cs:<ChangesetId>",
+ * evicting the least recently used changesets, so that going back to a changeset in the View Changesets window doesn't run "cm log" again.
+ *
+ * @note Thread-safe: filled by the worker threads, and read by the game thread to display a changeset without waiting for a command.
+ */
+class FPlasticSourceControlChangesetFilesCache
+{
+public:
+	/** Maximum number of changesets cached */
+	static constexpr int32 MaxNumChangesets = 128;
+
+	FPlasticSourceControlChangesetFilesCache();
+
+	/** Find the files of a changeset of a repository, and mark it as the most recently used (returns false if not in the cache) */
+	bool Find(const FString& InRepositorySpecification, const int32 InChangesetId, TArray<FPlasticSourceControlStateRef>& OutFiles);
+
+	/** Cache the files of a changeset of a repository (emptying the cache if it was filled for another repository) */
+	void Add(const FString& InRepositorySpecification, const int32 InChangesetId, const TArray<FPlasticSourceControlStateRef>& InFiles);
+
+	/** Remove all the changesets from the cache */
+	void Empty();
+
+	/** Number of changesets in the cache */
+	int32 Num() const;
+
+private:
+	mutable FCriticalSection CriticalSection;
+
+	/** Repository of the changesets cached */
+	FString RepositorySpecification;
+
+	/** Files of the changesets, by ChangesetId */
+	TLruCache<int32, TArray<FPlasticSourceControlStateRef>> ChangesetsFiles;
+};
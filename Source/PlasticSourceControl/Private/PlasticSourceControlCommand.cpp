@@ -3,6 +3,7 @@
 #include "PlasticSourceControlCommand.h"
 
 #include "PlasticSourceControlModule.h"
+#include "PlasticSourceControlShell.h"
 
 #include "ISourceControlOperation.h"
 #include "HAL/PlatformTime.h"
@@ -12,10 +13,13 @@ FPlasticSourceControlCommand::FPlasticSourceControlCommand(const FSourceControlO
 	, Worker(InWorker)
 	, OperationCompleteDelegate(InOperationCompleteDelegate)
 	, bExecuteProcessed(0)
+	, bCancelled(0)
 	, bCommandSuccessful(false)
 	, bConnectionDropped(false)
 	, bAutoDelete(true)
 	, Concurrency(EConcurrency::Synchronous)
+	, Priority(EPlasticCommandPriority::Background)
+	, bDispatched(false)
 	, StartTimestamp(FPlatformTime::Seconds())
 {
 	// grab the providers settings here, so we don't access them once the worker thread is launched
@@ -27,7 +31,11 @@ FPlasticSourceControlCommand::FPlasticSourceControlCommand(const FSourceControlO
 
 bool FPlasticSourceControlCommand::DoWork()
 {
-	bCommandSuccessful = Worker->Execute(*this);
+	// Let the 'cm' commands run by the worker be cancelled through this command
+	PlasticSourceControlShell::FScopedCancellation Cancellation(&bCancelled);
+	// Let the 'cm' commands of an interactive operation use the shell reserved to them
+	PlasticSourceControlShell::FScopedInteractivePriority InteractivePriority(Priority == EPlasticCommandPriority::Interactive);
+	bCommandSuccessful = Worker->Execute(*this) && !IsCancelled();
 	FPlatformAtomics::InterlockedExchange(&bExecuteProcessed, 1);
 
 	return bCommandSuccessful;
@@ -38,6 +46,11 @@ void FPlasticSourceControlCommand::Abandon()
 	FPlatformAtomics::InterlockedExchange(&bExecuteProcessed, 1);
 }
 
+void FPlasticSourceControlCommand::Cancel()
+{
+	FPlatformAtomics::InterlockedExchange(&bCancelled, 1);
+}
+
 void FPlasticSourceControlCommand::DoThreadedWork()
 {
 	Concurrency = EConcurrency::Asynchronous;
@@ -57,8 +70,22 @@ ECommandResult::Type FPlasticSourceControlCommand::ReturnResults()
 	}
 
 	// run the completion delegate if we have one bound
-	ECommandResult::Type Result = bCommandSuccessful ? ECommandResult::Succeeded : ECommandResult::Failed;
+	ECommandResult::Type Result = IsCancelled() ? ECommandResult::Cancelled : (bCommandSuccessful ? ECommandResult::Succeeded : ECommandResult::Failed);
 	OperationCompleteDelegate.ExecuteIfBound(Operation, Result);
 
+	// and the delegates of the operations merged into this command
+	for (const TPair<FSourceControlOperationRef, FSourceControlOperationComplete>& CoalescedOperation : CoalescedOperations)
+	{
+		for (const FString& String : InfoMessages)
+		{
+			CoalescedOperation.Key->AddInfoMessge(FText::FromString(String));
+		}
+		for (const FString& String : ErrorMessages)
+		{
+			CoalescedOperation.Key->AddErrorMessge(FText::FromString(String));
+		}
+		CoalescedOperation.Value.ExecuteIfBound(CoalescedOperation.Key, Result);
+	}
+
 	return Result;
 }
@@ -13,6 +13,31 @@
 #include "PlasticSourceControlChangelist.h"
 #endif
 
+/** Scheduling priority of a command: interactive commands are dispatched to the worker threads ahead of background ones, and have a slot and a 'cm shell' reserved to them */
+enum class EPlasticCommandPriority : uint8
+{
+	/** Synchronous commands, and explicit user actions like CheckOut, CheckIn, Revert or Unlock */
+	Interactive,
+	/** Speculative commands, like the status updates of the Content Browser or the loading of the Changesets window */
+	Background,
+
+	Count
+};
+
+/** Statistics of the queue of commands of a priority, waiting to be dispatched to the worker threads */
+struct FPlasticCommandQueueStats
+{
+	/** Number of commands currently waiting in the queue */
+	int32 QueueDepth = 0;
+
+	/** Number of commands dispatched so far */
+	int32 NumDispatched = 0;
+
+	/** Total and maximum time spent by the dispatched commands waiting in the queue, in seconds */
+	double TotalWaitTime = 0.0;
+	double MaxWaitTime = 0.0;
+};
+
 /**
  * Used to execute Plastic commands multi-threaded.
  */
@@ -44,6 +69,15 @@ public:
 	/** Save any results and call any registered callbacks. */
 	ECommandResult::Type ReturnResults();
 
+	/** Request the cancellation of the command, from the Game Thread: the 'cm' command running, if any, is stopped, and the next ones fail immediately */
+	void Cancel();
+
+	/** Whether the cancellation of the command has been requested */
+	bool IsCancelled() const
+	{
+		return bCancelled != 0;
+	}
+
 public:
 	/** Path to the root of the Plastic workspace: can be the GameDir itself, or any parent directory (found by the "Connect" operation) */
 	FString PathToWorkspaceRoot;
@@ -57,9 +91,15 @@ public:
 	/** Delegate to notify when this operation completes */
 	FSourceControlOperationComplete OperationCompleteDelegate;
 
+	/** Operations of other callers merged into this command before it started, with the delegates to notify when it completes */
+	TArray<TPair<FSourceControlOperationRef, FSourceControlOperationComplete>> CoalescedOperations;
+
 	/**If true, this command has been processed by the source control thread*/
 	volatile int32 bExecuteProcessed;
 
+	/**If true, the cancellation of this command has been requested*/
+	volatile int32 bCancelled;
+
 	/**If true, the source control command succeeded*/
 	bool bCommandSuccessful;
 
@@ -90,6 +130,12 @@ public:
 	/** Whether we are running multi-treaded in the background, or blocking the main thread */
 	EConcurrency::Type Concurrency;
 
+	/** Priority of the command in the queue of the provider, waiting to be dispatched to the worker threads */
+	EPlasticCommandPriority Priority;
+
+	/** If true, the command has been dispatched by the provider to the worker threads */
+	bool bDispatched;
+
 	/** Timestamp of when the command was issued */
 	const double StartTimestamp;
 
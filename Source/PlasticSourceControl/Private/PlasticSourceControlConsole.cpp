@@ -2,6 +2,9 @@
 
 #include "PlasticSourceControlConsole.h"
 
+#include "PlasticSourceControlModule.h"
+#include "PlasticSourceControlProvider.h"
+#include "PlasticSourceControlShell.h"
 #include "PlasticSourceControlUtils.h"
 
 #include "ISourceControlModule.h"
@@ -17,11 +20,35 @@ void FPlasticSourceControlConsole::Register()
 			TEXT("Type 'cm showcommands' to get a command list."),
 			FConsoleCommandWithArgsDelegate::CreateRaw(this, &FPlasticSourceControlConsole::ExecutePlasticConsoleCommand));
 	}
+	if (!ShellLatencyConsoleCommand.IsValid())
+	{
+		ShellLatencyConsoleCommand = MakeUnique<FAutoConsoleCommand>(
+			TEXT("PlasticSCM.ShellLatency"),
+			TEXT("Log the latency histogram of the commands run by the background 'cm shell' processes."),
+			FConsoleCommandDelegate::CreateRaw(this, &FPlasticSourceControlConsole::ExecuteShellLatencyConsoleCommand));
+	}
+	if (!MemoryReportConsoleCommand.IsValid())
+	{
+		MemoryReportConsoleCommand = MakeUnique<FAutoConsoleCommand>(
+			TEXT("PlasticSCM.MemoryReport"),
+			TEXT("Log the memory used by the cache of the states of the files, and the memory saved by interning branches, users, workspaces and repository specs."),
+			FConsoleCommandDelegate::CreateRaw(this, &FPlasticSourceControlConsole::ExecuteMemoryReportConsoleCommand));
+	}
+	if (!CommandQueueConsoleCommand.IsValid())
+	{
+		CommandQueueConsoleCommand = MakeUnique<FAutoConsoleCommand>(
+			TEXT("PlasticSCM.CommandQueue"),
+			TEXT("Log the depth of the queues of commands, and the time the commands waited in them, for interactive and background commands."),
+			FConsoleCommandDelegate::CreateRaw(this, &FPlasticSourceControlConsole::ExecuteCommandQueueConsoleCommand));
+	}
 }
 
 void FPlasticSourceControlConsole::Unregister()
 {
 	CmConsoleCommand.Reset();
+	ShellLatencyConsoleCommand.Reset();
+	MemoryReportConsoleCommand.Reset();
+	CommandQueueConsoleCommand.Reset();
 }
 
 void FPlasticSourceControlConsole::ExecutePlasticConsoleCommand(const TArray<FString>& a_args)
@@ -44,3 +71,18 @@ void FPlasticSourceControlConsole::ExecutePlasticConsoleCommand(const TArray<FSt
 		UE_LOG(LogSourceControl, Log, TEXT("Output:\n%s"), *Results);
 	}
 }
+
+void FPlasticSourceControlConsole::ExecuteShellLatencyConsoleCommand()
+{
+	PlasticSourceControlShell::LogLatencyHistogram();
+}
+
+void FPlasticSourceControlConsole::ExecuteMemoryReportConsoleCommand()
+{
+	FPlasticSourceControlModule::Get().GetProvider().GetStateCache().LogMemoryReport();
+}
+
+void FPlasticSourceControlConsole::ExecuteCommandQueueConsoleCommand()
+{
+	FPlasticSourceControlModule::Get().GetProvider().LogCommandQueueStats();
+}
@@ -21,6 +21,24 @@ private:
 	// Unity Version Control Command Line Interface: Run 'cm' commands directly from the Unreal Editor Console.
 	void ExecutePlasticConsoleCommand(const TArray<FString>& a_args);
 
+	// Log the latency histogram of the commands run by the background 'cm shell' processes.
+	void ExecuteShellLatencyConsoleCommand();
+
+	// Log the memory used by the cache of the states of the files, and the memory saved by interning their strings.
+	void ExecuteMemoryReportConsoleCommand();
+
+	// Log the depth of the queues of commands, and the time the commands waited in them, per priority.
+	void ExecuteCommandQueueConsoleCommand();
+
 	/** Console command for interacting with 'cm' CLI directly */
 	TUniquePtr<FAutoConsoleCommand> CmConsoleCommand;
+
+	/** Console command to log the latency histogram of the 'cm shell' commands */
+	TUniquePtr<FAutoConsoleCommand> ShellLatencyConsoleCommand;
+
+	/** Console command to log the memory used by the cache of states */
+	TUniquePtr<FAutoConsoleCommand> MemoryReportConsoleCommand;
+
+	/** Console command to log the statistics of the queues of commands */
+	TUniquePtr<FAutoConsoleCommand> CommandQueueConsoleCommand;
 };
@@ -0,0 +1,19 @@
+// Copyright (c) 2025 Unity Technologies
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "PlasticSourceControlEditorSettings.generated.h"
+
+/** Editor Preferences for Unity Version Control (formerly Plastic SCM), shared by all the projects of the user. Saved in the global EditorSettings.ini of the user */
+UCLASS(config = EditorSettings, globaluserconfig, meta = (DisplayName = "Source Control - Unity Version Control"))
+class UPlasticSourceControlEditorSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	/** Size limit in MiB of the cache of the revisions downloaded to diff assets, shared by all the projects on this computer; the least recently used revisions are evicted above it (default to 1024 MiB, 0 to disable) */
+	UPROPERTY(config, EditAnywhere, Category = "Unity Version Control", meta = (ClampMin = 0))
+	int32 RevisionCacheSizeMB = 1024;
+};
@@ -0,0 +1,56 @@
+// Copyright (c) 2025 Unity Technologies
+
+#include "PlasticSourceControlInternedString.h"
+
+#include "Misc/ScopeLock.h"
+#include "Templates/UniquePtr.h"
+
+const FString FPlasticSourceControlInternedString::EmptyString;
+
+// Case-sensitive keys, so that strings differing only by case keep their own display
+struct FInternedStringKeyFuncs : BaseKeyFuncs<TUniquePtr<FString>, FString, false>
+{
+	static const FString& GetSetKey(const TUniquePtr<FString>& InElement)
+	{
+		return *InElement;
+	}
+	static bool Matches(const FString& InLhs, const FString& InRhs)
+	{
+		return InLhs.Equals(InRhs, ESearchCase::CaseSensitive);
+	}
+	static uint32 GetKeyHash(const FString& InKey)
+	{
+		return FCrc::StrCrc32(*InKey);
+	}
+};
+
+// The interned strings are allocated separately from the table, so that their address is stable when the table grows
+static TSet<TUniquePtr<FString>, FInternedStringKeyFuncs> InternedStrings;
+static FCriticalSection InternedStringsCriticalSection;
+
+const FString* FPlasticSourceControlInternedString::Intern(const FString& InString)
+{
+	if (InString.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	FScopeLock Lock(&InternedStringsCriticalSection);
+	if (const TUniquePtr<FString>* InternedString = InternedStrings.Find(InString))
+	{
+		return InternedString->Get();
+	}
+	const FSetElementId InternedStringId = InternedStrings.Add(MakeUnique<FString>(InString));
+	return InternedStrings[InternedStringId].Get();
+}
+
+void FPlasticSourceControlInternedString::GetTableStats(int32& OutNumStrings, SIZE_T& OutAllocatedSize)
+{
+	FScopeLock Lock(&InternedStringsCriticalSection);
+	OutNumStrings = InternedStrings.Num();
+	OutAllocatedSize = InternedStrings.GetAllocatedSize();
+	for (const TUniquePtr<FString>& InternedString : InternedStrings)
+	{
+		OutAllocatedSize += sizeof(FString) + InternedString->GetAllocatedSize();
+	}
+}
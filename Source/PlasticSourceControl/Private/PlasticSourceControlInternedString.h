@@ -0,0 +1,83 @@
+// Copyright (c) 2025 Unity Technologies
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Immutable string interned in a global table, for the low-cardinality strings repeated in the states of many files:
+ * branches, users, workspaces and repository specs.
+ *
+ * Each distinct string is allocated only once, and shared by all the states using it, so a copy only costs a pointer.
+ * Interning is thread-safe, since the states are parsed by worker threads; interned strings are never freed,
+ * their number being bounded by the number of branches, users and workspaces seen during the session.
+ *
+ * Comparisons with FString keep the case-insensitive semantic of FString.
+ */
+class FPlasticSourceControlInternedString
+{
+public:
+	FPlasticSourceControlInternedString() = default;
+
+	FPlasticSourceControlInternedString(const FString& InString)
+		: String(Intern(InString))
+	{
+	}
+
+	FPlasticSourceControlInternedString& operator=(const FString& InString)
+	{
+		String = Intern(InString);
+		return *this;
+	}
+
+	/** The interned string, or an empty string */
+	const FString& Get() const
+	{
+		return String ? *String : EmptyString;
+	}
+
+	const TCHAR* operator*() const
+	{
+		return *Get();
+	}
+
+	bool IsEmpty() const
+	{
+		return String == nullptr;
+	}
+
+	void Empty()
+	{
+		String = nullptr;
+	}
+
+	friend bool operator==(const FPlasticSourceControlInternedString& InLhs, const FPlasticSourceControlInternedString& InRhs)
+	{
+		// Note: the same string is always interned at the same address, but strings differing only by case need a comparison
+		return (InLhs.String == InRhs.String) || (InLhs.Get() == InRhs.Get());
+	}
+	friend bool operator!=(const FPlasticSourceControlInternedString& InLhs, const FPlasticSourceControlInternedString& InRhs)
+	{
+		return !(InLhs == InRhs);
+	}
+	friend bool operator==(const FPlasticSourceControlInternedString& InLhs, const FString& InRhs)
+	{
+		return InLhs.Get() == InRhs;
+	}
+	friend bool operator!=(const FPlasticSourceControlInternedString& InLhs, const FString& InRhs)
+	{
+		return InLhs.Get() != InRhs;
+	}
+
+	/** Number of distinct strings interned, and memory allocated for them and the table */
+	static void GetTableStats(int32& OutNumStrings, SIZE_T& OutAllocatedSize);
+
+private:
+	/** Find or add a string in the global table (returns null for an empty string) */
+	static const FString* Intern(const FString& InString);
+
+	static const FString EmptyString;
+
+	/** Pointer to the string interned in the global table, or null for an empty string */
+	const FString* String = nullptr;
+};
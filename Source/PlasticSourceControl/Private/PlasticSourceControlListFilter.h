@@ -0,0 +1,275 @@
+// Copyright (c) 2025 Unity Technologies
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "Async/Future.h"
+
+/**
+ * Filtering and sorting of the items of a large list view (changesets, branches, locks) by a search text, without stalling the editor while typing.
+ *
+ * - each item has a precomputed lower-cased search string, so that a simple search text (words without any operator) is matched without case folding,
+ * - a search text extending the previous one only filters the items that matched the previous one,
+ * - filtering many items runs on a background task, and its results are published to the game thread by Tick(),
+ * - the order of the items is cached for each sort (column and direction), so that filtering never sorts the items again.
+ *
+ * Search texts using the syntax of TTextFilter (operators, quotes, key=value...) are evaluated by the full filter on the game thread instead.
+ *
+ * @note Not thread-safe: all the methods must be called from the game thread.
+ */
+template<typename ItemType>
+class TPlasticSourceControlListFilter
+{
+public:
+	/** Minimum number of items to filter in the background instead of on the game thread */
+	static constexpr int32 MinNumItemsToFilterAsync = 5000;
+
+	/**
+	 * Set the items of the list, and build their search index.
+	 * @param	InItems						All the items of the list, in their default order
+	 * @param	InPopulateSearchStrings		Strings of an item that the search text is matched against
+	 */
+	void SetItems(const TArray<ItemType>& InItems, TFunctionRef<void(const ItemType&, TArray<FString>&)> InPopulateSearchStrings)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TPlasticSourceControlListFilter::SetItems);
+
+		Items = InItems;
+
+		// Join the strings of each item with a separator that can't be part of a search word, so that a word cannot match across two strings
+		TSharedRef<TArray<FString>, ESPMode::ThreadSafe> NewSearchIndex = MakeShared<TArray<FString>, ESPMode::ThreadSafe>();
+		NewSearchIndex->Reserve(Items.Num());
+		TArray<FString> SearchStrings;
+		for (const ItemType& Item : Items)
+		{
+			SearchStrings.Reset();
+			InPopulateSearchStrings(Item, SearchStrings);
+			NewSearchIndex->Add(FString::Join(SearchStrings, TEXT("\n")).ToLower());
+		}
+		SearchIndex = NewSearchIndex;
+
+		// Drop the results of the filter of the previous items, and their sorts
+		FilterTask = TFuture<TArray<int32>>();
+		MatchingIndices.Reset();
+		FilteredText.Reset();
+		bIsFiltered = false;
+		SortedIndicesCache.Reset();
+	}
+
+	/**
+	 * Filter the items by a search text.
+	 * @param	InFilterText	The search text, as typed by the user
+	 * @param	InPredicate		The full filter of an item, only used for a search text using the syntax of TTextFilter
+	 * @returns true if the results are available now, false if they will be published by a later Tick()
+	 */
+	bool Filter(const FString& InFilterText, TFunctionRef<bool(const ItemType&)> InPredicate)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TPlasticSourceControlListFilter::Filter);
+
+		const FString FilterText = InFilterText.ToLower();
+		TArray<FString> Words;
+		if (!ParseSimpleFilterText(FilterText, Words))
+		{
+			FilterTask = TFuture<TArray<int32>>();
+			MatchingIndices.Reset();
+			for (int32 Index = 0; Index < Items.Num(); Index++)
+			{
+				if (InPredicate(Items[Index]))
+				{
+					MatchingIndices.Add(Index);
+				}
+			}
+			// These results can't be refined by a longer search text
+			FilteredText.Reset();
+			bIsFiltered = false;
+			return true;
+		}
+
+		// A search text extending the previous one can only match a subset of the items that matched the previous one
+		TArray<int32> Candidates;
+		if (bIsFiltered && FilterText.StartsWith(FilteredText, ESearchCase::CaseSensitive))
+		{
+			Candidates = MatchingIndices;
+		}
+		else
+		{
+			Candidates.SetNumUninitialized(Items.Num());
+			for (int32 Index = 0; Index < Items.Num(); Index++)
+			{
+				Candidates[Index] = Index;
+			}
+		}
+
+		if ((Words.Num() == 0) || (Candidates.Num() < MinNumItemsToFilterAsync))
+		{
+			FilterTask = TFuture<TArray<int32>>();
+			MatchingIndices = FilterSearchIndex(*SearchIndex, Candidates, Words);
+			FilteredText = FilterText;
+			bIsFiltered = true;
+			return true;
+		}
+
+		// Any previous filter still running in the background is superseded, its results are discarded
+		PendingFilterText = FilterText;
+		FilterTask = Async(EAsyncExecution::ThreadPool, [SearchIndex = SearchIndex, Candidates = MoveTemp(Candidates), Words = MoveTemp(Words)]()
+		{
+			return FilterSearchIndex(*SearchIndex, Candidates, Words);
+		});
+		return false;
+	}
+
+	/**
+	 * Publish the results of the filter running in the background, if it has completed.
+	 * @returns true if new results have been published
+	 */
+	bool Tick()
+	{
+		if (!FilterTask.IsValid() || !FilterTask.IsReady())
+		{
+			return false;
+		}
+
+		MatchingIndices = FilterTask.Get();
+		FilterTask = TFuture<TArray<int32>>();
+		FilteredText = MoveTemp(PendingFilterText);
+		bIsFiltered = true;
+		return true;
+	}
+
+	/** Whether a filter is running in the background */
+	bool IsFiltering() const
+	{
+		return FilterTask.IsValid();
+	}
+
+	/** The items matching the last filter, in their default order */
+	void GetRows(TArray<ItemType>& OutRows) const
+	{
+		OutRows.Reset(MatchingIndices.Num());
+		for (const int32 Index : MatchingIndices)
+		{
+			OutRows.Add(Items[Index]);
+		}
+	}
+
+	/**
+	 * The items matching the last filter, sorted.
+	 * @param	InSortKey	Identify the sort (eg. the columns and their direction) to cache the order of the items
+	 * @param	InLess		Comparison of two items, only used if the order of the items is not cached yet for this sort
+	 * @param	OutRows		The items matching the last filter, sorted
+	 */
+	void GetSortedRows(const FString& InSortKey, TFunctionRef<bool(const ItemType&, const ItemType&)> InLess, TArray<ItemType>& OutRows)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TPlasticSourceControlListFilter::GetSortedRows);
+
+		const TArray<int32>* SortedIndices = SortedIndicesCache.Find(InSortKey);
+		if (SortedIndices == nullptr)
+		{
+			TArray<int32> Indices;
+			Indices.SetNumUninitialized(Items.Num());
+			for (int32 Index = 0; Index < Items.Num(); Index++)
+			{
+				Indices[Index] = Index;
+			}
+			Indices.Sort([this, &InLess](const int32 InLhs, const int32 InRhs)
+			{
+				return InLess(Items[InLhs], Items[InRhs]);
+			});
+			SortedIndices = &SortedIndicesCache.Add(InSortKey, MoveTemp(Indices));
+		}
+
+		OutRows.Reset(MatchingIndices.Num());
+		if (MatchingIndices.Num() == Items.Num())
+		{
+			for (const int32 Index : *SortedIndices)
+			{
+				OutRows.Add(Items[Index]);
+			}
+		}
+		else
+		{
+			TBitArray<> Matches(false, Items.Num());
+			for (const int32 Index : MatchingIndices)
+			{
+				Matches[Index] = true;
+			}
+			for (const int32 Index : *SortedIndices)
+			{
+				if (Matches[Index])
+				{
+					OutRows.Add(Items[Index]);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Split a lower-cased search text in words, if it doesn't use any operator of the syntax of TTextFilter.
+	 * @returns false if the search text needs to be evaluated by TTextFilter
+	 */
+	static bool ParseSimpleFilterText(const FString& InFilterText, TArray<FString>& OutWords)
+	{
+		InFilterText.ParseIntoArrayWS(OutWords);
+		for (const FString& Word : OutWords)
+		{
+			int32 Index;
+			if (Word.StartsWith(TEXT("-")) || Word.StartsWith(TEXT("+")) || Word.Contains(TEXT("..."))
+				|| Word.FindChar(TEXT('"'), Index) || Word.FindChar(TEXT('\''), Index) || Word.FindChar(TEXT('('), Index) || Word.FindChar(TEXT(')'), Index)
+				|| Word.FindChar(TEXT('|'), Index) || Word.FindChar(TEXT('&'), Index) || Word.FindChar(TEXT('!'), Index)
+				|| Word.FindChar(TEXT('='), Index) || Word.FindChar(TEXT('<'), Index) || Word.FindChar(TEXT('>'), Index) || Word.FindChar(TEXT(':'), Index)
+				|| (Word == TEXT("and")) || (Word == TEXT("or")) || (Word == TEXT("not")))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+private:
+	/** Indices of the candidate items with a search string containing all the words */
+	static TArray<int32> FilterSearchIndex(const TArray<FString>& InSearchIndex, const TArray<int32>& InCandidates, const TArray<FString>& InWords)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TPlasticSourceControlListFilter::FilterSearchIndex);
+
+		TArray<int32> Result;
+		Result.Reserve(InCandidates.Num());
+		for (const int32 Index : InCandidates)
+		{
+			const FString& SearchString = InSearchIndex[Index];
+			bool bMatches = true;
+			for (const FString& Word : InWords)
+			{
+				if (!SearchString.Contains(Word, ESearchCase::CaseSensitive))
+				{
+					bMatches = false;
+					break;
+				}
+			}
+			if (bMatches)
+			{
+				Result.Add(Index);
+			}
+		}
+		return Result;
+	}
+
+	/** All the items of the list, in their default order */
+	TArray<ItemType> Items;
+
+	/** Lower-cased search string of each item, shared with the filter running in the background */
+	TSharedRef<TArray<FString>, ESPMode::ThreadSafe> SearchIndex = MakeShared<TArray<FString>, ESPMode::ThreadSafe>();
+
+	/** Indices of the items matching the last filter, in ascending order */
+	TArray<int32> MatchingIndices;
+
+	/** Lower-cased search text of the last filter, if its results can be refined by a longer search text */
+	FString FilteredText;
+	bool bIsFiltered = false;
+
+	/** Filter running in the background, and its search text */
+	TFuture<TArray<int32>> FilterTask;
+	FString PendingFilterText;
+
+	/** Order of the items for each sort already used */
+	TMap<FString, TArray<int32>> SortedIndicesCache;
+};
@@ -30,3 +30,77 @@ public:
 
 typedef TSharedRef<class FPlasticSourceControlLock, ESPMode::ThreadSafe> FPlasticSourceControlLockRef;
 typedef TSharedPtr<class FPlasticSourceControlLock, ESPMode::ThreadSafe> FPlasticSourceControlLockPtr;
+
+/**
+ * Index of a list of locks by their server path, to find the locks of each file in constant time instead of scanning the whole list.
+ */
+class FPlasticSourceControlLocksIndex
+{
+public:
+	explicit FPlasticSourceControlLocksIndex(const TArray<FPlasticSourceControlLockRef>& InLocks)
+		: Locks(InLocks)
+	{
+		LockIndexesByPath.Reserve(Locks.Num());
+		for (int32 LockIndex = 0; LockIndex < Locks.Num(); LockIndex++)
+		{
+			LockIndexesByPath.FindOrAdd(Locks[LockIndex]->Path).Add(LockIndex);
+		}
+	}
+
+	/** All the locks, in their original order */
+	const TArray<FPlasticSourceControlLockRef>& GetLocks() const
+	{
+		return Locks;
+	}
+
+	/** Find the locks of a server path (multiple matching locks can only happen if multiple destination branches are configured) */
+	TArray<FPlasticSourceControlLockRef> FindByPath(const FString& InServerPath) const
+	{
+		TArray<FPlasticSourceControlLockRef> MatchingLocks;
+		if (const TArray<int32>* LockIndexes = LockIndexesByPath.Find(InServerPath))
+		{
+			MatchingLocks.Reserve(LockIndexes->Num());
+			for (const int32 LockIndex : *LockIndexes)
+			{
+				MatchingLocks.Add(Locks[LockIndex]);
+			}
+		}
+		return MatchingLocks;
+	}
+
+	/**
+	 * Find the first lock (in the original order) with a server path ending the absolute path of a file.
+	 *
+	 * Server paths start with a slash, so only the suffixes of the file starting at a slash are looked up, one per directory level.
+	 */
+	FPlasticSourceControlLockPtr FindBySuffix(const FString& InFile) const
+	{
+		int32 FirstLockIndex = INDEX_NONE;
+		for (int32 SlashIndex = InFile.Len() - 1; SlashIndex >= 0; SlashIndex--)
+		{
+			if (InFile[SlashIndex] == TEXT('/'))
+			{
+				if (const TArray<int32>* LockIndexes = LockIndexesByPath.Find(InFile.RightChop(SlashIndex)))
+				{
+					if ((FirstLockIndex == INDEX_NONE) || ((*LockIndexes)[0] < FirstLockIndex))
+					{
+						FirstLockIndex = (*LockIndexes)[0];
+					}
+				}
+			}
+		}
+		if (FirstLockIndex != INDEX_NONE)
+		{
+			return Locks[FirstLockIndex];
+		}
+		return nullptr;
+	}
+
+private:
+	TArray<FPlasticSourceControlLockRef> Locks;
+
+	/** Indexes of the locks in the list, by server path (case insensitive, like the comparisons of FString) */
+	TMap<FString, TArray<int32>> LockIndexesByPath;
+};
+
+typedef TSharedPtr<const FPlasticSourceControlLocksIndex, ESPMode::ThreadSafe> FPlasticSourceControlLocksIndexPtr;
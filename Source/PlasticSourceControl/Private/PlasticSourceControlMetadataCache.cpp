@@ -0,0 +1,238 @@
+// Copyright (c) 2025 Unity Technologies
+
+#include "PlasticSourceControlMetadataCache.h"
+
+#include "PlasticSourceControlBranch.h"
+#include "PlasticSourceControlChangeset.h"
+
+#include "ISourceControlModule.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace PlasticSourceControlMetadataCache
+{
+
+// Identify the files of the cache, and their format version (to increment on any change of the format)
+static const uint32 CacheFileMagic = 0x50434D43; // "PCMC"
+static const int32 CacheFileVersion = 2;
+
+// Serialize the accesses of the worker threads to the files of the cache
+static FCriticalSection CacheCriticalSection;
+
+FString GetCacheDir()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PlasticSourceControl"));
+}
+
+// Path of the file caching a kind of records for a repository (the repository is also stored in the file to detect collisions)
+static FString GetCacheFilename(const FString& InCacheDir, const FString& InRepositorySpecification, const TCHAR* InKind)
+{
+	const uint32 RepositoryHash = FCrc::StrCrc32(*InRepositorySpecification.ToLower());
+	return FPaths::Combine(InCacheDir, FString::Printf(TEXT("%08x-%s.bin"), RepositoryHash, InKind));
+}
+
+// Write the file through a temporary file, so that another process never reads a partially written file
+// Note: the temporary file is unique to this process and call, so that two editors of the same project never write to the same one
+static bool WriteCacheFile(const FString& InFilename, const TArray<uint8>& InData)
+{
+	const FString TempFilename = FString::Printf(TEXT("%s-%u-%s.tmp"), *InFilename, FPlatformProcess::GetCurrentProcessId(), *FGuid::NewGuid().ToString());
+	if (!FFileHelper::SaveArrayToFile(InData, *TempFilename))
+	{
+		UE_LOG(LogSourceControl, Warning, TEXT("Failed to write the cache file %s"), *TempFilename);
+		return false;
+	}
+	const bool bMoved = IFileManager::Get().Move(*InFilename, *TempFilename, true, true);
+	if (!bMoved)
+	{
+		IFileManager::Get().Delete(*TempFilename, false, false, true);
+	}
+	return bMoved;
+}
+
+// Read the file and check its header
+static bool ReadCacheFile(const FString& InFilename, const FString& InRepositorySpecification, TArray<uint8>& OutData, FMemoryReader& OutReader)
+{
+	if (!FFileHelper::LoadFileToArray(OutData, *InFilename, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	FString RepositorySpecification;
+	OutReader << Magic;
+	OutReader << Version;
+	if (OutReader.IsError() || (Magic != CacheFileMagic) || (Version != CacheFileVersion))
+	{
+		UE_LOG(LogSourceControl, Log, TEXT("Discard the cache file %s from another version"), *InFilename);
+		return false;
+	}
+	OutReader << RepositorySpecification;
+	return !OutReader.IsError() && RepositorySpecification.Equals(InRepositorySpecification, ESearchCase::IgnoreCase);
+}
+
+static void WriteHeader(FMemoryWriter& InWriter, const FString& InRepositorySpecification)
+{
+	uint32 Magic = CacheFileMagic;
+	int32 Version = CacheFileVersion;
+	FString RepositorySpecification = InRepositorySpecification;
+	InWriter << Magic;
+	InWriter << Version;
+	InWriter << RepositorySpecification;
+}
+
+bool LoadChangesets(const FString& InCacheDir, const FString& InRepositorySpecification, FChangesetsCache& OutCache)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlMetadataCache::LoadChangesets);
+
+	FScopeLock Lock(&CacheCriticalSection);
+
+	const FString Filename = GetCacheFilename(InCacheDir, InRepositorySpecification, TEXT("Changesets"));
+	TArray<uint8> Data;
+	FMemoryReader Reader(Data, true);
+	if (!ReadCacheFile(Filename, InRepositorySpecification, Data, Reader))
+	{
+		return false;
+	}
+
+	int32 NumChangesets = 0;
+	Reader << OutCache.FromDate;
+	Reader << OutCache.FullRefreshDate;
+	Reader << NumChangesets;
+	// Each changeset takes at least a few bytes, so a larger count can only come from a corrupted file
+	if (Reader.IsError() || (NumChangesets < 0) || (NumChangesets > Data.Num()))
+	{
+		return false;
+	}
+	OutCache.Changesets.Reset(NumChangesets);
+	for (int32 Index = 0; (Index < NumChangesets) && !Reader.IsError(); Index++)
+	{
+		FPlasticSourceControlChangesetRef Changeset = MakeShareable(new FPlasticSourceControlChangeset());
+		Reader << Changeset->ChangesetId;
+		Reader << Changeset->CreatedBy;
+		Reader << Changeset->Date;
+		Reader << Changeset->Comment;
+		Reader << Changeset->Branch;
+		OutCache.Changesets.Add(MoveTemp(Changeset));
+	}
+	if (Reader.IsError())
+	{
+		UE_LOG(LogSourceControl, Warning, TEXT("Discard the corrupted cache file %s"), *Filename);
+		OutCache.Changesets.Reset();
+		return false;
+	}
+
+	UE_LOG(LogSourceControl, Verbose, TEXT("LoadChangesets(%s): %d changesets"), *InRepositorySpecification, OutCache.Changesets.Num());
+	return true;
+}
+
+bool SaveChangesets(const FString& InCacheDir, const FString& InRepositorySpecification, const FChangesetsCache& InCache)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlMetadataCache::SaveChangesets);
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data, true);
+	WriteHeader(Writer, InRepositorySpecification);
+	FDateTime FromDate = InCache.FromDate;
+	FDateTime FullRefreshDate = InCache.FullRefreshDate;
+	int32 NumChangesets = InCache.Changesets.Num();
+	Writer << FromDate;
+	Writer << FullRefreshDate;
+	Writer << NumChangesets;
+	for (const FPlasticSourceControlChangesetRef& Changeset : InCache.Changesets)
+	{
+		Writer << Changeset->ChangesetId;
+		Writer << Changeset->CreatedBy;
+		Writer << Changeset->Date;
+		Writer << Changeset->Comment;
+		Writer << Changeset->Branch;
+	}
+
+	FScopeLock Lock(&CacheCriticalSection);
+	return WriteCacheFile(GetCacheFilename(InCacheDir, InRepositorySpecification, TEXT("Changesets")), Data);
+}
+
+bool LoadBranches(const FString& InCacheDir, const FString& InRepositorySpecification, FBranchesCache& OutCache)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlMetadataCache::LoadBranches);
+
+	FScopeLock Lock(&CacheCriticalSection);
+
+	const FString Filename = GetCacheFilename(InCacheDir, InRepositorySpecification, TEXT("Branches"));
+	TArray<uint8> Data;
+	FMemoryReader Reader(Data, true);
+	if (!ReadCacheFile(Filename, InRepositorySpecification, Data, Reader))
+	{
+		return false;
+	}
+
+	int32 NumBranches = 0;
+	Reader << OutCache.FromDate;
+	Reader << OutCache.RefreshDate;
+	Reader << NumBranches;
+	if (Reader.IsError() || (NumBranches < 0) || (NumBranches > Data.Num()))
+	{
+		return false;
+	}
+	OutCache.Branches.Reset(NumBranches);
+	for (int32 Index = 0; (Index < NumBranches) && !Reader.IsError(); Index++)
+	{
+		FPlasticSourceControlBranchRef Branch = MakeShareable(new FPlasticSourceControlBranch());
+		Reader << Branch->Name;
+		Reader << Branch->Repository;
+		Reader << Branch->CreatedBy;
+		Reader << Branch->Date;
+		Reader << Branch->Comment;
+		OutCache.Branches.Add(MoveTemp(Branch));
+	}
+	if (Reader.IsError())
+	{
+		UE_LOG(LogSourceControl, Warning, TEXT("Discard the corrupted cache file %s"), *Filename);
+		OutCache.Branches.Reset();
+		return false;
+	}
+
+	UE_LOG(LogSourceControl, Verbose, TEXT("LoadBranches(%s): %d branches"), *InRepositorySpecification, OutCache.Branches.Num());
+	return true;
+}
+
+bool SaveBranches(const FString& InCacheDir, const FString& InRepositorySpecification, const FBranchesCache& InCache)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlMetadataCache::SaveBranches);
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data, true);
+	WriteHeader(Writer, InRepositorySpecification);
+	FDateTime FromDate = InCache.FromDate;
+	FDateTime RefreshDate = InCache.RefreshDate;
+	int32 NumBranches = InCache.Branches.Num();
+	Writer << FromDate;
+	Writer << RefreshDate;
+	Writer << NumBranches;
+	for (const FPlasticSourceControlBranchRef& Branch : InCache.Branches)
+	{
+		Writer << Branch->Name;
+		Writer << Branch->Repository;
+		Writer << Branch->CreatedBy;
+		Writer << Branch->Date;
+		Writer << Branch->Comment;
+	}
+
+	FScopeLock Lock(&CacheCriticalSection);
+	return WriteCacheFile(GetCacheFilename(InCacheDir, InRepositorySpecification, TEXT("Branches")), Data);
+}
+
+void Invalidate(const FString& InCacheDir, const FString& InRepositorySpecification)
+{
+	FScopeLock Lock(&CacheCriticalSection);
+	IFileManager::Get().Delete(*GetCacheFilename(InCacheDir, InRepositorySpecification, TEXT("Changesets")), false, false, true);
+	IFileManager::Get().Delete(*GetCacheFilename(InCacheDir, InRepositorySpecification, TEXT("Branches")), false, false, true);
+}
+
+} // namespace PlasticSourceControlMetadataCache
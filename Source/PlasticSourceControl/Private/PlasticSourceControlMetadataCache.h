@@ -0,0 +1,74 @@
+// Copyright (c) 2025 Unity Technologies
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+typedef TSharedRef<class FPlasticSourceControlBranch, ESPMode::ThreadSafe> FPlasticSourceControlBranchRef;
+typedef TSharedRef<class FPlasticSourceControlChangeset, ESPMode::ThreadSafe> FPlasticSourceControlChangesetRef;
+
+/**
+ * Persistent cache of the changesets and branches of the repositories, in compact binary files under Saved/PlasticSourceControl/,
+ * so that the Changesets and Branches windows only need to query the server for what changed since their last refresh.
+ *
+ * There is one file per repository and per kind of record, keyed by the repository specification. Files are replaced atomically,
+ * and are discarded on load if they are corrupted, from another version, or from another repository colliding on the same name.
+ */
+namespace PlasticSourceControlMetadataCache
+{
+
+/** Changesets of a repository, sorted by descending ChangesetId, without their files */
+struct FChangesetsCache
+{
+	/** Date from which all the changesets are cached (FDateTime() if all of them) */
+	FDateTime FromDate;
+
+	/** Date of the last full query to the server: the changesets cached since then can have been edited or deleted */
+	FDateTime FullRefreshDate;
+
+	TArray<FPlasticSourceControlChangesetRef> Changesets;
+};
+
+/** Branches of a repository */
+struct FBranchesCache
+{
+	/** Date from which all the branches created or changed are cached (FDateTime() if all of them) */
+	FDateTime FromDate;
+
+	/** Date of the last query to the server: branches created or changed after this date are not cached yet */
+	FDateTime RefreshDate;
+
+	TArray<FPlasticSourceControlBranchRef> Branches;
+};
+
+/** Directory of the files of the cache of the project, Saved/PlasticSourceControl/ */
+FString GetCacheDir();
+
+/**
+ * Load the changesets of a repository from the cache.
+ * @param	InCacheDir					The directory of the files of the cache (see GetCacheDir())
+ * @param	InRepositorySpecification	The repository, as in "repository@server"
+ * @param	OutCache					The changesets cached, and the date they are cached from
+ * @returns true if the cache was found and valid
+ */
+bool LoadChangesets(const FString& InCacheDir, const FString& InRepositorySpecification, FChangesetsCache& OutCache);
+
+/** Save the changesets of a repository to the cache (thread-safe) */
+bool SaveChangesets(const FString& InCacheDir, const FString& InRepositorySpecification, const FChangesetsCache& InCache);
+
+/**
+ * Load the branches of a repository from the cache.
+ * @param	InCacheDir					The directory of the files of the cache (see GetCacheDir())
+ * @param	InRepositorySpecification	The repository, as in "repository@server"
+ * @param	OutCache					The branches cached, the date they are cached from, and the date of their last refresh
+ * @returns true if the cache was found and valid
+ */
+bool LoadBranches(const FString& InCacheDir, const FString& InRepositorySpecification, FBranchesCache& OutCache);
+
+/** Save the branches of a repository to the cache (thread-safe) */
+bool SaveBranches(const FString& InCacheDir, const FString& InRepositorySpecification, const FBranchesCache& InCache);
+
+/** Delete the cached changesets and branches of a repository, eg. after a branch has been renamed or deleted (thread-safe) */
+void Invalidate(const FString& InCacheDir, const FString& InRepositorySpecification);
+
+} // namespace PlasticSourceControlMetadataCache
@@ -3,6 +3,7 @@
 #include "PlasticSourceControlModule.h"
 
 #include "IPlasticSourceControlWorker.h"
+#include "PlasticSourceControlShell.h"
 
 #include "Interfaces/IPluginManager.h"
 #include "Features/IModularFeatures.h"
@@ -29,6 +30,7 @@ void FPlasticSourceControlModule::ShutdownModule()
 {
 	// shut down the provider, as this module is going away
 	PlasticSourceControlProvider.Close();
+	PlasticSourceControlShell::ShutdownCommandThreadPool();
 
 	PlasticSourceControlBranchesWindow.Unregister();
 	PlasticSourceControlChangesetsWindow.Unregister();
@@ -7,6 +7,7 @@
 #include "PlasticSourceControlChangeset.h"
 #include "PlasticSourceControlCommand.h"
 #include "PlasticSourceControlLock.h"
+#include "PlasticSourceControlMetadataCache.h"
 #include "PlasticSourceControlModule.h"
 #include "PlasticSourceControlParsers.h"
 #include "PlasticSourceControlProvider.h"
@@ -410,8 +411,15 @@ bool FPlasticCheckOutWorker::Execute(FPlasticSourceControlCommand& InCommand)
 		InCommand.bCommandSuccessful = PlasticSourceControlUtils::RunCommand(TEXT("partial checkout"), TArray<FString>(), InCommand.Files, InCommand.InfoMessages, InCommand.ErrorMessages);
 	}
 
-	// now update the status of our files
-	PlasticSourceControlUtils::InvalidateLocksCache();
+	// now update the status of our files, and the locks they might have taken (only fully known if the checkout succeeded)
+	if (InCommand.bCommandSuccessful)
+	{
+		PlasticSourceControlUtils::UpdateLocksCacheOnCheckOut(GetProvider(), InCommand.Files);
+	}
+	else
+	{
+		PlasticSourceControlUtils::InvalidateLocksCache();
+	}
 	PlasticSourceControlUtils::RunUpdateStatus(InCommand.Files, PlasticSourceControlUtils::EStatusSearchType::ControlledOnly, false, InCommand.ErrorMessages, States, InCommand.ChangesetNumber);
 
 	return InCommand.bCommandSuccessful;
@@ -574,8 +582,15 @@ bool FPlasticCheckInWorker::Execute(FPlasticSourceControlCommand& InCommand)
 #endif
 	}
 
-	// now update the status of our files
-	PlasticSourceControlUtils::InvalidateLocksCache();
+	// now update the status of our files, and the locks they released (only fully known if the checkin succeeded)
+	if (InCommand.bCommandSuccessful)
+	{
+		PlasticSourceControlUtils::UpdateLocksCacheOnCheckIn(GetProvider(), Files);
+	}
+	else
+	{
+		PlasticSourceControlUtils::InvalidateLocksCache();
+	}
 	PlasticSourceControlUtils::RunUpdateStatus(Files, PlasticSourceControlUtils::EStatusSearchType::ControlledOnly, false, InCommand.ErrorMessages, States, InCommand.ChangesetNumber);
 
 	return InCommand.bCommandSuccessful;
@@ -1257,8 +1272,15 @@ bool FPlasticUnlockWorker::Execute(FPlasticSourceControlCommand& InCommand)
 		InCommand.bCommandSuccessful &= PlasticSourceControlUtils::RunCommand(TEXT("lock"), Parameters, TArray<FString>(), InCommand.InfoMessages, InCommand.ErrorMessages);
 	}
 
-	// now update the status of our files
-	PlasticSourceControlUtils::InvalidateLocksCache();
+	// now update the locks, and the status of our files
+	if (InCommand.bCommandSuccessful)
+	{
+		PlasticSourceControlUtils::UpdateLocksCacheOnUnlock(Operation->Locks, Operation->bRemove);
+	}
+	else
+	{
+		PlasticSourceControlUtils::InvalidateLocksCache();
+	}
 	PlasticSourceControlUtils::RunUpdateStatus(InCommand.Files, PlasticSourceControlUtils::EStatusSearchType::ControlledOnly, false, InCommand.ErrorMessages, States, InCommand.ChangesetNumber);
 
 	return InCommand.bCommandSuccessful;
@@ -1285,7 +1307,46 @@ bool FPlasticGetBranchesWorker::Execute(FPlasticSourceControlCommand& InCommand)
 	TSharedRef<FPlasticGetBranches, ESPMode::ThreadSafe> Operation = StaticCastSharedRef<FPlasticGetBranches>(InCommand.Operation);
 
 	{
-		InCommand.bCommandSuccessful = PlasticSourceControlUtils::RunGetBranches(Operation->FromDate, Operation->Branches, InCommand.ErrorMessages);
+		// Branches change (new changesets, renames...) so they can't be queried by id like the changesets:
+		// if the persistent cache lists the same dates and has been refreshed the same day, only query the branches created or changed since that day.
+		// Note: a branch is listed for its creation date or for the dates of its changesets, that are not cached,
+		// so the cached branches can't be filtered for other dates: they require a full query.
+		const FString RepositorySpecification = GetProvider().GetRepositorySpecification();
+		const FDateTime FromDate = (Operation->FromDate != FDateTime()) ? Operation->FromDate.GetDate() : FDateTime();
+		const FDateTime Now = FDateTime::Now();
+		PlasticSourceControlMetadataCache::FBranchesCache Cache;
+		const bool bIsIncremental = PlasticSourceControlMetadataCache::LoadBranches(PlasticSourceControlMetadataCache::GetCacheDir(), RepositorySpecification, Cache) && (FromDate == Cache.FromDate) && (Cache.RefreshDate.GetDate() == Now.GetDate());
+		TArray<FPlasticSourceControlBranchRef> Branches;
+		InCommand.bCommandSuccessful = PlasticSourceControlUtils::RunGetBranches(bIsIncremental ? Cache.RefreshDate.GetDate() : FromDate, Branches, InCommand.ErrorMessages);
+		if (InCommand.bCommandSuccessful)
+		{
+			if (bIsIncremental)
+			{
+				// Replace the cached branches by the ones created or changed since the last refresh
+				UE_LOG(LogSourceControl, Log, TEXT("GetBranches: %d branches changed today, %d cached"), Branches.Num(), Cache.Branches.Num());
+				TSet<FString> ChangedBranches;
+				for (const FPlasticSourceControlBranchRef& Branch : Branches)
+				{
+					ChangedBranches.Add(Branch->Name);
+				}
+				for (FPlasticSourceControlBranchRef& Branch : Cache.Branches)
+				{
+					if (!ChangedBranches.Contains(Branch->Name))
+					{
+						Branches.Add(MoveTemp(Branch));
+					}
+				}
+			}
+			else
+			{
+				Cache.FromDate = FromDate;
+			}
+			Cache.RefreshDate = Now;
+			Cache.Branches = Branches;
+			PlasticSourceControlMetadataCache::SaveBranches(PlasticSourceControlMetadataCache::GetCacheDir(), RepositorySpecification, Cache);
+
+			Operation->Branches = MoveTemp(Branches);
+		}
 	}
 
 	{
@@ -1407,7 +1468,14 @@ bool FPlasticRenameBranchWorker::Execute(FPlasticSourceControlCommand& InCommand
 	check(InCommand.Operation->GetName() == GetName());
 	TSharedRef<FPlasticRenameBranch, ESPMode::ThreadSafe> Operation = StaticCastSharedRef<FPlasticRenameBranch>(InCommand.Operation);
 
-	return PlasticSourceControlUtils::RunRenameBranch(Operation->OldName, Operation->NewName, InCommand.ErrorMessages);
+	InCommand.bCommandSuccessful = PlasticSourceControlUtils::RunRenameBranch(Operation->OldName, Operation->NewName, InCommand.ErrorMessages);
+	if (InCommand.bCommandSuccessful)
+	{
+		// The names of the branches are also cached with the changesets, so refresh both on next query
+		PlasticSourceControlMetadataCache::Invalidate(PlasticSourceControlMetadataCache::GetCacheDir(), GetProvider().GetRepositorySpecification());
+	}
+
+	return InCommand.bCommandSuccessful;
 }
 
 bool FPlasticRenameBranchWorker::UpdateStates()
@@ -1428,7 +1496,14 @@ bool FPlasticDeleteBranchesWorker::Execute(FPlasticSourceControlCommand& InComma
 	check(InCommand.Operation->GetName() == GetName());
 	TSharedRef<FPlasticDeleteBranches, ESPMode::ThreadSafe> Operation = StaticCastSharedRef<FPlasticDeleteBranches>(InCommand.Operation);
 
-	return PlasticSourceControlUtils::RunDeleteBranches(Operation->BranchNames, InCommand.ErrorMessages);
+	InCommand.bCommandSuccessful = PlasticSourceControlUtils::RunDeleteBranches(Operation->BranchNames, InCommand.ErrorMessages);
+	if (InCommand.bCommandSuccessful)
+	{
+		// The names of the branches are also cached with the changesets, so refresh both on next query
+		PlasticSourceControlMetadataCache::Invalidate(PlasticSourceControlMetadataCache::GetCacheDir(), GetProvider().GetRepositorySpecification());
+	}
+
+	return InCommand.bCommandSuccessful;
 }
 
 bool FPlasticDeleteBranchesWorker::UpdateStates()
@@ -1449,8 +1524,58 @@ bool FPlasticGetChangesetsWorker::Execute(FPlasticSourceControlCommand& InComman
 	check(InCommand.Operation->GetName() == GetName());
 	TSharedRef<FPlasticGetChangesets, ESPMode::ThreadSafe> Operation = StaticCastSharedRef<FPlasticGetChangesets>(InCommand.Operation);
 
+	if (Operation->PageSize > 0)
 	{
-		InCommand.bCommandSuccessful = PlasticSourceControlUtils::RunGetChangesets(Operation->FromDate, Operation->Changesets, InCommand.ErrorMessages);
+		// Only list a page of the history, asking for one more changeset to know if there are older ones
+		// Note: the persistent cache is not used, since it would load all the changesets
+		const FDateTime FromDate = (Operation->FromDate != FDateTime()) ? Operation->FromDate.GetDate() : FDateTime();
+		InCommand.bCommandSuccessful = PlasticSourceControlUtils::RunGetChangesetsPage(FromDate, Operation->BeforeChangesetId, Operation->PageSize + 1, Operation->Changesets, InCommand.ErrorMessages);
+		if (InCommand.bCommandSuccessful)
+		{
+			Operation->bHasMoreChangesets = (Operation->Changesets.Num() > Operation->PageSize);
+			Operation->Changesets.SetNum(FMath::Min(Operation->Changesets.Num(), Operation->PageSize));
+		}
+	}
+	else
+	{
+		// Only query the changesets created since the last refresh if the persistent cache covers the dates requested,
+		// and has been fully refreshed the same day, to also pick up the changesets edited (eg their comment) or deleted since they were cached
+		const FString RepositorySpecification = GetProvider().GetRepositorySpecification();
+		const FDateTime FromDate = (Operation->FromDate != FDateTime()) ? Operation->FromDate.GetDate() : FDateTime();
+		const FDateTime Now = FDateTime::Now();
+		PlasticSourceControlMetadataCache::FChangesetsCache Cache;
+		const bool bIsIncremental = PlasticSourceControlMetadataCache::LoadChangesets(PlasticSourceControlMetadataCache::GetCacheDir(), RepositorySpecification, Cache) && (Cache.Changesets.Num() > 0) && (FromDate >= Cache.FromDate)
+			&& (Cache.FullRefreshDate.GetDate() == Now.GetDate());
+		const int32 FromChangesetId = bIsIncremental ? Cache.Changesets[0]->ChangesetId : ISourceControlState::INVALID_REVISION;
+		TArray<FPlasticSourceControlChangesetRef> Changesets;
+		InCommand.bCommandSuccessful = PlasticSourceControlUtils::RunGetChangesets(FromDate, FromChangesetId, Changesets, InCommand.ErrorMessages);
+		if (InCommand.bCommandSuccessful)
+		{
+			// Merge the new changesets, sorted by descending ChangesetId, before the cached ones, and save them back
+			if (bIsIncremental)
+			{
+				UE_LOG(LogSourceControl, Log, TEXT("GetChangesets: %d new changesets after cs:%d, %d cached"), Changesets.Num(), FromChangesetId, Cache.Changesets.Num());
+				Changesets.Append(MoveTemp(Cache.Changesets));
+			}
+			else
+			{
+				Cache.FromDate = FromDate;
+				Cache.FullRefreshDate = Now;
+			}
+			Cache.Changesets = Changesets;
+			PlasticSourceControlMetadataCache::SaveChangesets(PlasticSourceControlMetadataCache::GetCacheDir(), RepositorySpecification, Cache);
+
+			// The date requested is local, like the condition of the query, while the dates of the changesets are parsed as UTC
+			const FDateTime FromDateUtc = (FromDate != FDateTime()) ? FromDate + (FDateTime::UtcNow() - Now) : FDateTime();
+			Operation->Changesets.Reset(Changesets.Num());
+			for (FPlasticSourceControlChangesetRef& Changeset : Changesets)
+			{
+				if (Changeset->Date >= FromDateUtc)
+				{
+					Operation->Changesets.Add(MoveTemp(Changeset));
+				}
+			}
+		}
 	}
 
 	{
@@ -1483,10 +1608,24 @@ bool FPlasticGetChangesetFilesWorker::Execute(FPlasticSourceControlCommand& InCo
 		return false;
 	}
 
+	// The files of a changeset never change, so reuse them if they have already been listed recently
+	const FString RepositorySpecification = GetProvider().GetRepositorySpecification();
+	FPlasticSourceControlChangesetFilesCache& ChangesetFilesCache = GetProvider().GetChangesetFilesCache();
+	if (ChangesetFilesCache.Find(RepositorySpecification, Operation->Changeset->ChangesetId, Operation->Files))
+	{
+		InCommand.bCommandSuccessful = true;
+		return InCommand.bCommandSuccessful;
+	}
+
 	{
 		InCommand.bCommandSuccessful = PlasticSourceControlUtils::RunGetChangesetFiles(Operation->Changeset.ToSharedRef(), Operation->Files, InCommand.ErrorMessages);
+		if (InCommand.bCommandSuccessful)
+		{
+			ChangesetFilesCache.Add(RepositorySpecification, Operation->Changeset->ChangesetId, Operation->Files);
+		}
 	}
 
+	if (!Operation->bPrefetch)
 	{
 		InCommand.bCommandSuccessful &= PlasticSourceControlUtils::GetChangesetNumber(InCommand.ChangesetNumber, InCommand.ErrorMessages);
 	}
@@ -1543,7 +1682,12 @@ bool FPlasticUpdateStatusWorker::Execute(FPlasticSourceControlCommand& InCommand
 
 	if (Files.Num() > 0)
 	{
-		InCommand.bCommandSuccessful = PlasticSourceControlUtils::RunUpdateStatus(Files, PlasticSourceControlUtils::EStatusSearchType::All, Operation->ShouldUpdateHistory(), InCommand.ErrorMessages, States, InCommand.ChangesetNumber);
+		// Get the history of the files (on all branches) if requested, or else only their last revision (checking all branches)
+		// in order to warn the user if the file has been changed on another branch
+		FPlasticSourceControlSettings& PlasticSettings = GetProvider().AccessSettings();
+		const bool bGetHistory = Operation->ShouldUpdateHistory() || (PlasticSettings.GetUpdateStatusOtherBranches() && AreAllFiles(Files));
+		bool bGotHistory = false;
+		InCommand.bCommandSuccessful = PlasticSourceControlUtils::RunUpdateStatusAndHistory(Files, PlasticSourceControlUtils::EStatusSearchType::All, Operation->ShouldUpdateHistory(), bGetHistory, InCommand.ErrorMessages, States, InCommand.ChangesetNumber, bGotHistory);
 		// Remove all "is not in a workspace" error and convert the result to "success" if there are no other errors
 		PlasticSourceControlUtils::RemoveRedundantErrors(InCommand, TEXT("is not in a workspace."));
 		if (!InCommand.bCommandSuccessful)
@@ -1554,12 +1698,14 @@ bool FPlasticUpdateStatusWorker::Execute(FPlasticSourceControlCommand& InCommand
 			return false;
 		}
 
-		if (Operation->ShouldUpdateHistory())
+		if (bGetHistory && !bGotHistory)
 		{
-			// Get the history of the files (on all branches)
 			InCommand.bCommandSuccessful &= PlasticSourceControlUtils::RunGetHistory(Operation->ShouldUpdateHistory(), States, InCommand.ErrorMessages);
+		}
 
 #if ENGINE_MAJOR_VERSION == 4 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 3)
+		if (Operation->ShouldUpdateHistory())
+		{
 			// Special case for conflicts
 			for (FPlasticSourceControlState& State : States)
 			{
@@ -1584,18 +1730,8 @@ bool FPlasticUpdateStatusWorker::Execute(FPlasticSourceControlCommand& InCommand
 					}
 				}
 			}
-#endif
-		}
-		else
-		{
-			FPlasticSourceControlSettings& PlasticSettings = GetProvider().AccessSettings();
-			if (PlasticSettings.GetUpdateStatusOtherBranches() && AreAllFiles(Files))
-			{
-				// Get only the last revision of the files (checking all branches)
-				// in order to warn the user if the file has been changed on another branch
-				InCommand.bCommandSuccessful &= PlasticSourceControlUtils::RunGetHistory(Operation->ShouldUpdateHistory(), States, InCommand.ErrorMessages);
-			}
 		}
+#endif
 	}
 	// no path provided: only update the status of assets in Content/ directory if requested
 	// Perforce "opened files" are those that have been modified (or added/deleted): that is what we get with a simple status from the root
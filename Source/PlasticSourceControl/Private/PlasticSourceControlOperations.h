@@ -280,8 +280,17 @@ public:
 	// Limit the list of changesets to ones created from this date (optional, filtering enabled by default)
 	FDateTime FromDate;
 
+	// Only list a page of this number of changesets, from the most recent ones (optional, all the changesets are listed by default)
+	int32 PageSize = 0;
+
+	// Only list the page of changesets created before this one, ie the oldest changeset of the previous page (INVALID_REVISION for the first page)
+	int32 BeforeChangesetId = ISourceControlState::INVALID_REVISION;
+
 	// List of changesets found
 	TArray<FPlasticSourceControlChangesetRef> Changesets;
+
+	// Whether there are older changesets than this page
+	bool bHasMoreChangesets = false;
 };
 
 
@@ -301,6 +310,9 @@ public:
 
 	// List of files changed in the changeset
 	TArray<FPlasticSourceControlStateRef> Files;
+
+	// Prefetch the files of a changeset adjacent to the selected one, in the background, without refreshing the current changeset number
+	bool bPrefetch = false;
 };
 
 
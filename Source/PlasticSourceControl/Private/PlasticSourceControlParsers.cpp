@@ -10,9 +10,13 @@
 #include "PlasticSourceControlState.h"
 #include "PlasticSourceControlUtils.h"
 #include "PlasticSourceControlVersions.h"
+#include "PlasticSourceControlXmlReader.h"
 #include "ISourceControlModule.h"
 
+#include "Async/MappedFileHandle.h"
 #include "HAL/PlatformFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "XmlParser.h"
 
@@ -170,14 +174,20 @@ bool GetChangesetFromWorkspaceStatus(const TArray<FString>& InResults, int32& Ou
 {
 	if (InResults.Num() > 0)
 	{
-		const FString& WorkspaceStatus = InResults[0];
-		TArray<FString> WorkspaceInfos;
-		WorkspaceStatus.ParseIntoArray(WorkspaceInfos, FILE_STATUS_SEPARATOR, false); // Don't cull empty values in csv
-		if (WorkspaceInfos.Num() >= 4)
-		{
-			OutChangeset = FCString::Atoi(*WorkspaceInfos[1]);
-			return true;
-		}
+		return GetChangesetFromWorkspaceStatus(InResults[0], OutChangeset);
+	}
+
+	return false;
+}
+
+bool GetChangesetFromWorkspaceStatus(const FString& InWorkspaceStatus, int32& OutChangeset)
+{
+	TArray<FString> WorkspaceInfos;
+	InWorkspaceStatus.ParseIntoArray(WorkspaceInfos, FILE_STATUS_SEPARATOR, false); // Don't cull empty values in csv
+	if (WorkspaceInfos.Num() >= 4)
+	{
+		OutChangeset = FCString::Atoi(*WorkspaceInfos[1]);
+		return true;
 	}
 
 	return false;
@@ -297,6 +307,216 @@ static FPlasticSourceControlState StateFromStatusResult(const FString& InResult,
 	return FPlasticSourceControlState(FString());
 }
 
+// Flags for each two-letter status code found in a (compound) file status like "CO+CH" or "AD+LD"
+enum EStatusCodeFlags : uint32
+{
+	StatusCodeCH		= 1 << 0,
+	StatusCodeCO		= 1 << 1,
+	StatusCodeCP		= 1 << 2,
+	StatusCodeMV		= 1 << 3,
+	StatusCodeRP		= 1 << 4,
+	StatusCodeAD		= 1 << 5,
+	StatusCodePR		= 1 << 6,
+	StatusCodeLM		= 1 << 7,
+	StatusCodeIG		= 1 << 8,
+	StatusCodeDE		= 1 << 9,
+	StatusCodeLD		= 1 << 10,
+	StatusCodeUnknown	= 1 << 31,
+};
+
+static constexpr uint16 TwoLetterCode(const ANSICHAR InFirst, const ANSICHAR InSecond)
+{
+	return static_cast<uint16>((static_cast<uint8>(InFirst) << 8) | static_cast<uint8>(InSecond));
+}
+
+static FString Utf8ToString(const FAnsiStringView InUtf8)
+{
+	const FUTF8ToTCHAR Converted(InUtf8.GetData(), InUtf8.Len());
+	return FString(Converted.Length(), Converted.Get());
+}
+
+// Convert a path from UTF-8 and normalize it (convert all '\' to '/') in place, allocating only the resulting string
+static FString NormalizedFilenameFromUtf8(const FAnsiStringView InUtf8)
+{
+	FString Filename = Utf8ToString(InUtf8);
+	Filename.ReplaceCharInline(TEXT('\\'), TEXT('/'), ESearchCase::CaseSensitive);
+	return Filename;
+}
+
+/**
+ * Interpret the 2-to-8 letters file status directly from the raw UTF-8 bytes of a cm "status" result.
+ *
+ * Same rules as StateFromStatus(), but switching on each two-letter code instead of comparing strings.
+*/
+static EWorkspaceState StateFromStatusUtf8(const FAnsiStringView InFileStatus, const bool bInUsesCheckedOutChanged)
+{
+	uint32 StatusCodes = 0;
+	int32 CodeStart = 0;
+	for (int32 Index = 0; Index <= InFileStatus.Len(); Index++)
+	{
+		if ((Index == InFileStatus.Len()) || (InFileStatus[Index] == '+'))
+		{
+			if (Index - CodeStart == 2)
+			{
+				switch (TwoLetterCode(InFileStatus[CodeStart], InFileStatus[CodeStart + 1]))
+				{
+				case TwoLetterCode('C', 'H'): StatusCodes |= StatusCodeCH; break;
+				case TwoLetterCode('C', 'O'): StatusCodes |= StatusCodeCO; break;
+				case TwoLetterCode('C', 'P'): StatusCodes |= StatusCodeCP; break;
+				case TwoLetterCode('M', 'V'): StatusCodes |= StatusCodeMV; break;
+				case TwoLetterCode('R', 'P'): StatusCodes |= StatusCodeRP; break;
+				case TwoLetterCode('A', 'D'): StatusCodes |= StatusCodeAD; break;
+				case TwoLetterCode('P', 'R'): StatusCodes |= StatusCodePR; break;
+				case TwoLetterCode('L', 'M'): StatusCodes |= StatusCodeLM; break;
+				case TwoLetterCode('I', 'G'): StatusCodes |= StatusCodeIG; break;
+				case TwoLetterCode('D', 'E'): StatusCodes |= StatusCodeDE; break;
+				case TwoLetterCode('L', 'D'): StatusCodes |= StatusCodeLD; break;
+				default: StatusCodes |= StatusCodeUnknown; break;
+				}
+			}
+			else
+			{
+				StatusCodes |= StatusCodeUnknown;
+			}
+			CodeStart = Index + 1;
+		}
+	}
+
+	if (StatusCodes == StatusCodeCH) // Modified but not Checked-Out
+	{
+		return EWorkspaceState::Changed;
+	}
+	else if (StatusCodes == StatusCodeCO) // Checked-Out with no change, or "don't know" if using on an old version of cm
+	{
+		return bInUsesCheckedOutChanged ? EWorkspaceState::CheckedOutUnchanged : EWorkspaceState::CheckedOutChanged;
+	}
+	else if (StatusCodes == (StatusCodeCO | StatusCodeCH)) // Checked-Out and changed from the new --iscochanged
+	{
+		return EWorkspaceState::CheckedOutChanged;
+	}
+	else if (StatusCodes & StatusCodeCP) // "CP", "CO+CP"
+	{
+		return EWorkspaceState::Copied;
+	}
+	else if (StatusCodes & StatusCodeMV) // "MV", "CO+MV", "CO+CH+MV", "CO+RP+MV"
+	{
+		return EWorkspaceState::Moved;
+	}
+	else if (StatusCodes & StatusCodeRP) // "RP", "CO+RP", "CO+RP+CH", "CO+CH+RP"
+	{
+		return EWorkspaceState::Replaced;
+	}
+	else if (StatusCodes == StatusCodeAD)
+	{
+		return EWorkspaceState::Added;
+	}
+	else if ((StatusCodes == StatusCodePR) || (StatusCodes == StatusCodeLM)) // Not Controlled/Not in Depot/Untracked (or Locally Moved/Renamed)
+	{
+		return EWorkspaceState::Private;
+	}
+	else if (StatusCodes == StatusCodeIG)
+	{
+		return EWorkspaceState::Ignored;
+	}
+	else if (StatusCodes == StatusCodeDE)
+	{
+		return EWorkspaceState::Deleted;
+	}
+	else if (StatusCodes & StatusCodeLD) // "LD", "AD+LD"
+	{
+		return EWorkspaceState::LocallyDeleted;
+	}
+
+	UE_LOG(LogSourceControl, Warning, TEXT("Unknown file status '%s'"), *Utf8ToString(InFileStatus));
+	return EWorkspaceState::Unknown;
+}
+
+/**
+ * Extract and interpret the file state directly from the raw UTF-8 bytes of a cm "status" result, without splitting it into strings.
+ *
+ * Only the resulting normalized filename(s) are allocated.
+ *
+ * @see #StateFromStatusResult() for examples of results
+*/
+static FPlasticSourceControlState StateFromStatusResultUtf8(const FAnsiStringView InResult, const bool bInUsesCheckedOutChanged)
+{
+	// Note: should contain 4 or 6 elements (for moved files)
+	FAnsiStringView ResultElements[6];
+	int32 NumElements = 0;
+	int32 ElementStart = 0;
+	for (int32 Index = 0; (Index <= InResult.Len()) && (NumElements < UE_ARRAY_COUNT(ResultElements)); Index++)
+	{
+		if ((Index == InResult.Len()) || (InResult[Index] == ';'))
+		{
+			ResultElements[NumElements++] = InResult.Mid(ElementStart, Index - ElementStart);
+			ElementStart = Index + 1;
+		}
+	}
+
+	if (NumElements >= 4)
+	{
+		const EWorkspaceState WorkspaceState = StateFromStatusUtf8(ResultElements[0], bInUsesCheckedOutChanged);
+		if (WorkspaceState == EWorkspaceState::Moved)
+		{
+			// Special case for an asset that has been moved/renamed
+			FPlasticSourceControlState State(NormalizedFilenameFromUtf8(ResultElements[3]), WorkspaceState);
+			State.MovedFrom = NormalizedFilenameFromUtf8(ResultElements[2]);
+			return State;
+		}
+		else
+		{
+			return FPlasticSourceControlState(NormalizedFilenameFromUtf8(ResultElements[1]), WorkspaceState);
+		}
+	}
+
+	UE_LOG(LogSourceControl, Warning, TEXT("%s"), *Utf8ToString(InResult));
+
+	return FPlasticSourceControlState(FString());
+}
+
+FStatusResultParser::FStatusResultParser()
+{
+	const FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
+	bUsesCheckedOutChanged = Provider.GetPlasticScmVersion() >= PlasticSourceControlVersions::StatusIsCheckedOutChanged;
+}
+
+void FStatusResultParser::ParseLine(FString&& InResult)
+{
+	// Parse the first line of status with the Changeset number
+	if (!bWorkspaceStatusParsed)
+	{
+		bWorkspaceStatusParsed = true;
+		GetChangesetFromWorkspaceStatus(InResult, Changeset);
+		return;
+	}
+
+	// Normalize file paths in the result (convert all '\' to '/')
+	FPaths::NormalizeFilename(InResult);
+
+	FPlasticSourceControlState State = StateFromStatusResult(InResult, bUsesCheckedOutChanged);
+	if (!State.LocalFilename.IsEmpty())
+	{
+		States.Add(MoveTemp(State));
+	}
+}
+
+void FStatusResultParser::ParseLine(const FAnsiStringView InResult)
+{
+	// Parse the first line of status with the Changeset number
+	if (!bWorkspaceStatusParsed)
+	{
+		bWorkspaceStatusParsed = true;
+		GetChangesetFromWorkspaceStatus(Utf8ToString(InResult), Changeset);
+		return;
+	}
+
+	FPlasticSourceControlState State = StateFromStatusResultUtf8(InResult, bUsesCheckedOutChanged);
+	if (!State.LocalFilename.IsEmpty())
+	{
+		States.Add(MoveTemp(State));
+	}
+}
+
 /**
  * @brief Parse status results in case of a regular operation for a list of files (not for a whole directory).
  *
@@ -305,9 +525,9 @@ static FPlasticSourceControlState StateFromStatusResult(const FString& InResult,
  * In this case, iterates on the list of files the Editor provides,
  * searching corresponding file status from the array of strings results of a "status" command.
  *
- * @param[in]	InFiles		List of files in a directory (never empty).
- * @param[in]	InResults	Lines of results from the "status" command
- * @param[out]	OutStates	States of files for witch the status has been gathered
+ * @param[in]	InFiles			List of files in a directory (never empty).
+ * @param[in]	InStatusStates	States parsed from the lines of results of the "status" command (see FStatusResultParser)
+ * @param[out]	OutStates		States of files for witch the status has been gathered
  *
  * Example of results from "cm status --machinereadable"
 CH;c:\Workspace\UEPlasticPluginDev\Content\Changed_BP.uasset;False;NO_MERGES
@@ -324,20 +544,17 @@ MV;100%;c:\Workspace\UEPlasticPluginDev\Content\ToMove_BP.uasset;c:\Workspace\UE
  *
  * @see #ParseDirectoryStatusResult() that use a different parse logic
  */
-void ParseFileStatusResult(TArray<FString>&& InFiles, const TArray<FString>& InResults, TArray<FPlasticSourceControlState>& OutStates)
+void ParseFileStatusResult(TArray<FString>&& InFiles, TArray<FPlasticSourceControlState>&& InStatusStates, TArray<FPlasticSourceControlState>& OutStates)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseFileStatusResult);
 
-	FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
-	const bool bUsesCheckedOutChanged = Provider.GetPlasticScmVersion() >= PlasticSourceControlVersions::StatusIsCheckedOutChanged;
-
-	// Parse the list of status results in a map indexed by absolute filename
+	// Index the list of status results in a map by absolute filename
 	TMap<FString, FPlasticSourceControlState> FileToStateMap;
-	FileToStateMap.Reserve(InResults.Num());
-	for (const FString& InResult : InResults)
+	FileToStateMap.Reserve(InStatusStates.Num());
+	for (FPlasticSourceControlState& State : InStatusStates)
 	{
-		FPlasticSourceControlState State = StateFromStatusResult(InResult, bUsesCheckedOutChanged);
-		FileToStateMap.Add(State.LocalFilename, MoveTemp(State));
+		FString File = State.LocalFilename;
+		FileToStateMap.Add(MoveTemp(File), MoveTemp(State));
 	}
 
 	// Iterate on each file explicitly listed in the command
@@ -397,44 +614,44 @@ void ParseFileStatusResult(TArray<FString>&& InFiles, const TArray<FString>& InR
  * In this case, as there is no file list to iterate over,
  * just parse each line of the array of strings results from the "status" command.
  *
- * @param[in]	InDir		The path to the directory (never empty).
- * @param[in]	InResults	Lines of results from the "status" command
- * @param[out]	OutStates	States of files for witch the status has been gathered
+ * @param[in]	InDir			The path to the directory (never empty).
+ * @param[in]	InStatusStates	States parsed from the lines of results of the "status" command (see FStatusResultParser)
+ * @param[out]	OutStates		States of files for witch the status has been gathered
  *
  * @see #ParseFileStatusResult() above for an example of a results from "cm status --machinereadable"
 */
-void ParseDirectoryStatusResult(const FString& InDir, const TArray<FString>& InResults, TArray<FPlasticSourceControlState>& OutStates)
+void ParseDirectoryStatusResult(const FString& InDir, TArray<FPlasticSourceControlState>&& InStatusStates, TArray<FPlasticSourceControlState>& OutStates)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseDirectoryStatusResult);
 
 	FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
-	const bool bUsesCheckedOutChanged = Provider.GetPlasticScmVersion() >= PlasticSourceControlVersions::StatusIsCheckedOutChanged;
 
 	// First, find in the cache any existing states for files within the considered directory, that are not the default "Controlled" state
-	TArray<FSourceControlStateRef> CachedStates = Provider.GetCachedStateByPredicate([&InDir](const FSourceControlStateRef& InState) {
-		TSharedRef<FPlasticSourceControlState, ESPMode::ThreadSafe> State = StaticCastSharedRef<FPlasticSourceControlState>(InState);
-		return (State->WorkspaceState != EWorkspaceState::Unknown) && (State->WorkspaceState != EWorkspaceState::Controlled) && InState->GetFilename().StartsWith(InDir);
-	});
-
-	// Iterate on each line of result of the status command
-	for (const FString& InResult : InResults)
+	// (only visiting the states under the directory thanks to the index of the cache by directory)
+	TArray<FSourceControlStateRef> CachedStates;
+	for (const FPlasticSourceControlStateRef& State : Provider.GetCachedStatesUnderDirectory(InDir, [](const FPlasticSourceControlStateRef& InState) {
+		return (InState->WorkspaceState != EWorkspaceState::Unknown) && (InState->WorkspaceState != EWorkspaceState::Controlled);
+	}))
 	{
-		FPlasticSourceControlState FileState = StateFromStatusResult(InResult, bUsesCheckedOutChanged);
-		if (!FileState.LocalFilename.IsEmpty())
-		{
-			UE_LOG(LogSourceControl, Verbose, TEXT("%s = %d:%s"), *FileState.LocalFilename, static_cast<uint32>(FileState.WorkspaceState), FileState.ToString());
+		CachedStates.Add(State);
+	}
 
-			// If a new state has been found in the directory status, we will update the cached state for the file later, let's remove it from the list
-			CachedStates.RemoveAll([&CachedStates, &FileState](FSourceControlStateRef& PreviousState) {
-				return PreviousState->GetFilename().Equals(FileState.GetFilename(), ESearchCase::IgnoreCase);
-			});
+	// If a new state has been found in the directory status, we will update the cached state for the file later,
+	// so only the cached states of the files that are not in the results of the status command need to be reset
+	const FDirectoryStatusDiff StatusDiff = DiffDirectoryStatus(CachedStates, InStatusStates);
+	UE_LOG(LogSourceControl, Verbose, TEXT("ParseDirectoryStatusResult(%s): %d added, %d changed, %d removed"), *InDir, StatusDiff.Added.Num(), StatusDiff.Changed.Num(), StatusDiff.Removed.Num());
 
-			OutStates.Add(MoveTemp(FileState));
-		}
+	// Iterate on each state from the results of the status command
+	OutStates.Reserve(OutStates.Num() + InStatusStates.Num());
+	for (FPlasticSourceControlState& FileState : InStatusStates)
+	{
+		UE_LOG(LogSourceControl, Verbose, TEXT("%s = %d:%s"), *FileState.LocalFilename, static_cast<uint32>(FileState.WorkspaceState), FileState.ToString());
+
+		OutStates.Add(MoveTemp(FileState));
 	}
 
 	// Finally, update the cache for the files that where not found in the status results (eg checked-in or reverted outside of the Editor)
-	for (const auto& CachedState : CachedStates)
+	for (const FSourceControlStateRef& CachedState : StatusDiff.Removed)
 	{
 		TSharedRef<FPlasticSourceControlState, ESPMode::ThreadSafe> State = StaticCastSharedRef<FPlasticSourceControlState>(CachedState);
 		// Check if a file that was "deleted" or "locally deleted" has been reverted or checked-in by testing if it still exists on disk
@@ -463,6 +680,52 @@ void ParseDirectoryStatusResult(const FString& InDir, const TArray<FString>& InR
 	}
 }
 
+FDirectoryStatusDiff DiffDirectoryStatus(const TArray<FSourceControlStateRef>& InPreviousStates, const TArray<FPlasticSourceControlState>& InNewStates)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::DiffDirectoryStatus);
+
+	FDirectoryStatusDiff StatusDiff;
+
+	// Index the previous states by path; FString keys are hashed and compared case-insensitively, ie on their case-folded path
+	TMap<FString, int32> PreviousStatesIndex;
+	PreviousStatesIndex.Reserve(InPreviousStates.Num());
+	for (int32 PreviousIndex = 0; PreviousIndex < InPreviousStates.Num(); PreviousIndex++)
+	{
+		PreviousStatesIndex.Add(InPreviousStates[PreviousIndex]->GetFilename(), PreviousIndex);
+	}
+
+	TBitArray<> MatchedPreviousStates(false, InPreviousStates.Num());
+	for (int32 NewIndex = 0; NewIndex < InNewStates.Num(); NewIndex++)
+	{
+		const FPlasticSourceControlState& NewState = InNewStates[NewIndex];
+		if (const int32* PreviousIndex = PreviousStatesIndex.Find(NewState.GetFilename()))
+		{
+			MatchedPreviousStates[*PreviousIndex] = true;
+			const FPlasticSourceControlState& PreviousState = static_cast<const FPlasticSourceControlState&>(InPreviousStates[*PreviousIndex].Get());
+			if (PreviousState.WorkspaceState != NewState.WorkspaceState)
+			{
+				StatusDiff.Changed.Emplace(NewIndex, *PreviousIndex);
+			}
+		}
+		else
+		{
+			StatusDiff.Added.Add(NewIndex);
+		}
+	}
+
+	for (int32 PreviousIndex = 0; PreviousIndex < InPreviousStates.Num(); PreviousIndex++)
+	{
+		// Note: all the duplicates of a path are matched together, like the RemoveAll() previously done for each new state
+		const int32 IndexedPreviousIndex = PreviousStatesIndex.FindChecked(InPreviousStates[PreviousIndex]->GetFilename());
+		if (!MatchedPreviousStates[IndexedPreviousIndex])
+		{
+			StatusDiff.Removed.Add(InPreviousStates[PreviousIndex]);
+		}
+	}
+
+	return StatusDiff;
+}
+
 /// Visitor to list all files in subdirectory
 class FFileVisitor : public IPlatformFile::FDirectoryVisitor
 {
@@ -528,110 +791,131 @@ public:
 	FString ServerPath;
 };
 
-/**
- * Find the locks matching the file path from the list of locks
- *
- * Multiple matching locks can only happen if multiple destination branches are configured
-*/
-TArray<FPlasticSourceControlLockRef> FindMatchingLocks(const TArray<FPlasticSourceControlLockRef>& InLocks, const FString& InPath)
+void ConcatStrings(FString& InOutString, const TCHAR* InSeparator, const FString& InOther)
 {
-	TArray<FPlasticSourceControlLockRef> MatchingLocks;
-	for (int i = 0; i < InLocks.Num(); i++)
+	if (!InOutString.IsEmpty())
 	{
-		if (InLocks[i]->Path == InPath)
-		{
-			MatchingLocks.Add(InLocks[i]);
-		}
+		InOutString += InSeparator;
 	}
-	return MatchingLocks;
+	InOutString += InOther;
 }
 
-void ConcatStrings(FString& InOutString, const TCHAR* InSeparator, const FString& InOther)
+// Fill the lock information of a file state (branch, workspace, date and lock status) from the locks matching its server path
+void ParseLocks(const TArray<FPlasticSourceControlLockRef>& InLocks, const FString& InBranchName, FPlasticSourceControlState& InOutState)
 {
-	if (!InOutString.IsEmpty())
+	InOutState.LockedId = ISourceControlState::INVALID_REVISION;
+	InOutState.LockedDate = 0;
+
+	// Concatenate the info of the locks before interning them in the state
+	FString LockedBy;
+	FString LockedWhere;
+	FString LockedBranch;
+	FString RetainedBy;
+
+	// Note: in case of multi destination branches, we might have multiple locks for the same path, so we concatenate the string info
+	// Multiple matching locks can only happen if multiple destination branches are configured
+	for (auto& Lock : InLocks)
 	{
-		InOutString += InSeparator;
+		// "Locked" vs "Retained" lock
+		if (Lock->bIsLocked)
+		{
+			ConcatStrings(LockedBy, TEXT(", "), PlasticSourceControlUtils::UserNameToDisplayName(Lock->Owner));
+		}
+		// Considers a "Retained" lock as meaningful only if it is retained on another branch
+		// NOTE: this is required to avoid the Unreal Editor showing a popup warning preventing the user to save the asset
+		else if (Lock->Branch != InBranchName)
+		{
+			ConcatStrings(RetainedBy, TEXT(", "), PlasticSourceControlUtils::UserNameToDisplayName(Lock->Owner));
+		}
+		ConcatStrings(LockedWhere, TEXT(", "), Lock->Workspace);
+		ConcatStrings(LockedBranch, TEXT(", "), Lock->Branch);
+
+		// Only save the ItemId if there is only one matching Lock: used to Unlock it from the context menu in the Content Browser,
+		// but leave the ItmeId to invalid if there are more than one: there would be no way to know which one to unlock from the context menu
+		// (Unlocking in such a case require using the View Locks window instead for disambiguation)
+		if (InLocks.Num() == 1)
+		{
+			InOutState.LockedId = Lock->ItemId;
+		}
+		// Note; this will keep only the date of the last lock
+		InOutState.LockedDate = Lock->Date;
 	}
-	InOutString += InOther;
+
+	InOutState.LockedBy = LockedBy;
+	InOutState.LockedWhere = LockedWhere;
+	InOutState.LockedBranch = LockedBranch;
+	InOutState.RetainedBy = RetainedBy;
 }
 
-/** Parse the array of strings result of a 'cm fileinfo --format="{RevisionChangeset};{RevisionHeadChangeset};{RepSpec};{LockedBy};{LockedWhere}"' command
+/** Parse the results of a 'cm fileinfo --format="{RevisionChangeset};{RevisionHeadChangeset};{RepSpec};{LockedBy};{LockedWhere};{ServerPath}"' command
  *
  * Example cm fileinfo results:
 16;16;;
 14;15;;
 17;17;srombauts;Workspace_2
  */
-void ParseFileinfoResults(const TArray<FString>& InResults, TArray<FPlasticSourceControlState>& InOutStates)
+FFileinfoResultsParser::FFileinfoResultsParser(TArray<FPlasticSourceControlState>& InOutStates)
+	: States(InOutStates)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseFileinfoResults);
-
-	ensureMsgf(InResults.Num() == InOutStates.Num(), TEXT("The fileinfo command should gives the same number of infos as the status command"));
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::FFileinfoResultsParser);
 
 	const FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
 	// Note: here is one of the rare places where we need to use a branch name, not a workspace selector
-	const FString& BranchName = Provider.GetBranchName();
+	BranchName = Provider.GetBranchName();
+	RootRepSpec = Provider.GetRepositorySpecification();
 
-	TArray<FPlasticSourceControlLockRef> Locks;
 	if (Provider.GetPlasticScmVersion() >= PlasticSourceControlVersions::SmartLocks)
 	{
 		// In the Content Browser, only show locks applying to the current working branch
 		const bool bForAllDestBranches = false;
-		PlasticSourceControlUtils::RunListLocks(Provider, bForAllDestBranches, Locks);
+		PlasticSourceControlUtils::RunListLocks(Provider, bForAllDestBranches, LocksIndex);
 	}
+}
 
-	// Iterate on all files and all status of the result (assuming same number of line of results than number of file states)
-	for (int32 IdxResult = 0; IdxResult < InResults.Num(); IdxResult++)
+void FFileinfoResultsParser::ParseLine(const FString& InResult)
+{
+	// Match each line of results with the next file state (assuming same number of line of results than number of file states)
+	const int32 IdxResult = NumResults++;
+	if (!States.IsValidIndex(IdxResult))
 	{
-		const FString& Fileinfo = InResults[IdxResult];
-		FPlasticSourceControlState& FileState = InOutStates[IdxResult];
-		const FString& File = FileState.LocalFilename;
-		FPlasticFileinfoParser FileinfoParser(Fileinfo);
+		return;
+	}
 
-		FileState.LocalRevisionChangeset = FileinfoParser.RevisionChangeset;
-		FileState.DepotRevisionChangeset = FileinfoParser.RevisionHeadChangeset;
-		FileState.RepSpec = FileinfoParser.RepSpec;
+	FPlasticSourceControlState& FileState = States[IdxResult];
+	const FString& File = FileState.LocalFilename;
+	FPlasticFileinfoParser FileinfoParser(InResult);
 
-		// Additional information coming from Locks (branch, workspace, date and lock status)
-		// Note: in case of multi destination branches, we might have multiple locks for the same path, so we concatenate the string info
-		const TArray<FPlasticSourceControlLockRef> MatchingLocks = FindMatchingLocks(Locks, FileinfoParser.ServerPath);
-		for (auto& Lock : MatchingLocks)
-		{
-			// "Locked" vs "Retained" lock
-			if (Lock->bIsLocked)
-			{
-				ConcatStrings(FileState.LockedBy, TEXT(", "), PlasticSourceControlUtils::UserNameToDisplayName(Lock->Owner));
-			}
-			// Considers a "Retained" lock as meaningful only if it is retained on another branch
-			// NOTE: this is required to avoid the Unreal Editor showing a popup warning preventing the user to save the asset
-			else if (Lock->Branch != BranchName)
-			{
-				ConcatStrings(FileState.RetainedBy, TEXT(", "), PlasticSourceControlUtils::UserNameToDisplayName(Lock->Owner));
-			}
-			ConcatStrings(FileState.LockedWhere, TEXT(", "), Lock->Workspace);
-			ConcatStrings(FileState.LockedBranch, TEXT(", "), Lock->Branch);
+	FileState.LocalRevisionChangeset = FileinfoParser.RevisionChangeset;
+	FileState.DepotRevisionChangeset = FileinfoParser.RevisionHeadChangeset;
+	FileState.RepSpec = FileinfoParser.RepSpec;
 
-			// Only save the ItemId if there is only one matching Lock: used to Unlock it from the context menu in the Content Browser,
-			// but leave the ItmeId to invalid if there are more than one: there would be no way to know which one to unlock from the context menu
-			// (Unlocking in such a case require using the View Locks window instead for disambiguation)
-			if (MatchingLocks.Num() == 1)
-			{
-				FileState.LockedId = Lock->ItemId;
-			}
-			// Note; this will keep only the date of the last lock
-			FileState.LockedDate = Lock->Date;
-		}
+	// Additional information coming from Locks (branch, workspace, date and lock status)
+	if (LocksIndex.IsValid())
+	{
+		ParseLocks(LocksIndex->FindByPath(FileinfoParser.ServerPath), BranchName, FileState);
+	}
 
-		// debug log (only for the first few files)
-		if (IdxResult < 20)
-		{
-			UE_LOG(LogSourceControl, Verbose, TEXT("%s: %d;%d %s by '%s' (%s)"), *File, FileState.LocalRevisionChangeset, FileState.DepotRevisionChangeset, *FileState.RepSpec, *FileState.LockedBy, *FileState.LockedWhere);
-		}
+	// Remember the local file of the server path, to update its locks from the next refresh of the cache of locks (but not for files under an xlink)
+	if (!FileinfoParser.ServerPath.IsEmpty() && (FileinfoParser.RepSpec.IsEmpty() || (FileinfoParser.RepSpec == RootRepSpec)))
+	{
+		PlasticSourceControlUtils::AddServerPath(FileinfoParser.ServerPath, File);
 	}
+
+	// debug log (only for the first few files)
+	if (IdxResult < 20)
+	{
+		UE_LOG(LogSourceControl, Verbose, TEXT("%s: %d;%d %s by '%s' (%s)"), *File, FileState.LocalRevisionChangeset, FileState.DepotRevisionChangeset, *FileState.RepSpec, *FileState.LockedBy, *FileState.LockedWhere);
+	}
+}
+
+void FFileinfoResultsParser::Finish()
+{
+	ensureMsgf(NumResults == States.Num(), TEXT("The fileinfo command should gives the same number of infos as the status command"));
+
 	// debug log (if too many files)
-	if (InResults.Num() > 20)
+	if (NumResults > 20)
 	{
-		UE_LOG(LogSourceControl, Verbose, TEXT("[...] %d more files"), InResults.Num() - 20);
+		UE_LOG(LogSourceControl, Verbose, TEXT("[...] %d more files"), NumResults - 20);
 	}
 }
 
@@ -710,23 +994,103 @@ static FString DecodeXmlEntities(const FString& InString)
  * Results of the history command in case of a move looks like that:
  <Branch>Moved from /Content/FirstPersonBP/Blueprints/BP_ToRename.uasset to /Content/FirstPersonBP/Blueprints/BP_TestsRenamed.uasset</Branch>
 */
-static FString ParseMovedFrom(const FXmlNode* InBranchNode)
+static FString ParseMovedFrom(const FString& InBranch)
 {
-	FString MovedFrom;
+	static const int32 MovedFromPrefixLen = FString("Moved from /").Len();
+	FString MovedFrom = InBranch.RightChop(MovedFromPrefixLen);
+
+	const int32 MovedToIndex = MovedFrom.Find(TEXT(" to "), ESearchCase::CaseSensitive);
+	if (MovedToIndex != INDEX_NONE)
+	{
+		MovedFrom.LeftInline(MovedToIndex);
+	}
+
+	return MovedFrom; // Convert server path to absolute
+}
 
-	if (InBranchNode != nullptr)
+// Parse an integer directly from the UTF-8 content of an XML element
+static int32 Utf8ToInt(const FAnsiStringView InUtf8)
+{
+	int32 Index = 0;
+	const bool bNegative = (InUtf8.Len() > 0) && (InUtf8[0] == '-');
+	if (bNegative)
+	{
+		Index++;
+	}
+	int32 Value = 0;
+	for (; (Index < InUtf8.Len()) && (InUtf8[Index] >= '0') && (InUtf8[Index] <= '9'); Index++)
 	{
-		static const int32 MovedFromPrefixLen = FString("Moved from /").Len();
-		MovedFrom = InBranchNode->GetContent().RightChop(MovedFromPrefixLen);
+		Value = Value * 10 + (InUtf8[Index] - '0');
+	}
+	return bNegative ? -Value : Value;
+}
+
+static FDateTime Utf8ToDateTime(const FAnsiStringView InUtf8)
+{
+	FDateTime DateTime;
+	FDateTime::ParseIso8601(*Utf8ToString(InUtf8), DateTime);
+	return DateTime;
+}
 
-		const int32 MovedToIndex = MovedFrom.Find(TEXT(" to "), ESearchCase::CaseSensitive);
-		if (MovedToIndex != INDEX_NONE)
+/**
+ * Stream the UTF-8 XML result file of a cm command through a parser, without building a DOM.
+ *
+ * The file is mapped read-only in memory so that its bytes are parsed in place, without copying or widening them on the heap;
+ * it is only read into a buffer on platforms not supporting memory mapped files.
+ *
+ * @param	InXmlFilename	The XML result file written by cm
+ * @param	InParserName	Name of the parser for logs
+ * @param	InTags			The tags of the elements of interest for the parser (see FPlasticSourceControlXmlReader)
+ * @param	InParser		The parser, reading the elements one by one
+ */
+static bool ParseXmlResultFile(const FString& InXmlFilename, const TCHAR* InParserName, TArrayView<const FAnsiStringView> InTags, TFunctionRef<bool(FPlasticSourceControlXmlReader& InReader)> InParser)
+{
+	// Note: the region needs to be unmapped before the file is closed, and both before the temporary file is deleted by the caller
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> Buffer;
+	FAnsiStringView Xml;
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseXmlResultFile::MapXml);
+		MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*InXmlFilename));
+		if (MappedFile.IsValid())
+		{
+			const int64 FileSize = MappedFile->GetFileSize();
+			if (FileSize > MAX_int32)
+			{
+				UE_LOG(LogSourceControl, Error, TEXT("%s: '%s' is too big (%lld bytes)"), InParserName, *InXmlFilename, FileSize);
+				return false;
+			}
+			if (FileSize > 0)
+			{
+				MappedRegion.Reset(MappedFile->MapRegion(0, FileSize));
+			}
+		}
+		if (MappedRegion.IsValid())
+		{
+			Xml = FAnsiStringView(reinterpret_cast<const ANSICHAR*>(MappedRegion->GetMappedPtr()), static_cast<int32>(MappedRegion->GetMappedSize()));
+		}
+		else if (FFileHelper::LoadFileToArray(Buffer, *InXmlFilename))
+		{
+			Xml = FAnsiStringView(reinterpret_cast<const ANSICHAR*>(Buffer.GetData()), Buffer.Num());
+		}
+		else
 		{
-			MovedFrom.LeftInline(MovedToIndex);
+			UE_LOG(LogSourceControl, Error, TEXT("%s: failed to read '%s'"), InParserName, *InXmlFilename);
+			return false;
 		}
 	}
 
-	return MovedFrom; // Convert server path to absolute
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseXmlResultFile::ParseXml);
+	FPlasticSourceControlXmlReader Reader(Xml, InTags);
+	const bool bResult = InParser(Reader);
+	if (Reader.HasError())
+	{
+		UE_LOG(LogSourceControl, Error, TEXT("%s: XML parse error '%s'"), InParserName, *Reader.GetError());
+		return false;
+	}
+
+	return bResult;
 }
 
 /**
@@ -799,223 +1163,253 @@ static FString ParseMovedFrom(const FXmlNode* InBranchNode)
   </RevisionHistories>
 </RevisionHistoriesResult>
 */
-static bool ParseHistoryResults(const bool bInUpdateHistory, const FXmlFile& InXmlResult, TArray<FPlasticSourceControlState>& InOutStates)
+// Raw content of the elements of a <Revision> of the history, kept until the end of its <RevisionHistory> to be processed in reverse order
+struct FHistoryRevisionXml
 {
-	const FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
-	const FString& WorkspaceRoot = Provider.GetPathToWorkspaceRoot();
-	const FString RootRepSpec = FString::Printf(TEXT("%s@%s"), *Provider.GetRepositoryName(), *Provider.GetServerUrl());
-	const FString CurrentBranch = Provider.GetBranchName();
+	FAnsiStringView Branch;
+	FAnsiStringView CreationDate;
+	FAnsiStringView RevisionType;
+	FAnsiStringView ChangesetNumber;
+	FAnsiStringView Owner;
+	FAnsiStringView Comment;
+	FAnsiStringView Size;
+	FAnsiStringView Hash;
+	bool bHasRevisionType = false;
+	bool bHasChangesetNumber = false;
+};
 
-	static const FString RevisionHistoriesResult(TEXT("RevisionHistoriesResult"));
-	static const FString RevisionHistories(TEXT("RevisionHistories"));
-	static const FString RevisionHistory(TEXT("RevisionHistory"));
-	static const FString ItemName(TEXT("ItemName"));
-	static const FString Revisions(TEXT("Revisions"));
-	static const FString Revision(TEXT("Revision"));
-	static const FString Branch(TEXT("Branch"));
-	static const FString CreationDate(TEXT("CreationDate"));
-	static const FString RevisionType(TEXT("RevisionType"));
-	static const FString ChangesetNumber(TEXT("ChangesetNumber"));
-	static const FString Owner(TEXT("Owner"));
-	static const FString Comment(TEXT("Comment"));
-	static const FString Size(TEXT("Size"));
-	static const FString Hash(TEXT("Hash"));
-
-	const FXmlNode* RevisionHistoriesResultNode = InXmlResult.GetRootNode();
-	if (RevisionHistoriesResultNode == nullptr || RevisionHistoriesResultNode->GetTag() != RevisionHistoriesResult)
-	{
-		return false;
-	}
+static void ParseRevisionHistory(const bool bInUpdateHistory, FString&& InFilename, const TArray<FHistoryRevisionXml>& InRevisions, const FString& InWorkspaceRoot, const FString& InRootRepSpec, const FString& InCurrentBranch, FPlasticSourceControlState& InOutState)
+{
+	FString Filename = MoveTemp(InFilename);
 
-	const FXmlNode* RevisionHistoriesNode = RevisionHistoriesResultNode->FindChildNode(RevisionHistories);
-	if (RevisionHistoriesNode == nullptr)
+	if (bInUpdateHistory)
 	{
-		return false;
+		InOutState.History.Reserve(InRevisions.Num());
 	}
 
-	const TArray<FXmlNode*>& RevisionHistoryNodes = RevisionHistoriesNode->GetChildrenNodes();
-	for (const FXmlNode* RevisionHistoryNode : RevisionHistoryNodes)
+	// parse history in reverse: needed to get most recent at the top (required by Unreal Editor for the "Diff with depot" using the index 0)
+	FString NextEntryMovedFrom;
+	for (int32 RevisionIndex = InRevisions.Num() - 1; RevisionIndex >= 0; RevisionIndex--)
 	{
-		const FXmlNode* ItemNameNode = RevisionHistoryNode->FindChildNode(ItemName);
-		if (ItemNameNode == nullptr)
-		{
-			continue;
-		}
-
-		FString Filename = ItemNameNode->GetContent();
-		FPlasticSourceControlState* InOutStatePtr = InOutStates.FindByPredicate(
-			[&Filename](const FPlasticSourceControlState& State) { return State.LocalFilename == Filename; }
-		);
-		if (InOutStatePtr == nullptr)
-		{
-			continue;
-		}
-		FPlasticSourceControlState& InOutState = *InOutStatePtr;
-
-		const FXmlNode* RevisionsNode = RevisionHistoryNode->FindChildNode(Revisions);
-		if (RevisionsNode == nullptr)
-		{
-			continue;
-		}
+		const FHistoryRevisionXml& RevisionXml = InRevisions[RevisionIndex];
 
-		const TArray<FXmlNode*>& RevisionNodes = RevisionsNode->GetChildrenNodes();
-		if (bInUpdateHistory)
-		{
-			InOutState.History.Reserve(RevisionNodes.Num());
-		}
+		const TSharedRef<FPlasticSourceControlRevision, ESPMode::ThreadSafe> SourceControlRevision = MakeShareable(new FPlasticSourceControlRevision);
+		SourceControlRevision->State = &InOutState;
+		SourceControlRevision->Filename = Filename;
 
-		// parse history in reverse: needed to get most recent at the top (required by Unreal Editor for the "Diff with depot" using the index 0)
-		FString NextEntryMovedFrom;
-		for (int32 RevisionIndex = RevisionNodes.Num() - 1; RevisionIndex >= 0; RevisionIndex--)
+		if (RevisionXml.bHasRevisionType)
 		{
-			const FXmlNode* RevisionNode = RevisionNodes[RevisionIndex];
-			check(RevisionNode);
-
-			const TSharedRef<FPlasticSourceControlRevision, ESPMode::ThreadSafe> SourceControlRevision = MakeShareable(new FPlasticSourceControlRevision);
-			SourceControlRevision->State = &InOutState;
-			SourceControlRevision->Filename = Filename;
-
-			if (const FXmlNode* RevisionTypeNode = RevisionNode->FindChildNode(RevisionType))
+			// There are two entries for a Move of an asset;
+			// 1. a regular one with the normal data: revision, comment, branch, Id, size, hash etc.
+			// 2. and another "empty" one for the Move
+			// => Since the parsing is done in reverse order, the detection of a Move need to apply to the next entry
+			if (RevisionXml.RevisionType.IsEmpty())
 			{
-				// There are two entries for a Move of an asset;
-				// 1. a regular one with the normal data: revision, comment, branch, Id, size, hash etc.
-				// 2. and another "empty" one for the Move
-				// => Since the parsing is done in reverse order, the detection of a Move need to apply to the next entry
-				if (RevisionTypeNode->GetContent().IsEmpty())
-				{
-					// An empty <RevisionType> signals a Move: save the "MovedFrom" filename to treat the next entry as a Move and update the Filename accordingly for next (older) entries
-					NextEntryMovedFrom = FPaths::Combine(WorkspaceRoot, ParseMovedFrom(RevisionNode->FindChildNode(Branch)));
+				// An empty <RevisionType> signals a Move: save the "MovedFrom" filename to treat the next entry as a Move and update the Filename accordingly for next (older) entries
+				NextEntryMovedFrom = FPaths::Combine(InWorkspaceRoot, ParseMovedFrom(Utf8ToString(RevisionXml.Branch)));
 
-					// and skip this revision as it is empty (it's just an additional entry with data for the move)
-					continue;
-				}
-				else
-				{
-					// If this entry was flagged as a move:
-					if (NextEntryMovedFrom.Len() > 0)
-					{
-						// Set this revision as a Move
-						SourceControlRevision->Action = SourceControlActionMoved;
-						// Update Filename for next (older) entries in the history and clear the NextEntryMovedFrom used as a flag
-						Filename = MoveTemp(NextEntryMovedFrom);
-					}
-					else if (RevisionIndex == 0)
-					{
-						SourceControlRevision->Action = SourceControlActionAdded;
-					}
-					else
-					{
-						SourceControlRevision->Action = SourceControlActionChanged;
-					}
-				}
+				// and skip this revision as it is empty (it's just an additional entry with data for the move)
+				continue;
 			}
-
-			if (const FXmlNode* ChangesetNumberNode = RevisionNode->FindChildNode(ChangesetNumber))
+			else
 			{
-				const FString& Changeset = ChangesetNumberNode->GetContent();
-				SourceControlRevision->ChangesetNumber = FCString::Atoi(*Changeset); // Value now used in the Revision column and in the Asset Menu History
-
-				// Also append depot name to the revision, but only when it is different from the default one (ie for xlinks sub repository)
-				if (!InOutState.RepSpec.IsEmpty() && (InOutState.RepSpec != RootRepSpec))
+				// If this entry was flagged as a move:
+				if (NextEntryMovedFrom.Len() > 0)
+				{
+					// Set this revision as a Move
+					SourceControlRevision->Action = SourceControlActionMoved;
+					// Update Filename for next (older) entries in the history and clear the NextEntryMovedFrom used as a flag
+					Filename = MoveTemp(NextEntryMovedFrom);
+				}
+				else if (RevisionIndex == 0)
 				{
-					TArray<FString> RepSpecs;
-					InOutState.RepSpec.ParseIntoArray(RepSpecs, TEXT("@"));
-					SourceControlRevision->Revision = FString::Printf(TEXT("cs:%s@%s"), *Changeset, *RepSpecs[0]);
+					SourceControlRevision->Action = SourceControlActionAdded;
 				}
 				else
 				{
-					SourceControlRevision->Revision = FString::Printf(TEXT("cs:%s"), *Changeset);
+					SourceControlRevision->Action = SourceControlActionChanged;
 				}
 			}
-			if (const FXmlNode* CommentNode = RevisionNode->FindChildNode(Comment))
-			{
-				SourceControlRevision->Description = DecodeXmlEntities(CommentNode->GetContent());
-			}
-			if (const FXmlNode* OwnerNode = RevisionNode->FindChildNode(Owner))
-			{
-				SourceControlRevision->UserName = PlasticSourceControlUtils::UserNameToDisplayName(OwnerNode->GetContent());
-			}
-			if (const FXmlNode* DateNode = RevisionNode->FindChildNode(CreationDate))
-			{
-				const FString& DateIso = DateNode->GetContent();
-				FDateTime::ParseIso8601(*DateIso, SourceControlRevision->Date);
-			}
-			if (const FXmlNode* BranchNode = RevisionNode->FindChildNode(Branch))
-			{
-				SourceControlRevision->Branch = DecodeXmlEntities(BranchNode->GetContent());
-			}
-			if (const FXmlNode* SizeNode = RevisionNode->FindChildNode(Size))
+		}
+
+		if (RevisionXml.bHasChangesetNumber)
+		{
+			const FString Changeset = Utf8ToString(RevisionXml.ChangesetNumber);
+			SourceControlRevision->ChangesetNumber = FCString::Atoi(*Changeset); // Value now used in the Revision column and in the Asset Menu History
+
+			// Also append depot name to the revision, but only when it is different from the default one (ie for xlinks sub repository)
+			if (!InOutState.RepSpec.IsEmpty() && (InOutState.RepSpec != InRootRepSpec))
 			{
-				SourceControlRevision->FileSize = FCString::Atoi(*SizeNode->GetContent());
+				TArray<FString> RepSpecs;
+				InOutState.RepSpec.Get().ParseIntoArray(RepSpecs, TEXT("@"));
+				SourceControlRevision->Revision = FString::Printf(TEXT("cs:%s@%s"), *Changeset, *RepSpecs[0]);
 			}
-
-			// A negative RevisionHeadChangeset provided by fileinfo mean that the file has been unshelved;
-			// replace it by the changeset number of the first revision in the history (the more recent)
-			// Note: workaround to be able to show the history / the diff of a file that has been unshelved
-			// (but keeps the LocalRevisionChangeset to the negative changeset corresponding to the Shelve Id)
-			if (InOutState.DepotRevisionChangeset < 0)
+			else
 			{
-				InOutState.DepotRevisionChangeset = SourceControlRevision->ChangesetNumber;
+				SourceControlRevision->Revision = FString::Printf(TEXT("cs:%s"), *Changeset);
 			}
+		}
+		SourceControlRevision->Description = DecodeXmlEntities(Utf8ToString(RevisionXml.Comment));
+		SourceControlRevision->UserName = PlasticSourceControlUtils::UserNameToDisplayName(Utf8ToString(RevisionXml.Owner));
+		if (!RevisionXml.CreationDate.IsEmpty())
+		{
+			SourceControlRevision->Date = Utf8ToDateTime(RevisionXml.CreationDate);
+		}
+		SourceControlRevision->Branch = DecodeXmlEntities(Utf8ToString(RevisionXml.Branch));
+		SourceControlRevision->FileSize = Utf8ToInt(RevisionXml.Size);
+		SourceControlRevision->Hash = Utf8ToString(RevisionXml.Hash);
+
+		// A negative RevisionHeadChangeset provided by fileinfo mean that the file has been unshelved;
+		// replace it by the changeset number of the first revision in the history (the more recent)
+		// Note: workaround to be able to show the history / the diff of a file that has been unshelved
+		// (but keeps the LocalRevisionChangeset to the negative changeset corresponding to the Shelve Id)
+		if (InOutState.DepotRevisionChangeset < 0)
+		{
+			InOutState.DepotRevisionChangeset = SourceControlRevision->ChangesetNumber;
+		}
 
-			// Detect and skip more recent changesets on other branches (ie above the RevisionHeadChangeset)
-			// since we usually don't want to display changes from other branches in the History window...
-			// except in case of a merge conflict, where the Editor expects the tip of the "source (remote)" branch to be at the top of the history!
-			if (   (SourceControlRevision->ChangesetNumber > InOutState.DepotRevisionChangeset)
-				&& (SourceControlRevision->Branch != CurrentBranch)
+		// Detect and skip more recent changesets on other branches (ie above the RevisionHeadChangeset)
+		// since we usually don't want to display changes from other branches in the History window...
+		// except in case of a merge conflict, where the Editor expects the tip of the "source (remote)" branch to be at the top of the history!
+		if (   (SourceControlRevision->ChangesetNumber > InOutState.DepotRevisionChangeset)
+			&& (SourceControlRevision->Branch != InCurrentBranch)
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
-				&& (SourceControlRevision->GetRevision() != InOutState.PendingResolveInfo.RemoteRevision))
+			&& (SourceControlRevision->GetRevision() != InOutState.PendingResolveInfo.RemoteRevision))
 #else
-				&& (SourceControlRevision->ChangesetNumber != InOutState.PendingMergeSourceChangeset))
+			&& (SourceControlRevision->ChangesetNumber != InOutState.PendingMergeSourceChangeset))
 #endif
+		{
+			InOutState.HeadBranch = SourceControlRevision->Branch;
+			InOutState.HeadAction = SourceControlRevision->Action;
+			InOutState.HeadChangeList = SourceControlRevision->ChangesetNumber;
+			InOutState.HeadUserName = SourceControlRevision->UserName;
+			InOutState.HeadModTime = SourceControlRevision->Date.ToUnixTimestamp();
+		}
+		else if (bInUpdateHistory)
+		{
+			InOutState.History.Add(SourceControlRevision);
+		}
+
+		// Also grab the UserName of the author of the current depot/head changeset
+		if ((SourceControlRevision->ChangesetNumber == InOutState.DepotRevisionChangeset) && InOutState.HeadUserName.IsEmpty())
+		{
+			InOutState.HeadUserName = SourceControlRevision->UserName;
+		}
+
+		if (!bInUpdateHistory)
+		{
+			break; // if not updating the history, just getting the head of the latest branch is enough
+		}
+	}
+}
+
+// Ids of the elements of interest in the results of the history command, indexes of their tags in HistoryTags
+enum class EHistoryTag : int32 { RevisionHistoriesResult, RevisionHistory, ItemName, Revision, Branch, CreationDate, RevisionType, ChangesetNumber, Owner, Comment, Size, Hash };
+static const FAnsiStringView HistoryTags[] = { "RevisionHistoriesResult", "RevisionHistory", "ItemName", "Revision", "Branch", "CreationDate", "RevisionType", "ChangesetNumber", "Owner", "Comment", "Size", "Hash" };
+
+static bool ParseHistoryResults(const bool bInUpdateHistory, FPlasticSourceControlXmlReader& InReader, TArray<FPlasticSourceControlState>& InOutStates)
+{
+	const FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
+	const FString& WorkspaceRoot = Provider.GetPathToWorkspaceRoot();
+	const FString RootRepSpec = FString::Printf(TEXT("%s@%s"), *Provider.GetRepositoryName(), *Provider.GetServerUrl());
+	const FString CurrentBranch = Provider.GetBranchName();
+
+	// Index the states by filename once, to find the state of each <RevisionHistory> in constant time instead of a linear search
+	// Note: iterate in reverse so that the first of any duplicate filenames wins, like a FindByPredicate() would
+	TMap<FString, int32> StatesIndex;
+	StatesIndex.Reserve(InOutStates.Num());
+	for (int32 StateIndex = InOutStates.Num() - 1; StateIndex >= 0; StateIndex--)
+	{
+		StatesIndex.Add(InOutStates[StateIndex].LocalFilename, StateIndex);
+	}
+
+	bool bFoundRoot = false;
+	FString Filename;
+	TArray<FHistoryRevisionXml> Revisions;
+	FHistoryRevisionXml* RevisionXml = nullptr;
+	while (InReader.Next())
+	{
+		const EHistoryTag Tag = static_cast<EHistoryTag>(InReader.GetTagId());
+		if (InReader.IsStart())
+		{
+			if (RevisionXml)
 			{
-				InOutState.HeadBranch = SourceControlRevision->Branch;
-				InOutState.HeadAction = SourceControlRevision->Action;
-				InOutState.HeadChangeList = SourceControlRevision->ChangesetNumber;
-				InOutState.HeadUserName = SourceControlRevision->UserName;
-				InOutState.HeadModTime = SourceControlRevision->Date.ToUnixTimestamp();
-			}
-			else if (bInUpdateHistory)
-			{
-				InOutState.History.Add(SourceControlRevision);
+				switch (Tag)
+				{
+				case EHistoryTag::Branch:
+					RevisionXml->Branch = InReader.ReadContent();
+					break;
+				case EHistoryTag::CreationDate:
+					RevisionXml->CreationDate = InReader.ReadContent();
+					break;
+				case EHistoryTag::RevisionType:
+					RevisionXml->RevisionType = InReader.ReadContent();
+					RevisionXml->bHasRevisionType = true;
+					break;
+				case EHistoryTag::ChangesetNumber:
+					RevisionXml->ChangesetNumber = InReader.ReadContent();
+					RevisionXml->bHasChangesetNumber = true;
+					break;
+				case EHistoryTag::Owner:
+					RevisionXml->Owner = InReader.ReadContent();
+					break;
+				case EHistoryTag::Comment:
+					RevisionXml->Comment = InReader.ReadContent();
+					break;
+				case EHistoryTag::Size:
+					RevisionXml->Size = InReader.ReadContent();
+					break;
+				case EHistoryTag::Hash:
+					RevisionXml->Hash = InReader.ReadContent();
+					break;
+				default:
+					break;
+				}
 			}
-
-			// Also grab the UserName of the author of the current depot/head changeset
-			if ((SourceControlRevision->ChangesetNumber == InOutState.DepotRevisionChangeset) && InOutState.HeadUserName.IsEmpty())
+			else
 			{
-				InOutState.HeadUserName = SourceControlRevision->UserName;
+				switch (Tag)
+				{
+				case EHistoryTag::RevisionHistoriesResult:
+					bFoundRoot = (InReader.GetDepth() == 1);
+					break;
+				case EHistoryTag::RevisionHistory:
+					Filename.Empty();
+					Revisions.Reset();
+					break;
+				case EHistoryTag::ItemName:
+					Filename = Utf8ToString(InReader.ReadContent());
+					break;
+				case EHistoryTag::Revision:
+					RevisionXml = &Revisions.AddDefaulted_GetRef();
+					break;
+				default:
+					break;
+				}
 			}
-
-			if (!bInUpdateHistory)
+		}
+		else if (Tag == EHistoryTag::Revision)
+		{
+			RevisionXml = nullptr;
+		}
+		else if ((Tag == EHistoryTag::RevisionHistory) && !Filename.IsEmpty())
+		{
+			if (const int32* StateIndex = StatesIndex.Find(Filename))
 			{
-				break; // if not updating the history, just getting the head of the latest branch is enough
+				ParseRevisionHistory(bInUpdateHistory, MoveTemp(Filename), Revisions, WorkspaceRoot, RootRepSpec, CurrentBranch, InOutStates[*StateIndex]);
 			}
 		}
 	}
 
-	return true;
+	return bFoundRoot;
 }
 
 bool ParseHistoryResults(const bool bInUpdateHistory, const FString& InXmlFilename, TArray<FPlasticSourceControlState>& InOutStates)
 {
-	bool bResult = false;
-
-	FXmlFile XmlFile;
-	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseHistoryResults::LoadXml);
-		bResult = XmlFile.LoadFile(InXmlFilename);
-	}
-	if (bResult)
-	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseHistoryResults::ParseXml);
-		bResult = ParseHistoryResults(bInUpdateHistory, XmlFile, InOutStates);
-	}
-	else
+	return ParseXmlResultFile(InXmlFilename, TEXT("ParseHistoryResults"), MakeArrayView(HistoryTags), [bInUpdateHistory, &InOutStates](FPlasticSourceControlXmlReader& InReader)
 	{
-		UE_LOG(LogSourceControl, Error, TEXT("ParseHistoryResults: XML parse error '%s'"), *XmlFile.GetLastError())
-	}
-
-	return bResult;
+		return ParseHistoryResults(bInUpdateHistory, InReader, InOutStates);
+	});
 }
 
 /* Parse results of the 'cm update --xml=tempfile.xml --encoding="utf-8"' command.
@@ -1032,62 +1426,51 @@ bool ParseHistoryResults(const bool bInUpdateHistory, const FString& InXmlFilena
   </List>
 </UpdatedItems>
 */
-static bool ParseUpdateResults(const FXmlFile& InXmlResult, TArray<FString>& OutFiles)
-{
-	static const FString UpdatedItems(TEXT("UpdatedItems"));
-	static const FString List(TEXT("List"));
-	static const FString UpdatedItem(TEXT("UpdatedItem"));
-	static const FString Path(TEXT("Path"));
-
-	const FXmlNode* UpdatedItemsNode = InXmlResult.GetRootNode();
-	if (UpdatedItemsNode == nullptr || UpdatedItemsNode->GetTag() != UpdatedItems)
-	{
-		return false;
-	}
+enum class EUpdateTag : int32 { UpdatedItems, UpdatedItem, Path };
+static const FAnsiStringView UpdateTags[] = { "UpdatedItems", "UpdatedItem", "Path" };
 
-	const FXmlNode* ListNode = UpdatedItemsNode->FindChildNode(List);
-	if (ListNode == nullptr)
-	{
-		return false;
-	}
-
-	const TArray<FXmlNode*>& UpdatedItemNodes = ListNode->GetChildrenNodes();
-	for (const FXmlNode* UpdatedItemNode : UpdatedItemNodes)
+static bool ParseUpdateResults(FPlasticSourceControlXmlReader& InReader, TArray<FString>& OutFiles)
+{
+	bool bFoundRoot = false;
+	bool bInUpdatedItem = false;
+	while (InReader.Next())
 	{
-		if (const FXmlNode* PathNode = UpdatedItemNode->FindChildNode(Path))
+		const EUpdateTag Tag = static_cast<EUpdateTag>(InReader.GetTagId());
+		if (InReader.IsStart())
 		{
-			FString Filename = PathNode->GetContent();
-			FPaths::NormalizeFilename(Filename);
-			if (!OutFiles.Contains(Filename))
+			if (Tag == EUpdateTag::UpdatedItems)
 			{
-				OutFiles.Add(Filename);
+				bFoundRoot = (InReader.GetDepth() == 1);
+			}
+			else if (Tag == EUpdateTag::UpdatedItem)
+			{
+				bInUpdatedItem = true;
+			}
+			else if ((Tag == EUpdateTag::Path) && bInUpdatedItem)
+			{
+				FString Filename = Utf8ToString(InReader.ReadContent());
+				FPaths::NormalizeFilename(Filename);
+				if (!OutFiles.Contains(Filename))
+				{
+					OutFiles.Add(Filename);
+				}
 			}
 		}
+		else if (Tag == EUpdateTag::UpdatedItem)
+		{
+			bInUpdatedItem = false;
+		}
 	}
 
-	return true;
+	return bFoundRoot;
 }
 
-bool ParseUpdateResults(const FString& InResults, TArray<FString>& OutFiles)
+bool ParseUpdateResults(const FString& InXmlFilename, TArray<FString>& OutFiles)
 {
-	bool bResult = false;
-
-	FXmlFile XmlFile;
-	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseUpdateResults::LoadXml);
-		bResult = XmlFile.LoadFile(InResults, EConstructMethod::ConstructFromBuffer);
-	}
-	if (bResult)
-	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseUpdateResults::ParseXml);
-		bResult = ParseUpdateResults(XmlFile, OutFiles);
-	}
-	else
+	return ParseXmlResultFile(InXmlFilename, TEXT("ParseUpdateResults"), MakeArrayView(UpdateTags), [&OutFiles](FPlasticSourceControlXmlReader& InReader)
 	{
-		UE_LOG(LogSourceControl, Error, TEXT("ParseUpdateResults: XML parse error '%s'"), *XmlFile.GetLastError())
-	}
-
-	return bResult;
+		return ParseUpdateResults(InReader, OutFiles);
+	});
 }
 
 /* Parse results of the 'cm partial update --report --machinereadable' command.
@@ -1099,27 +1482,20 @@ AD c:\Workspace\UE5PlasticPluginDev\Content\LevelPrototyping\Materials\MI_Solid_
 CH c:\Workspace\UE5PlasticPluginDev\Config\DefaultEditor.ini
 DE c:\Workspace\UE5PlasticPluginDev\Content\Collections\SebSharedCollection.collection
 */
-bool ParseUpdateResults(const TArray<FString>& InResults, TArray<FString>& OutFiles)
+void ParseUpdateResult(const FString& InResult, TArray<FString>& OutFiles)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseUpdateResultsString);
-
 	static const FString Stage = TEXT("STAGE ");
 	static const int32 PrefixLen = 3; // "XX " typically "CH ", "AD " or "DE "
 
-	for (const FString& Result : InResults)
-	{
-		if (Result.StartsWith(Stage))
-			continue;
+	if (InResult.StartsWith(Stage))
+		return;
 
-		FString Filename = Result.RightChop(PrefixLen);
-		FPaths::NormalizeFilename(Filename);
-		if (!OutFiles.Contains(Filename))
-		{
-			OutFiles.Add(Filename);
-		}
+	FString Filename = InResult.RightChop(PrefixLen);
+	FPaths::NormalizeFilename(Filename);
+	if (!OutFiles.Contains(Filename))
+	{
+		OutFiles.Add(MoveTemp(Filename));
 	}
-
-	return true;
 }
 
 
@@ -1187,98 +1563,154 @@ FText ParseCheckInResults(const TArray<FString>& InResults)
   </Changelists>
 </StatusOutput>
 */
-static bool ParseChangelistsResults(const FXmlFile& InXmlResult, TArray<FPlasticSourceControlChangelistState>& OutChangelistsStates, TArray<TArray<FPlasticSourceControlState>>& OutCLFilesStates)
-{
-	static const FString StatusOutput(TEXT("StatusOutput"));
-	static const FString WkConfigType(TEXT("WkConfigType"));
-	static const FString WkConfigName(TEXT("WkConfigName"));
-	static const FString Changelists(TEXT("Changelists"));
-	static const FString Changelist(TEXT("Changelist"));
-	static const FString Name(TEXT("Name"));
-	static const FString Description(TEXT("Description"));
-	static const FString Changes(TEXT("Changes"));
-	static const FString Change(TEXT("Change"));
-	static const FString Type(TEXT("Type"));
-	static const FString Path(TEXT("Path"));
-	static const FString OldPath(TEXT("OldPath"));
+enum class EChangelistsTag : int32 { StatusOutput, Changelist, Name, Description, Changes, Change, Type, Path, OldPath };
+static const FAnsiStringView ChangelistsTags[] = { "StatusOutput", "Changelist", "Name", "Description", "Changes", "Change", "Type", "Path", "OldPath" };
 
+static bool ParseChangelistsResults(FPlasticSourceControlXmlReader& InReader, TArray<FPlasticSourceControlChangelistState>& OutChangelistsStates, TArray<TArray<FPlasticSourceControlState>>& OutCLFilesStates)
+{
 	FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
 	const FString& WorkspaceRoot = Provider.GetPathToWorkspaceRoot();
 	const bool bUsesCheckedOutChanged = Provider.GetPlasticScmVersion() >= PlasticSourceControlVersions::StatusIsCheckedOutChanged;
 
-	const FXmlNode* StatusOutputNode = InXmlResult.GetRootNode();
-	if (StatusOutputNode == nullptr || StatusOutputNode->GetTag() != StatusOutput)
-	{
-		return false;
-	}
+	bool bFoundRoot = false;
 
-	const FXmlNode* ChangelistsNode = StatusOutputNode->FindChildNode(Changelists);
-	if (ChangelistsNode)
+	// Content of the current <Changelist>
+	bool bInChangelist = false;
+	bool bHasName = false;
+	bool bHasDescription = false;
+	bool bHasChanges = false;
+	FAnsiStringView Name;
+	FAnsiStringView Description;
+	TArray<FPlasticSourceControlState> FilesStates;
+
+	// Content of the current <Change>
+	bool bInChange = false;
+	bool bHasPath = false;
+	FAnsiStringView Type;
+	FAnsiStringView Path;
+	FAnsiStringView OldPath;
+
+	while (InReader.Next())
 	{
-		const TArray<FXmlNode*>& ChangelistNodes = ChangelistsNode->GetChildrenNodes();
-		OutCLFilesStates.SetNum(ChangelistNodes.Num());
-		for (int32 ChangelistIndex = 0; ChangelistIndex < ChangelistNodes.Num(); ChangelistIndex++)
+		const EChangelistsTag Tag = static_cast<EChangelistsTag>(InReader.GetTagId());
+		if (InReader.IsStart())
+		{
+			if (bInChange)
+			{
+				switch (Tag)
+				{
+				case EChangelistsTag::Type:
+					Type = InReader.ReadContent();
+					break;
+				case EChangelistsTag::Path:
+					Path = InReader.ReadContent();
+					bHasPath = true;
+					break;
+				case EChangelistsTag::OldPath:
+					OldPath = InReader.ReadContent();
+					break;
+				default:
+					break;
+				}
+			}
+			else if (bInChangelist)
+			{
+				switch (Tag)
+				{
+				case EChangelistsTag::Name:
+					Name = InReader.ReadContent();
+					bHasName = true;
+					break;
+				case EChangelistsTag::Description:
+					Description = InReader.ReadContent();
+					bHasDescription = true;
+					break;
+				case EChangelistsTag::Changes:
+					bHasChanges = true;
+					break;
+				case EChangelistsTag::Change:
+					bInChange = true;
+					bHasPath = false;
+					Type = Path = OldPath = FAnsiStringView();
+					break;
+				default:
+					break;
+				}
+			}
+			else if (Tag == EChangelistsTag::StatusOutput)
+			{
+				bFoundRoot = (InReader.GetDepth() == 1);
+			}
+			else if (Tag == EChangelistsTag::Changelist)
+			{
+				bInChangelist = true;
+				bHasName = bHasDescription = bHasChanges = false;
+				FilesStates.Reset();
+			}
+		}
+		else if (Tag == EChangelistsTag::Change)
 		{
-			const FXmlNode* ChangelistNode = ChangelistNodes[ChangelistIndex];
-			check(ChangelistNode);
-			const FXmlNode* NameNode = ChangelistNode->FindChildNode(Name);
-			const FXmlNode* DescriptionNode = ChangelistNode->FindChildNode(Description);
-			const FXmlNode* ChangesNode = ChangelistNode->FindChildNode(Changes);
-			if (NameNode == nullptr || DescriptionNode == nullptr || ChangesNode == nullptr)
+			bInChange = false;
+			if (!bHasPath)
 			{
 				continue;
 			}
 
-			FString NameTemp = DecodeXmlEntities(NameNode->GetContent());
-			FPlasticSourceControlChangelist ChangelistTemp(MoveTemp(NameTemp), true);
-			FString DescriptionTemp = ChangelistTemp.IsDefault() ? FString() : DecodeXmlEntities(DescriptionNode->GetContent());
-			FPlasticSourceControlChangelistState ChangelistState(MoveTemp(ChangelistTemp), MoveTemp(DescriptionTemp));
+			FPlasticSourceControlState FileState(FPaths::ConvertRelativePathToFull(WorkspaceRoot, Utf8ToString(Path)));
+			if (!Type.IsEmpty())
+			{
+				FileState.WorkspaceState = StateFromStatusUtf8(Type, bUsesCheckedOutChanged);
+			}
 
-			const TArray<FXmlNode*>& ChangeNodes = ChangesNode->GetChildrenNodes();
-			for (const FXmlNode* ChangeNode : ChangeNodes)
+			if ((FileState.WorkspaceState == EWorkspaceState::Moved) && !OldPath.IsEmpty())
 			{
-				check(ChangeNode);
-				const FXmlNode* PathNode = ChangeNode->FindChildNode(Path);
-				if (PathNode == nullptr)
-				{
-					continue;
-				}
+				FileState.MovedFrom = FPaths::ConvertRelativePathToFull(WorkspaceRoot, Utf8ToString(OldPath));
+			}
 
-				FPlasticSourceControlState FileState(FPaths::ConvertRelativePathToFull(WorkspaceRoot, PathNode->GetContent()));
-				FileState.Changelist = ChangelistState.Changelist;
-				if (const FXmlNode* TypeNode = ChangeNode->FindChildNode(Type))
+			// Note: in case of a Moved file, it appears twice in the list; just update the first entry (set as a "Changed") with the "Move" status
+			if (FPlasticSourceControlState* ExistingState = FilesStates.FindByPredicate(
+				[&FileState](const FPlasticSourceControlState& InState)
 				{
-					FileState.WorkspaceState = StateFromStatus(TypeNode->GetContent(), bUsesCheckedOutChanged);
-				}
+					return InState.GetFilename().Equals(FileState.GetFilename());
+				}))
+			{
+				ExistingState->WorkspaceState = FileState.WorkspaceState;
+				ExistingState->MovedFrom = FileState.MovedFrom;
+			}
+			else
+			{
+				FilesStates.Add(MoveTemp(FileState));
+			}
+		}
+		else if (Tag == EChangelistsTag::Changelist)
+		{
+			bInChangelist = false;
+			if (!bHasName || !bHasDescription || !bHasChanges)
+			{
+				continue;
+			}
 
-				if (FileState.WorkspaceState == EWorkspaceState::Moved)
-				{
-					if (const FXmlNode* OldPathNode = ChangeNode->FindChildNode(OldPath))
-					{
-						FileState.MovedFrom = FPaths::ConvertRelativePathToFull(WorkspaceRoot, OldPathNode->GetContent());
-					}
-				}
+			FString NameTemp = DecodeXmlEntities(Utf8ToString(Name));
+			FPlasticSourceControlChangelist ChangelistTemp(MoveTemp(NameTemp), true);
+			FString DescriptionTemp = ChangelistTemp.IsDefault() ? FString() : DecodeXmlEntities(Utf8ToString(Description));
+			FPlasticSourceControlChangelistState ChangelistState(MoveTemp(ChangelistTemp), MoveTemp(DescriptionTemp));
 
-				// Note: in case of a Moved file, it appears twice in the list; just update the first entry (set as a "Changed") with the "Move" status
-				if (FPlasticSourceControlState* ExistingState = OutCLFilesStates[ChangelistIndex].FindByPredicate(
-					[&FileState](const FPlasticSourceControlState& InState)
-					{
-						return InState.GetFilename().Equals(FileState.GetFilename());
-					}))
-				{
-					ExistingState->WorkspaceState = FileState.WorkspaceState;
-					ExistingState->MovedFrom = FileState.MovedFrom;
-				}
-				else
-				{
-					OutCLFilesStates[ChangelistIndex].Add(MoveTemp(FileState));
-				}
+			for (FPlasticSourceControlState& FileState : FilesStates)
+			{
+				FileState.Changelist = ChangelistState.Changelist;
 			}
 
 			OutChangelistsStates.Add(ChangelistState);
+			OutCLFilesStates.Add(MoveTemp(FilesStates));
+			FilesStates.Reset();
 		}
 	}
 
+	if (!bFoundRoot)
+	{
+		return false;
+	}
+
 	if (!OutChangelistsStates.FindByPredicate(
 		[](const FPlasticSourceControlChangelistState& CLState) { return CLState.Changelist.IsDefault(); }
 	))
@@ -1294,24 +1726,10 @@ static bool ParseChangelistsResults(const FXmlFile& InXmlResult, TArray<FPlastic
 
 bool ParseChangelistsResults(const FString& InXmlFilename, TArray<FPlasticSourceControlChangelistState>& OutChangelistsStates, TArray<TArray<FPlasticSourceControlState>>& OutCLFilesStates)
 {
-	bool bResult = false;
-
-	FXmlFile XmlFile;
-	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseChangelistsResults::LoadXml);
-		bResult = XmlFile.LoadFile(InXmlFilename);
-	}
-	if (bResult)
+	return ParseXmlResultFile(InXmlFilename, TEXT("ParseChangelistsResults"), MakeArrayView(ChangelistsTags), [&OutChangelistsStates, &OutCLFilesStates](FPlasticSourceControlXmlReader& InReader)
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseChangelistsResults::ParseXml);
-		bResult = ParseChangelistsResults(XmlFile, OutChangelistsStates, OutCLFilesStates);
-	}
-	else
-	{
-		UE_LOG(LogSourceControl, Error, TEXT("ParseChangelistsResults: XML parse error '%s'"), *XmlFile.GetLastError())
-	}
-
-	return bResult;
+		return ParseChangelistsResults(InReader, OutChangelistsStates, OutCLFilesStates);
+	});
 }
 
 // Parse the one letter file status in front of each line of the 'cm diff sh:<ShelveId>'
@@ -1661,84 +2079,72 @@ bool ParseShelvesResult(const FString& InResults, FString& OutComment, FDateTime
   [...]
 </PLASTICQUERY>
 */
-static bool ParseChangesetesResults(const FXmlFile& InXmlResult, TArray<FPlasticSourceControlChangesetRef>& OutChangesets)
-{
-	static const FString PlasticQuery(TEXT("PLASTICQUERY"));
-	static const FString ChangesetId(TEXT("CHANGESETID"));
-	static const FString Branch(TEXT("BRANCH"));
-	static const FString Comment(TEXT("COMMENT"));
-	static const FString Owner(TEXT("OWNER"));
-	static const FString Date(TEXT("DATE"));
-
-	const FXmlNode* PlasticQueryNode = InXmlResult.GetRootNode();
-	if (PlasticQueryNode == nullptr || PlasticQueryNode->GetTag() != PlasticQuery)
-	{
-		return false;
-	}
+enum class EChangesetsTag : int32 { PlasticQuery, ChangesetId, Branch, Comment, Owner, Date };
+static const FAnsiStringView ChangesetsTags[] = { "PLASTICQUERY", "CHANGESETID", "BRANCH", "COMMENT", "OWNER", "DATE" };
 
-	const TArray<FXmlNode*>& ChangesetsNodes = PlasticQueryNode->GetChildrenNodes();
-	OutChangesets.Reserve(ChangesetsNodes.Num());
-	for (const FXmlNode* ChangesetNode : ChangesetsNodes)
+static bool ParseChangesetsResults(FPlasticSourceControlXmlReader& InReader, TArray<FPlasticSourceControlChangesetRef>& OutChangesets)
+{
+	bool bFoundRoot = false;
+	bool bHasChangesetId = false;
+	FPlasticSourceControlChangesetRef ChangesetRef = MakeShareable(new FPlasticSourceControlChangeset());
+	while (InReader.Next())
 	{
-		check(ChangesetNode);
-		const FXmlNode* ChangesetIdNode = ChangesetNode->FindChildNode(ChangesetId);
-		if (ChangesetIdNode == nullptr)
-		{
-			continue;
-		}
-
-		FPlasticSourceControlChangesetRef ChangesetRef = MakeShareable(new FPlasticSourceControlChangeset());
-
-		ChangesetRef->ChangesetId = FCString::Atoi(*ChangesetIdNode->GetContent());
-
-		if (const FXmlNode* CommentNode = ChangesetNode->FindChildNode(Comment))
+		const EChangesetsTag Tag = static_cast<EChangesetsTag>(InReader.GetTagId());
+		if (InReader.GetDepth() == 1)
 		{
-			ChangesetRef->Comment = DecodeXmlEntities(CommentNode->GetContent());
+			bFoundRoot |= InReader.IsStart() && (Tag == EChangesetsTag::PlasticQuery);
 		}
-		if (const FXmlNode* BranchNode = ChangesetNode->FindChildNode(Branch))
+		// One <CHANGESET> element for each changeset
+		else if (InReader.GetDepth() == 2)
 		{
-			ChangesetRef->Branch = DecodeXmlEntities(BranchNode->GetContent());
-		}
-		if (const FXmlNode* OwnerNode = ChangesetNode->FindChildNode(Owner))
-		{
-			// Note: keeping the full email address as the owner name so we can display both the short and full name in the tooltip
-			ChangesetRef->CreatedBy = OwnerNode->GetContent();
+			if (InReader.IsStart())
+			{
+				ChangesetRef = MakeShareable(new FPlasticSourceControlChangeset());
+				bHasChangesetId = false;
+			}
+			else if (bHasChangesetId)
+			{
+				OutChangesets.Add(ChangesetRef);
+			}
 		}
-		if (const FXmlNode* DateNode = ChangesetNode->FindChildNode(Date))
+		else if (InReader.IsStart() && (InReader.GetDepth() == 3))
 		{
-			const FString& DateIso = DateNode->GetContent();
-			FDateTime::ParseIso8601(*DateIso, ChangesetRef->Date);
+			switch (Tag)
+			{
+			case EChangesetsTag::ChangesetId:
+				ChangesetRef->ChangesetId = Utf8ToInt(InReader.ReadContent());
+				bHasChangesetId = true;
+				break;
+			case EChangesetsTag::Comment:
+				ChangesetRef->Comment = DecodeXmlEntities(Utf8ToString(InReader.ReadContent()));
+				break;
+			case EChangesetsTag::Branch:
+				ChangesetRef->Branch = DecodeXmlEntities(Utf8ToString(InReader.ReadContent()));
+				break;
+			case EChangesetsTag::Owner:
+				// Note: keeping the full email address as the owner name so we can display both the short and full name in the tooltip
+				ChangesetRef->CreatedBy = Utf8ToString(InReader.ReadContent());
+				break;
+			case EChangesetsTag::Date:
+				ChangesetRef->Date = Utf8ToDateTime(InReader.ReadContent());
+				break;
+			default:
+				break;
+			}
 		}
-
-		OutChangesets.Add(MoveTemp(ChangesetRef));
 	}
 
-	return true;
+	return bFoundRoot;
 }
 
 bool ParseChangesetsResults(const FString& InXmlFilename, TArray<FPlasticSourceControlChangesetRef>& OutChangesets)
 {
-	bool bResult = false;
-
-	FXmlFile XmlFile;
-	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseChangesetesResults::LoadXml);
-		bResult = XmlFile.LoadFile(InXmlFilename);
-	}
-	if (bResult)
+	return ParseXmlResultFile(InXmlFilename, TEXT("ParseChangesetsResults"), MakeArrayView(ChangesetsTags), [&OutChangesets](FPlasticSourceControlXmlReader& InReader)
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseChangesetesResults::ParseXml);
-		bResult = ParseChangesetesResults(XmlFile, OutChangesets);
-	}
-	else
-	{
-		UE_LOG(LogSourceControl, Error, TEXT("ParseChangesetesResults: XML parse error '%s'"), *XmlFile.GetLastError())
-	}
-
-	return bResult;
+		return ParseChangesetsResults(InReader, OutChangesets);
+	});
 }
 
-
 /**
  * Convert the type of change in the log of changesets to a state.
  */
@@ -1770,7 +2176,7 @@ static EWorkspaceState StateFromType(const FString& InChangeType)
 }
 
 /**
- * Parse Changes child node in a Changeset.
+ * Parse one Item of the Changes of a Changeset.
  *
  * Results of the log command looks like the following:
 <?xml version="1.0" encoding="utf-8"?>
@@ -1797,74 +2203,45 @@ static EWorkspaceState StateFromType(const FString& InChangeType)
   </Changeset>
 </LogList>
  */
-static void ParseChangesInChangeset(const FXmlNode* InChangesetNode, const FPlasticSourceControlChangesetRef& InChangeset, TArray<FPlasticSourceControlStateRef>& OutFiles)
+static void ParseChangeInChangeset(const FAnsiStringView InType, const FAnsiStringView InSrcCmPath, const FAnsiStringView InDstCmPath, const FString& InRootRepSpec, const FPlasticSourceControlChangesetRef& InChangeset, TArray<FPlasticSourceControlStateRef>& OutFiles)
 {
-	static const FString Changes(TEXT("Changes"));
-	static const FString Item(TEXT("Item"));
-	static const FString Type(TEXT("Type"));
-	static const FString SrcCmPath(TEXT("SrcCmPath"));
-	static const FString DstCmPath(TEXT("DstCmPath"));
+	// Note: remove the leading '/' from the server path to make it relative to the root of the workspace
+	FString FileName = Utf8ToString(InDstCmPath).RightChop(1);
+	const EWorkspaceState WorkspaceState = StateFromType(Utf8ToString(InType));
+	FPlasticSourceControlStateRef State = MakeShareable(new FPlasticSourceControlState(MoveTemp(FileName), WorkspaceState));
+	State->RepSpec = InRootRepSpec;
 
-	const FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
-	const FString RootRepSpec = FString::Printf(TEXT("%s@%s"), *Provider.GetRepositoryName(), *Provider.GetServerUrl());
-
-	if (const FXmlNode* ChangesNode = InChangesetNode->FindChildNode(Changes))
+	if (WorkspaceState == EWorkspaceState::Moved)
 	{
-		const TArray<FXmlNode*>& ItemNodes = ChangesNode->GetChildrenNodes();
-		OutFiles.Reserve(ItemNodes.Num());
-		for (const FXmlNode* ItemNode : ItemNodes)
-		{
-			check(ItemNode);
-
-			const FXmlNode* PathNode = ItemNode->FindChildNode(DstCmPath);
-			const FXmlNode* TypeNode = ItemNode->FindChildNode(Type);
-			if ((PathNode == nullptr) || (TypeNode == nullptr))
-			{
-				continue;
-			}
-
-			// Note: remove the leading '/' from the server path to make it relative to the root of the workspace
-			FString FileName = PathNode->GetContent().RightChop(1);
-			const EWorkspaceState WorkspaceState = StateFromType(TypeNode->GetContent());
-			FPlasticSourceControlStateRef State = MakeShareable(new FPlasticSourceControlState(MoveTemp(FileName), WorkspaceState));
-			State->RepSpec = RootRepSpec;
+		State->MovedFrom = Utf8ToString(InSrcCmPath).RightChop(1); // remove the leading '/' character from the server path
+	}
 
-			if (WorkspaceState == EWorkspaceState::Moved)
-			{
-				if (const FXmlNode* SrcNode = ItemNode->FindChildNode(SrcCmPath))
-				{
-					State->MovedFrom = SrcNode->GetContent().RightChop(1); // remove the leading '/' character from the server path
-				}
-			}
+	// Add one revision to be able to fetch the file content for diff, if it's not marked for deletion.
+	if ((WorkspaceState != EWorkspaceState::Deleted) && (State->History.Num() == 0))
+	{
+		const TSharedRef<FPlasticSourceControlRevision, ESPMode::ThreadSafe> SourceControlRevision = MakeShareable(new FPlasticSourceControlRevision);
+		SourceControlRevision->State = &State.Get();
+		SourceControlRevision->Filename = State->GetFilename();
+		SourceControlRevision->Revision = FString::Printf(TEXT("cs:%d"), InChangeset->ChangesetId);
+		SourceControlRevision->ChangesetNumber = InChangeset->ChangesetId; // Note: for display in the diff window only
+		SourceControlRevision->Date = InChangeset->Date; // Note: not yet used for display as of UE5.2
 
-			// Add one revision to be able to fetch the file content for diff, if it's not marked for deletion.
-			if ((WorkspaceState != EWorkspaceState::Deleted) && (State->History.Num() == 0))
-			{
-				const TSharedRef<FPlasticSourceControlRevision, ESPMode::ThreadSafe> SourceControlRevision = MakeShareable(new FPlasticSourceControlRevision);
-				SourceControlRevision->State = &State.Get();
-				SourceControlRevision->Filename = State->GetFilename();
-				SourceControlRevision->Revision = FString::Printf(TEXT("cs:%d"), InChangeset->ChangesetId);
-				SourceControlRevision->ChangesetNumber = InChangeset->ChangesetId; // Note: for display in the diff window only
-				SourceControlRevision->Date = InChangeset->Date; // Note: not yet used for display as of UE5.2
-
-				State->History.Add(SourceControlRevision);
-			}
+		State->History.Add(SourceControlRevision);
+	}
 
-			// Note: in case of a Moved file, it appears twice in the list; just update the first entry (set as a "Changed") with the "Move" status
-			if (FPlasticSourceControlStateRef* ExistingState = OutFiles.FindByPredicate(
-				[&State](const TSharedRef<FPlasticSourceControlState, ESPMode::ThreadSafe>& InState)
-				{
-					return InState->GetFilename().Equals(State->GetFilename());
-				}))
-			{
-				(*ExistingState)->WorkspaceState = State->WorkspaceState;
-				(*ExistingState)->MovedFrom = State->MovedFrom;
-			}
-			else
-			{
-				OutFiles.Add(MoveTemp(State));
-			}
-		}
+	// Note: in case of a Moved file, it appears twice in the list; just update the first entry (set as a "Changed") with the "Move" status
+	if (FPlasticSourceControlStateRef* ExistingState = OutFiles.FindByPredicate(
+		[&State](const TSharedRef<FPlasticSourceControlState, ESPMode::ThreadSafe>& InState)
+		{
+			return InState->GetFilename().Equals(State->GetFilename());
+		}))
+	{
+		(*ExistingState)->WorkspaceState = State->WorkspaceState;
+		(*ExistingState)->MovedFrom = State->MovedFrom;
+	}
+	else
+	{
+		OutFiles.Add(MoveTemp(State));
 	}
 }
 
@@ -1901,60 +2278,98 @@ static void ParseChangesInChangeset(const FXmlNode* InChangesetNode, const FPlas
   </Changeset>
 </LogList>
 */
-static bool ParseLogResults(const FXmlFile& InXmlResult, const FPlasticSourceControlChangesetRef& InChangeset, TArray<FPlasticSourceControlStateRef>& OutFiles)
+enum class ELogTag : int32 { LogList, Changeset, ChangesetId, Changes, Item, Type, SrcCmPath, DstCmPath };
+static const FAnsiStringView LogTags[] = { "LogList", "Changeset", "ChangesetId", "Changes", "Item", "Type", "SrcCmPath", "DstCmPath" };
+
+static bool ParseLogResults(FPlasticSourceControlXmlReader& InReader, const FPlasticSourceControlChangesetRef& InChangeset, TArray<FPlasticSourceControlStateRef>& OutFiles)
 {
-	static const FString LogList(TEXT("LogList"));
-	static const FString ChangesetId(TEXT("ChangesetId"));
-	static const FString Branch(TEXT("Branch"));
-	static const FString Comment(TEXT("Comment"));
-	static const FString Owner(TEXT("Owner"));
-	static const FString Date(TEXT("Date"));
+	const FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
+	const FString RootRepSpec = FString::Printf(TEXT("%s@%s"), *Provider.GetRepositoryName(), *Provider.GetServerUrl());
 
-	const FXmlNode* LogListNode = InXmlResult.GetRootNode();
-	if (LogListNode == nullptr || LogListNode->GetTag() != LogList)
-	{
-		return false;
-	}
+	bool bFoundRoot = false;
+	int32 NumChangesets = 0;
+	bool bMatchingChangesetId = false;
+	TArray<FPlasticSourceControlStateRef> Files;
 
-	const TArray<FXmlNode*>& ChangesetsNodes = LogListNode->GetChildrenNodes();
-	if (ChangesetsNodes.Num() != 1 || ChangesetsNodes[0] == nullptr)
+	// Content of the current <Item> of the <Changes> of the changeset
+	bool bInItem = false;
+	bool bHasType = false;
+	bool bHasDstCmPath = false;
+	FAnsiStringView Type;
+	FAnsiStringView SrcCmPath;
+	FAnsiStringView DstCmPath;
+
+	while (InReader.Next())
 	{
-		return false;
+		const ELogTag Tag = static_cast<ELogTag>(InReader.GetTagId());
+		if (InReader.IsStart())
+		{
+			if (bInItem)
+			{
+				switch (Tag)
+				{
+				case ELogTag::Type:
+					Type = InReader.ReadContent();
+					bHasType = true;
+					break;
+				case ELogTag::SrcCmPath:
+					SrcCmPath = InReader.ReadContent();
+					break;
+				case ELogTag::DstCmPath:
+					DstCmPath = InReader.ReadContent();
+					bHasDstCmPath = true;
+					break;
+				default:
+					break;
+				}
+			}
+			else if (InReader.GetDepth() == 1)
+			{
+				bFoundRoot = (Tag == ELogTag::LogList);
+			}
+			else if (InReader.GetDepth() == 2)
+			{
+				NumChangesets++;
+			}
+			else if ((InReader.GetDepth() == 3) && (Tag == ELogTag::ChangesetId))
+			{
+				bMatchingChangesetId = (InChangeset->ChangesetId == Utf8ToInt(InReader.ReadContent()));
+			}
+			else if ((InReader.GetDepth() == 4) && (Tag == ELogTag::Item))
+			{
+				bInItem = true;
+				bHasType = bHasDstCmPath = false;
+				Type = SrcCmPath = DstCmPath = FAnsiStringView();
+			}
+		}
+		else if (bInItem && (Tag == ELogTag::Item))
+		{
+			bInItem = false;
+			if (bHasType && bHasDstCmPath)
+			{
+				// List Files States and create a Revision
+				ParseChangeInChangeset(Type, SrcCmPath, DstCmPath, RootRepSpec, InChangeset, Files);
+			}
+		}
 	}
 
-	FXmlNode* ChangesetNode = ChangesetsNodes[0];
-	const FXmlNode* ChangesetIdNode = ChangesetNode->FindChildNode(ChangesetId);
-	if (ChangesetIdNode == nullptr || InChangeset->ChangesetId != FCString::Atoi(*ChangesetIdNode->GetContent()))
+	// Exactly one changeset is expected, the one requested
+	if (!bFoundRoot || (NumChangesets != 1) || !bMatchingChangesetId)
 	{
 		return false;
 	}
 
-	// List Files States and create a Revision
-	ParseChangesInChangeset(ChangesetNode, InChangeset, OutFiles);
+	OutFiles.Append(MoveTemp(Files));
 
 	return true;
 }
 
 bool ParseLogResults(const FString& InXmlFilename, const FPlasticSourceControlChangesetRef& InChangeset, TArray<FPlasticSourceControlStateRef>& OutFiles)
 {
-	bool bResult = false;
-
-	FXmlFile XmlFile;
-	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseLogResults::LoadXml);
-		bResult = XmlFile.LoadFile(InXmlFilename);
-	}
-	if (bResult)
+	return ParseXmlResultFile(InXmlFilename, TEXT("ParseLogResults"), MakeArrayView(LogTags), [&InChangeset, &OutFiles](FPlasticSourceControlXmlReader& InReader)
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseLogResults::ParseXml);
-		bResult = ParseLogResults(XmlFile, InChangeset, OutFiles);
-	}
-	else
-	{
-		UE_LOG(LogSourceControl, Error, TEXT("ParseLogResults: XML parse error '%s'"), *XmlFile.GetLastError())
-	}
-
-	return bResult;
+		return ParseLogResults(InReader, InChangeset, OutFiles);
+	});
 }
 
 /**
@@ -1980,86 +2395,83 @@ bool ParseLogResults(const FString& InXmlFilename, const FPlasticSourceControlCh
   [...]
 </PLASTICQUERY>
 */
-static bool ParseBranchesResults(const FXmlFile& InXmlResult, TArray<FPlasticSourceControlBranchRef>& OutBranches)
-{
-	static const FString PlasticQuery(TEXT("PLASTICQUERY"));
-	static const FString Branch(TEXT("BRANCH"));
-	static const FString Comment(TEXT("COMMENT"));
-	static const FString Date(TEXT("DATE"));
-	static const FString Owner(TEXT("OWNER"));
-	static const FString Name(TEXT("NAME"));
-	static const FString RepName(TEXT("REPNAME"));
-	static const FString RepServer(TEXT("REPSERVER"));
-
-	const FXmlNode* PlasticQueryNode = InXmlResult.GetRootNode();
-	if (PlasticQueryNode == nullptr || PlasticQueryNode->GetTag() != PlasticQuery)
-	{
-		return false;
-	}
-
-	const TArray<FXmlNode*>& BranchesNodes = PlasticQueryNode->GetChildrenNodes();
-	OutBranches.Reserve(BranchesNodes.Num());
-	for (const FXmlNode* BranchNode : BranchesNodes)
-	{
-		check(BranchNode);
-		const FXmlNode* NameNode = BranchNode->FindChildNode(Name);
-		if (NameNode == nullptr)
-		{
-			continue;
-		}
-
-		FPlasticSourceControlBranchRef BranchRef = MakeShareable(new FPlasticSourceControlBranch());
-
-		BranchRef->Name = DecodeXmlEntities(NameNode->GetContent());
+enum class EBranchesTag : int32 { PlasticQuery, Comment, Date, Owner, Name, RepName, RepServer };
+static const FAnsiStringView BranchesTags[] = { "PLASTICQUERY", "COMMENT", "DATE", "OWNER", "NAME", "REPNAME", "REPSERVER" };
 
-		if (const FXmlNode* CommentNode = BranchNode->FindChildNode(Comment))
-		{
-			BranchRef->Comment = DecodeXmlEntities(CommentNode->GetContent());
-		}
-		if (const FXmlNode* DateNode = BranchNode->FindChildNode(Date))
+static bool ParseBranchesResults(FPlasticSourceControlXmlReader& InReader, TArray<FPlasticSourceControlBranchRef>& OutBranches)
+{
+	bool bFoundRoot = false;
+	bool bHasName = false;
+	bool bHasRepName = false;
+	bool bHasRepServer = false;
+	FString RepName;
+	FString RepServer;
+	FPlasticSourceControlBranchRef BranchRef = MakeShareable(new FPlasticSourceControlBranch());
+	while (InReader.Next())
+	{
+		const EBranchesTag Tag = static_cast<EBranchesTag>(InReader.GetTagId());
+		if (InReader.GetDepth() == 1)
 		{
-			const FString& DateIso = DateNode->GetContent();
-			FDateTime::ParseIso8601(*DateIso, BranchRef->Date);
+			bFoundRoot |= InReader.IsStart() && (Tag == EBranchesTag::PlasticQuery);
 		}
-		if (const FXmlNode* OwnerNode = BranchNode->FindChildNode(Owner))
+		// One <BRANCH> element for each branch
+		else if (InReader.GetDepth() == 2)
 		{
-			// Note: keeping the full email address as the owner name so we can display both the short and full name in the tooltip
-			BranchRef->CreatedBy = OwnerNode->GetContent();
+			if (InReader.IsStart())
+			{
+				BranchRef = MakeShareable(new FPlasticSourceControlBranch());
+				bHasName = bHasRepName = bHasRepServer = false;
+			}
+			else if (bHasName)
+			{
+				if (bHasRepName && bHasRepServer)
+				{
+					BranchRef->Repository = RepName + TEXT("@") + RepServer;
+				}
+				OutBranches.Add(BranchRef);
+			}
 		}
-		if (const FXmlNode* RepNameNode = BranchNode->FindChildNode(RepName))
+		else if (InReader.IsStart() && (InReader.GetDepth() == 3))
 		{
-			if (const FXmlNode* RepServerNode = BranchNode->FindChildNode(RepServer))
+			switch (Tag)
 			{
-				BranchRef->Repository = RepNameNode->GetContent() + TEXT("@") + RepServerNode->GetContent();
+			case EBranchesTag::Name:
+				BranchRef->Name = DecodeXmlEntities(Utf8ToString(InReader.ReadContent()));
+				bHasName = true;
+				break;
+			case EBranchesTag::Comment:
+				BranchRef->Comment = DecodeXmlEntities(Utf8ToString(InReader.ReadContent()));
+				break;
+			case EBranchesTag::Date:
+				BranchRef->Date = Utf8ToDateTime(InReader.ReadContent());
+				break;
+			case EBranchesTag::Owner:
+				// Note: keeping the full email address as the owner name so we can display both the short and full name in the tooltip
+				BranchRef->CreatedBy = Utf8ToString(InReader.ReadContent());
+				break;
+			case EBranchesTag::RepName:
+				RepName = Utf8ToString(InReader.ReadContent());
+				bHasRepName = true;
+				break;
+			case EBranchesTag::RepServer:
+				RepServer = Utf8ToString(InReader.ReadContent());
+				bHasRepServer = true;
+				break;
+			default:
+				break;
 			}
 		}
-
-		OutBranches.Add(MoveTemp(BranchRef));
 	}
 
-	return true;
+	return bFoundRoot;
 }
 
 bool ParseBranchesResults(const FString& InXmlFilename, TArray<FPlasticSourceControlBranchRef>& OutBranches)
 {
-	bool bResult = false;
-
-	FXmlFile XmlFile;
-	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseBranchesResults::LoadXml);
-		bResult = XmlFile.LoadFile(InXmlFilename);
-	}
-	if (bResult)
-	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlParsers::ParseBranchesResults::ParseXml);
-		bResult = ParseBranchesResults(XmlFile, OutBranches);
-	}
-	else
+	return ParseXmlResultFile(InXmlFilename, TEXT("ParseBranchesResults"), MakeArrayView(BranchesTags), [&OutBranches](FPlasticSourceControlXmlReader& InReader)
 	{
-		UE_LOG(LogSourceControl, Error, TEXT("ParseBranchesResults: XML parse error '%s'"), *XmlFile.GetLastError())
-	}
-
-	return bResult;
+		return ParseBranchesResults(InReader, OutBranches);
+	});
 }
 
 /* Parse results of the 'cm merge --xml=tempfile.xml --encoding="utf-8" --merge <branch-name>' command.
@@ -3,15 +3,18 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/StringView.h"
+
+#include "PlasticSourceControlState.h"
 
 #include "Runtime/Launch/Resources/Version.h"
 
 class FPlasticSourceControlChangelistState;
 class FPlasticSourceControlLock;
 class FPlasticSourceControlRevision;
-class FPlasticSourceControlState;
 typedef TSharedRef<class FPlasticSourceControlBranch, ESPMode::ThreadSafe> FPlasticSourceControlBranchRef;
 typedef TSharedRef<class FPlasticSourceControlChangeset, ESPMode::ThreadSafe> FPlasticSourceControlChangesetRef;
+typedef TSharedRef<class FPlasticSourceControlLock, ESPMode::ThreadSafe> FPlasticSourceControlLockRef;
 typedef TSharedRef<class FPlasticSourceControlState, ESPMode::ThreadSafe> FPlasticSourceControlStateRef;
 
 namespace PlasticSourceControlParsers
@@ -60,17 +63,98 @@ TArray<FString> ParseRepository(TArray<FString>& InResults);
 bool ParseWorkspaceInfo(TArray<FString>& InResults, FString& OutWorkspaceSelector, FString& OutBranchName, FString& OutRepositoryName, FString& OutServerUrl);
 
 bool GetChangesetFromWorkspaceStatus(const TArray<FString>& InResults, int32& OutChangeset);
+bool GetChangesetFromWorkspaceStatus(const FString& InWorkspaceStatus, int32& OutChangeset);
+
+/**
+ * Parse the results of a "cm status --machinereadable" command line by line, as soon as they are received.
+ *
+ * The first line is the workspace status with the current changeset, then each line gives the state of one file.
+ */
+class FStatusResultParser
+{
+public:
+	FStatusResultParser();
+
+	/** Parse one line of result, from a string */
+	void ParseLine(FString&& InResult);
+
+	/** Parse one line of result directly from the raw UTF-8 bytes received from cm, only allocating the resulting filename */
+	void ParseLine(const FAnsiStringView InResult);
 
-void ParseFileStatusResult(TArray<FString>&& InFiles, const TArray<FString>& InResults, TArray<FPlasticSourceControlState>& OutStates);
+	/** The current Changeset Number from the workspace status, if found */
+	int32 Changeset = -1;
 
-void ParseDirectoryStatusResult(const FString& InDir, const TArray<FString>& InResults, TArray<FPlasticSourceControlState>& OutStates);
+	/** States of the files found in the results of the status command */
+	TArray<FPlasticSourceControlState> States;
+
+private:
+	bool bUsesCheckedOutChanged = false;
+	bool bWorkspaceStatusParsed = false;
+};
+
+void ParseFileStatusResult(TArray<FString>&& InFiles, TArray<FPlasticSourceControlState>&& InStatusStates, TArray<FPlasticSourceControlState>& OutStates);
+
+void ParseDirectoryStatusResult(const FString& InDir, TArray<FPlasticSourceControlState>&& InStatusStates, TArray<FPlasticSourceControlState>& OutStates);
+
+/**
+ * Differences between the previous states of the files of a directory, typically from the cache, and the new states from a status of the directory.
+ */
+struct FDirectoryStatusDiff
+{
+	/** Indexes in the new states of the files that had no previous state */
+	TArray<int32> Added;
 
-void ParseFileinfoResults(const TArray<FString>& InResults, TArray<FPlasticSourceControlState>& InOutStates);
+	/** Previous states of the files not found in the new states anymore */
+	TArray<FSourceControlStateRef> Removed;
+
+	/** Indexes in the new states, and in the previous states, of the files which workspace state changed */
+	TArray<TPair<int32, int32>> Changed;
+};
+
+/**
+ * Compare the previous states of the files of a directory with the new states from a status of the directory.
+ *
+ * Files are matched through a hash map of their paths, case-insensitively, so the cost is linear in the number of states.
+ *
+ * @param	InPreviousStates	The previous states of the files, eg. the cached states of the files under the directory
+ * @param	InNewStates			The new states from the results of the status command on the directory
+ */
+FDirectoryStatusDiff DiffDirectoryStatus(const TArray<FSourceControlStateRef>& InPreviousStates, const TArray<FPlasticSourceControlState>& InNewStates);
+
+/**
+ * Parse the results of a "cm fileinfo" command line by line, as soon as they are received, into the corresponding file states.
+ *
+ * @note The list of locks is retrieved by the constructor, so it must be created before running the fileinfo command.
+ */
+class FFileinfoResultsParser
+{
+public:
+	explicit FFileinfoResultsParser(TArray<FPlasticSourceControlState>& InOutStates);
+
+	void ParseLine(const FString& InResult);
+	void Finish();
+
+private:
+	TArray<FPlasticSourceControlState>& States;
+	TSharedPtr<const class FPlasticSourceControlLocksIndex, ESPMode::ThreadSafe> LocksIndex;
+	FString BranchName;
+	FString RootRepSpec;
+	int32 NumResults = 0;
+};
+
+/**
+ * Fill the lock information of a file state from the locks matching its server path, replacing any previous one.
+ *
+ * @param	InLocks			The locks of the server path of the file (more than one only if multiple destination branches are configured)
+ * @param	InBranchName	The current branch, since "Retained" locks are only meaningful on another branch
+ * @param	InOutState		The state of the file to update
+ */
+void ParseLocks(const TArray<FPlasticSourceControlLockRef>& InLocks, const FString& InBranchName, FPlasticSourceControlState& InOutState);
 
 bool ParseHistoryResults(const bool bInUpdateHistory, const FString& InXmlFilename, TArray<FPlasticSourceControlState>& InOutStates);
 
-bool ParseUpdateResults(const FString& InResults, TArray<FString>& OutFiles);
-bool ParseUpdateResults(const TArray<FString>& InResults, TArray<FString>& OutFiles);
+bool ParseUpdateResults(const FString& InXmlFilename, TArray<FString>& OutFiles);
+void ParseUpdateResult(const FString& InResult, TArray<FString>& OutFiles);
 
 FText ParseCheckInResults(const TArray<FString>& InResults);
 
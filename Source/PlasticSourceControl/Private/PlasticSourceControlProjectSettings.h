@@ -29,10 +29,26 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = "Unity Version Control", meta = (ClampMin = 0))
 	int32 LimitNumberOfRevisionsInHistory = 50;
 
-	/** Set an expiration time in minutes for the cache of SmartLocks, after which they need to be retrieved again from the server (default to 5 min) */
+	/** Set an expiration time in minutes for the cache of SmartLocks, after which they need to be retrieved again from the server, and are refreshed in the background (default to 5 min) */
 	UPROPERTY(config, EditAnywhere, Category = "Unity Version Control", meta = (ClampMin = 1))
 	double LocksCacheExpirationDelayMinutes = 5.0;
 
+	/** Number of background 'cm shell' processes used to run read-only commands (status, fileinfo, history...) in parallel (default to 2). An additional primary shell is reserved to mutating commands, run one at a time, and to the commands of interactive operations. Applied on the next connection. */
+	UPROPERTY(config, EditAnywhere, Category = "Unity Version Control", meta = (ClampMin = 1, ClampMax = 8))
+	int32 ShellPoolSize = 2;
+
+	/** Watch the files changed on disk in the workspace, to restrict the status of whole directories (eg "Submit Content" or "Refresh") to the files changed since their last full status (enabled by default). Applied on the next connection. */
+	UPROPERTY(config, EditAnywhere, Category = "Unity Version Control")
+	bool bEnableWorkspaceWatcher = true;
+
+	/** Interval in minutes after which a full status of a whole directory is required again, as a safety net for the changes missed by the workspace watcher (default to 5 min) */
+	UPROPERTY(config, EditAnywhere, Category = "Unity Version Control", meta = (ClampMin = 1, EditCondition = "bEnableWorkspaceWatcher"))
+	double WorkspaceWatcherFullStatusIntervalMinutes = 5.0;
+
+	/** Files whose status was updated less than this number of seconds ago are skipped by the asynchronous status updates requested by the Editor, eg. on selection in the Content Browser (default to 2s, 0 to disable) */
+	UPROPERTY(config, EditAnywhere, Category = "Unity Version Control", meta = (ClampMin = 0))
+	double UpdateStatusFreshnessSeconds = 2.0;
+
 	/** Show the repository where the branch is created (hidden by default) */
 	UPROPERTY(config, EditAnywhere, Category = "Unity Version Control|View Branches window")
 	bool bShowBranchRepositoryColumn = false;
@@ -22,6 +22,7 @@
 #include "Interfaces/IPluginManager.h"
 
 #include "Algo/Transform.h"
+#include "Async/Async.h"
 #include "Misc/Paths.h"
 #include "Misc/MessageDialog.h"
 #include "HAL/PlatformProcess.h"
@@ -147,6 +148,12 @@ void FPlasticSourceControlProvider::CheckPlasticAvailability()
 			TArray<FString> ErrorMessages;
 			PlasticSourceControlUtils::GetWorkspaceInfo(WorkspaceSelector, BranchName, RepositoryName, ServerUrl, ErrorMessages);
 			UserName = PlasticSourceControlUtils::GetProfileUserName(Profiles, ServerUrl);
+
+			// Changes on disk are only reported while the Editor ticks, so never rely on them in a commandlet
+			if (GIsEditor && !IsRunningCommandlet() && GetDefault<UPlasticSourceControlProjectSettings>()->bEnableWorkspaceWatcher)
+			{
+				WorkspaceWatcher.Start(PathToWorkspaceRoot);
+			}
 		}
 		else
 		{
@@ -160,8 +167,23 @@ void FPlasticSourceControlProvider::CheckPlasticAvailability()
 
 void FPlasticSourceControlProvider::Close()
 {
+	// notify the callers of the operations completed since the last tick, since the provider might not be ticked anymore
+	ProcessDeferredCompletions();
+	// cancel the commands not dispatched yet, since they would run against a closed connection, and notify their callers
+	CancelPendingCommands();
 	// clear the cache
 	StateCache.Empty();
+	ChangesetFilesCache.Empty();
+	// stop watching the workspace for changes, since they are not tracked against the cache anymore
+	WorkspaceWatcher.Stop();
+	PlasticSourceControlUtils::ResetServerPaths();
+	// cancel the background refresh of the locks, so that it only waits for its 'cm shell' to stop the command before terminating it
+	if (LocksRefresh.IsValid())
+	{
+		FPlatformAtomics::InterlockedExchange(&bLocksRefreshCancelled, 1);
+		LocksRefresh.Wait();
+		LocksRefresh = TFuture<TArray<FString>>();
+	}
 	// terminate the background 'cm shell' process and associated pipes
 	PlasticSourceControlShell::Terminate();
 	// Remove all extensions to the "Source Control" menu in the Editor Toolbar
@@ -177,19 +199,12 @@ void FPlasticSourceControlProvider::Close()
 
 TSharedRef<FPlasticSourceControlState, ESPMode::ThreadSafe> FPlasticSourceControlProvider::GetStateInternal(const FString& InFilename)
 {
-	TSharedRef<FPlasticSourceControlState, ESPMode::ThreadSafe>* State = StateCache.Find(InFilename);
-	if (State != NULL)
-	{
-		// found cached item
-		return (*State);
-	}
-	else
-	{
-		// cache an unknown state for this item
-		TSharedRef<FPlasticSourceControlState, ESPMode::ThreadSafe> NewState = MakeShareable(new FPlasticSourceControlState(FString(InFilename)));
-		StateCache.Add(InFilename, NewState);
-		return NewState;
-	}
+	return StateCache.FindOrAdd(InFilename);
+}
+
+TSharedPtr<FPlasticSourceControlState, ESPMode::ThreadSafe> FPlasticSourceControlProvider::FindStateInternal(const FString& InFilename) const
+{
+	return StateCache.Find(InFilename);
 }
 
 #if ENGINE_MAJOR_VERSION == 5
@@ -221,6 +236,9 @@ void FPlasticSourceControlProvider::HandlePackageSaved(const FString& InPackageF
 	const FString AbsoluteFilename = FPaths::ConvertRelativePathToFull(InPackageFilename);
 	auto FileState = GetStateInternal(AbsoluteFilename);
 
+	// The notification of the directory watcher only comes later, possibly after the next status of the directory
+	WorkspaceWatcher.MarkDirtyFiles({ AbsoluteFilename });
+
 	// Note: the Editor doesn't ask to refresh the source control status of an asset after it is saved, only *before* (to check that it's possible to save)
 	// So when an asset with no change is saved, update its state in cache to record the fact that the asset is now changed.
 	// Note that updating the state in cache isn't enough to refresh the status icon in the Content Browser or the View Changes windows (since the Editor isn't made aware of the change)
@@ -414,20 +432,26 @@ TArray<FSourceControlChangelistStateRef> FPlasticSourceControlProvider::GetCache
 TArray<FSourceControlStateRef> FPlasticSourceControlProvider::GetCachedStateByPredicate(TFunctionRef<bool(const FSourceControlStateRef&)> Predicate) const
 {
 	TArray<FSourceControlStateRef> Result;
-	for (const auto& CacheItem : StateCache)
+	for (const FPlasticSourceControlStateRef& State : StateCache.GetByPredicate([&Predicate](const FPlasticSourceControlStateRef& InState) { return Predicate(InState); }))
 	{
-		FSourceControlStateRef State = CacheItem.Value;
-		if (Predicate(State))
-		{
-			Result.Add(State);
-		}
+		Result.Add(State);
 	}
 	return Result;
 }
 
+TArray<FPlasticSourceControlStateRef> FPlasticSourceControlProvider::GetCachedStatesUnderDirectory(const FString& InDirectory, TFunctionRef<bool(const FPlasticSourceControlStateRef&)> InPredicate) const
+{
+	return StateCache.GetUnderDirectory(InDirectory, InPredicate);
+}
+
 bool FPlasticSourceControlProvider::RemoveFileFromCache(const FString& Filename)
 {
-	return StateCache.Remove(Filename) > 0;
+	return StateCache.Remove(Filename);
+}
+
+void FPlasticSourceControlProvider::RenameCaseInCache(const FPlasticSourceControlStateRef& InState, const FString& InFilename)
+{
+	StateCache.RenameCase(InState, InFilename);
 }
 
 FDelegateHandle FPlasticSourceControlProvider::RegisterSourceControlStateChanged_Handle(const FSourceControlStateChanged::FDelegate& SourceControlStateChanged)
@@ -474,8 +498,39 @@ void FPlasticSourceControlProvider::UnregisterSourceControlStateChanged_Handle(F
 		return ECommandResult::Failed;
 	}
 
+	TArray<FString> AbsoluteFiles = SourceControlHelpers::AbsoluteFilenames(InFiles);
+
+	// Don't let the status of a directory miss the changes on disk that the directory watcher has not notified yet
+	WorkspaceWatcher.Flush();
+	if (InOperation->GetName() != "UpdateStatus")
+	{
+		// The files of other operations are likely to change on disk (checkout, revert...) while an update of their status already covers them
+		WorkspaceWatcher.MarkDirtyFiles(AbsoluteFiles);
+	}
+
+	// The Editor fires many overlapping asynchronous status updates (selection and scrolling in the Content Browser, etc.), often for the same files:
+	// skip the files which status is fresh enough, and merge the others into a pending status update that has not started yet
+	if ((InConcurrency == EConcurrency::Asynchronous) && (InOperation->GetName() == "UpdateStatus") && (AbsoluteFiles.Num() > 0))
+	{
+		if (!StaticCastSharedRef<FUpdateStatus>(InOperation)->ShouldUpdateHistory())
+		{
+			RemoveRecentlyUpdatedFiles(AbsoluteFiles);
+			if (AbsoluteFiles.Num() == 0)
+			{
+				UE_LOG(LogSourceControl, Verbose, TEXT("UpdateStatus of %d items skipped: status updated recently"), InFiles.Num());
+				// Like for any asynchronous operation, the caller is only notified of the completion from Tick(), never from within Execute()
+				DeferredCompletions.Add({ InOperation, InOperationCompleteDelegate, ECommandResult::Succeeded });
+				return ECommandResult::Succeeded;
+			}
+		}
+		if (CoalesceUpdateStatus(InOperation, AbsoluteFiles, InOperationCompleteDelegate))
+		{
+			return ECommandResult::Succeeded;
+		}
+	}
+
 	FPlasticSourceControlCommand* Command = new FPlasticSourceControlCommand(InOperation, Worker.ToSharedRef());
-	Command->Files = SourceControlHelpers::AbsoluteFilenames(InFiles);
+	Command->Files = MoveTemp(AbsoluteFiles);
 	Command->OperationCompleteDelegate = InOperationCompleteDelegate;
 
 #if ENGINE_MAJOR_VERSION == 5
@@ -500,18 +555,143 @@ void FPlasticSourceControlProvider::UnregisterSourceControlStateChanged_Handle(F
 	}
 }
 
+void FPlasticSourceControlProvider::RemoveRecentlyUpdatedFiles(TArray<FString>& InOutFiles) const
+{
+	const double FreshnessSeconds = GetDefault<UPlasticSourceControlProjectSettings>()->UpdateStatusFreshnessSeconds;
+	if (FreshnessSeconds <= 0.0)
+	{
+		return;
+	}
+
+	const FDateTime Now = FDateTime::Now();
+	InOutFiles.RemoveAll([this, &Now, FreshnessSeconds](const FString& InFile)
+	{
+		const FPlasticSourceControlStatePtr State = StateCache.Find(InFile);
+		return State.IsValid() && (State->WorkspaceState != EWorkspaceState::Unknown) && ((Now - State->TimeStamp).GetTotalSeconds() < FreshnessSeconds);
+	});
+}
+
+bool FPlasticSourceControlProvider::CoalesceUpdateStatus(const FSourceControlOperationRef& InOperation, const TArray<FString>& InFiles, const FSourceControlOperationComplete& InOperationCompleteDelegate)
+{
+	if (GThreadPool == nullptr)
+	{
+		return false;
+	}
+
+	const TSharedRef<FUpdateStatus, ESPMode::ThreadSafe> Operation = StaticCastSharedRef<FUpdateStatus>(InOperation);
+	for (FPlasticSourceControlCommand* Command : CommandQueue)
+	{
+		// Only merge into asynchronous commands on files (not on a changelist) with the same options
+		if (!Command->bAutoDelete || Command->bExecuteProcessed || (Command->Files.Num() == 0) || (Command->Operation->GetName() != InOperation->GetName()))
+		{
+			continue;
+		}
+		const TSharedRef<FUpdateStatus, ESPMode::ThreadSafe> PendingOperation = StaticCastSharedRef<FUpdateStatus>(Command->Operation);
+		if ((PendingOperation->ShouldUpdateHistory() != Operation->ShouldUpdateHistory())
+			|| (PendingOperation->ShouldGetOpenedOnly() != Operation->ShouldGetOpenedOnly())
+			|| (PendingOperation->ShouldUpdateModifiedState() != Operation->ShouldUpdateModifiedState())
+			|| (PendingOperation->ShouldCheckAllFiles() != Operation->ShouldCheckAllFiles()))
+		{
+			continue;
+		}
+
+		// Only a command not yet started by a worker thread can be modified: retracting it from the thread pool fails once it has started
+		const bool bRetracted = Command->bDispatched && GThreadPool->RetractQueuedWork(Command);
+		if (Command->bDispatched && !bRetracted)
+		{
+			continue;
+		}
+
+		const int32 NumPendingFiles = Command->Files.Num();
+		TSet<FString> PendingFiles(Command->Files);
+		for (const FString& File : InFiles)
+		{
+			bool bIsAlreadyInSet = false;
+			PendingFiles.Add(File, &bIsAlreadyInSet);
+			if (!bIsAlreadyInSet)
+			{
+				Command->Files.Add(File);
+			}
+		}
+		Command->CoalescedOperations.Emplace(InOperation, InOperationCompleteDelegate);
+		if (bRetracted)
+		{
+			GThreadPool->AddQueuedWork(Command);
+		}
+
+		UE_LOG(LogSourceControl, Log, TEXT("UpdateStatus of %d items merged into a pending UpdateStatus of %d items (%d new)"), InFiles.Num(), NumPendingFiles, Command->Files.Num() - NumPendingFiles);
+		return true;
+	}
+
+	return false;
+}
+
 bool FPlasticSourceControlProvider::CanExecuteOperation(const FSourceControlOperationRef& InOperation) const
 {
 	return WorkersMap.Find(InOperation->GetName()) != nullptr;
 }
 
+// Whether the operation was merged into the command of another caller (see CoalesceUpdateStatus())
+static int32 FindCoalescedOperation(const FPlasticSourceControlCommand& InCommand, const FSourceControlOperationRef& InOperation)
+{
+	return InCommand.CoalescedOperations.IndexOfByPredicate([&InOperation](const TPair<FSourceControlOperationRef, FSourceControlOperationComplete>& InCoalescedOperation)
+	{
+		return InCoalescedOperation.Key == InOperation;
+	});
+}
+
 bool FPlasticSourceControlProvider::CanCancelOperation(const FSourceControlOperationRef& InOperation) const
 {
+	for (const FPlasticSourceControlCommand* Command : CommandQueue)
+	{
+		if (!Command->bExecuteProcessed && !Command->IsCancelled() && ((Command->Operation == InOperation) || (FindCoalescedOperation(*Command, InOperation) != INDEX_NONE)))
+		{
+			return true;
+		}
+	}
 	return false;
 }
 
 void FPlasticSourceControlProvider::CancelOperation(const FSourceControlOperationRef& InOperation)
 {
+	for (FPlasticSourceControlCommand* Command : CommandQueue)
+	{
+		if (Command->bExecuteProcessed)
+		{
+			continue;
+		}
+
+		// An operation merged into the command of another caller is only detached from it, and completed on next Tick(), like any other cancelled operation
+		const int32 CoalescedIndex = FindCoalescedOperation(*Command, InOperation);
+		if (CoalescedIndex != INDEX_NONE)
+		{
+			UE_LOG(LogSourceControl, Log, TEXT("CancelOperation: %s (merged into another one)"), *InOperation->GetName().ToString());
+			DeferredCompletions.Add({ InOperation, Command->CoalescedOperations[CoalescedIndex].Value, ECommandResult::Cancelled });
+			Command->CoalescedOperations.RemoveAt(CoalescedIndex);
+			return;
+		}
+
+		if (Command->Operation != InOperation)
+		{
+			continue;
+		}
+
+		UE_LOG(LogSourceControl, Log, TEXT("CancelOperation: %s"), *InOperation->GetName().ToString());
+		Command->Cancel();
+
+		// A command that has not started yet is completed right away, to free its place in the queue on next Tick(),
+		// while a running command completes as soon as its current 'cm' command has been stopped
+		if (!Command->bDispatched)
+		{
+			PendingCommands[static_cast<int32>(Command->Priority)].Remove(Command);
+			FPlatformAtomics::InterlockedExchange(&Command->bExecuteProcessed, 1);
+		}
+		else if ((GThreadPool != nullptr) && GThreadPool->RetractQueuedWork(Command))
+		{
+			FPlatformAtomics::InterlockedExchange(&Command->bExecuteProcessed, 1);
+		}
+		return;
+	}
 }
 
 bool FPlasticSourceControlProvider::UsesLocalReadOnlyState() const
@@ -689,62 +869,191 @@ void FPlasticSourceControlProvider::UpdateWorkspaceStatus(const class FPlasticSo
 	}
 }
 
+// Maximum time spent processing the completed commands in one Tick(), to keep the editor responsive when many commands complete together
+static constexpr double TickCommandsTimeBudget = 0.010;
+
 void FPlasticSourceControlProvider::Tick()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FPlasticSourceControlProvider::Tick);
 
+	// Dispatch the pending commands to the shells freed by the commands that completed their execution since last tick
+	DispatchCommands();
+
+	ProcessDeferredCompletions();
+
+	const double StartTimestamp = FPlatformTime::Seconds();
 	bool bStatesUpdated = false;
+	int32 NumCommandsProcessed = 0;
+	// Process all the completed commands within the time budget, at least one per tick, and broadcast the update of their states only once.
+	// Note: each command is removed from the queue before running its completion delegate, and the queue is searched again for the next one,
+	// since the delegate can issue new commands, or even execute a synchronous command that ticks the provider recursively.
+	while (FPlasticSourceControlCommand* Command = PopCompletedCommand())
+	{
+		bStatesUpdated |= ProcessCompletedCommand(*Command);
+		NumCommandsProcessed++;
+
+		if (FPlatformTime::Seconds() - StartTimestamp > TickCommandsTimeBudget)
+		{
+			break;
+		}
+	}
+	if (NumCommandsProcessed > 1)
+	{
+		UE_LOG(LogSourceControl, Verbose, TEXT("Tick: %d commands processed in %.3lfs"), NumCommandsProcessed, (FPlatformTime::Seconds() - StartTimestamp));
+	}
+
+	bStatesUpdated |= TickLocksRefresh();
+
+	if (bStatesUpdated)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FPlasticSourceControlProvider::Tick::BroadcastStateUpdate);
+		OnSourceControlStateChanged.Broadcast();
+	}
+}
+
+void FPlasticSourceControlProvider::ProcessDeferredCompletions()
+{
+	// Note: a delegate can execute a new operation, adding another completion to the list, which is then run on the next Tick()
+	const TArray<FDeferredCompletion> Completions = MoveTemp(DeferredCompletions);
+	DeferredCompletions.Reset();
+	for (const FDeferredCompletion& Completion : Completions)
+	{
+		Completion.OperationCompleteDelegate.ExecuteIfBound(Completion.Operation, Completion.Result);
+	}
+}
+
+void FPlasticSourceControlProvider::CancelPendingCommands()
+{
+	bool bAnyPendingCommand = false;
+	for (TArray<FPlasticSourceControlCommand*>& Commands : PendingCommands)
+	{
+		for (FPlasticSourceControlCommand* Command : Commands)
+		{
+			UE_LOG(LogSourceControl, Log, TEXT("Close: %s not run"), *Command->Operation->GetName().ToString());
+			Command->Cancel();
+			FPlatformAtomics::InterlockedExchange(&Command->bExecuteProcessed, 1);
+			bAnyPendingCommand = true;
+		}
+		Commands.Reset();
+	}
+	if (!bAnyPendingCommand)
+	{
+		return;
+	}
+
+	// Note: the commands still running are left in the queue, to be processed by the next Tick() as usual, a synchronous command is processed by the loop waiting for it,
+	// and the commands issued by the completion delegates are not dispatched yet, so they are not completed
+	for (int32 CommandIndex = 0; CommandIndex < CommandQueue.Num();)
+	{
+		FPlasticSourceControlCommand* Command = CommandQueue[CommandIndex];
+		if (Command->bAutoDelete && !Command->bDispatched && Command->bExecuteProcessed)
+		{
+			CommandQueue.RemoveAt(CommandIndex);
+			ProcessCompletedCommand(*Command);
+		}
+		else
+		{
+			CommandIndex++;
+		}
+	}
+}
+
+FPlasticSourceControlCommand* FPlasticSourceControlProvider::PopCompletedCommand()
+{
 	for (int32 CommandIndex = 0; CommandIndex < CommandQueue.Num(); ++CommandIndex)
 	{
-		FPlasticSourceControlCommand& Command = *CommandQueue[CommandIndex];
-		if (Command.bExecuteProcessed)
+		FPlasticSourceControlCommand* Command = CommandQueue[CommandIndex];
+		if (Command->bExecuteProcessed)
 		{
-			// Remove command from the queue
 			CommandQueue.RemoveAt(CommandIndex);
+			return Command;
+		}
+	}
+	return nullptr;
+}
 
-			// Update workspace status and connection state on Connect and UpdateStatus operations
-			UpdateWorkspaceStatus(Command);
+bool FPlasticSourceControlProvider::ProcessCompletedCommand(FPlasticSourceControlCommand& InCommand)
+{
+	// Discard the partial results of a cancelled command: it didn't fail, so the connection state is left as is
+	bool bStatesUpdated = false;
+	if (!InCommand.IsCancelled())
+	{
+		// Update workspace status and connection state on Connect and UpdateStatus operations
+		UpdateWorkspaceStatus(InCommand);
 
-			// let command update the states of any files
-			bStatesUpdated |= Command.Worker->UpdateStates();
+		// let command update the states of any files
+		bStatesUpdated = InCommand.Worker->UpdateStates();
+	}
 
-			// dump any messages to output log
-			OutputCommandMessages(Command);
+	// dump any messages to output log
+	OutputCommandMessages(InCommand);
 
-			if (Command.Files.Num() > 1)
-			{
-				UE_LOG(LogSourceControl, Log, TEXT("%s of %d items processed in %.3lfs"), *Command.Operation->GetName().ToString(), Command.Files.Num(), (FPlatformTime::Seconds() - Command.StartTimestamp));
-			}
-			else if (Command.Files.Num() == 1)
-			{
-				UE_LOG(LogSourceControl, Log, TEXT("%s of %s processed in %.3lfs"), *Command.Operation->GetName().ToString(), *Command.Files[0], (FPlatformTime::Seconds() - Command.StartTimestamp));
-			}
-			else
-			{
-				UE_LOG(LogSourceControl, Log, TEXT("%s processed in %.3lfs"), *Command.Operation->GetName().ToString(), (FPlatformTime::Seconds() - Command.StartTimestamp));
-			}
+	if (InCommand.Files.Num() > 1)
+	{
+		UE_LOG(LogSourceControl, Log, TEXT("%s of %d items processed in %.3lfs"), *InCommand.Operation->GetName().ToString(), InCommand.Files.Num(), (FPlatformTime::Seconds() - InCommand.StartTimestamp));
+	}
+	else if (InCommand.Files.Num() == 1)
+	{
+		UE_LOG(LogSourceControl, Log, TEXT("%s of %s processed in %.3lfs"), *InCommand.Operation->GetName().ToString(), *InCommand.Files[0], (FPlatformTime::Seconds() - InCommand.StartTimestamp));
+	}
+	else
+	{
+		UE_LOG(LogSourceControl, Log, TEXT("%s processed in %.3lfs"), *InCommand.Operation->GetName().ToString(), (FPlatformTime::Seconds() - InCommand.StartTimestamp));
+	}
 
-			// run the completion delegate callback if we have one bound
-			Command.ReturnResults();
+	// run the completion delegate callback if we have one bound
+	InCommand.ReturnResults();
 
-			// commands that are left in the array during a tick need to be deleted
-			if (Command.bAutoDelete)
-			{
-				// Only delete commands that are not running 'synchronously'
-				delete &Command;
-			}
+	// commands that are left in the array during a tick need to be deleted
+	if (InCommand.bAutoDelete)
+	{
+		// Only delete commands that are not running 'synchronously'
+		delete &InCommand;
+	}
 
-			// only do one command per tick loop, as we don't want concurrent modification
-			// of the command queue (which can happen in the completion delegate)
-			break;
+	return bStatesUpdated;
+}
+
+bool FPlasticSourceControlProvider::TickLocksRefresh()
+{
+	bool bStatesUpdated = false;
+
+	if (LocksRefresh.IsValid())
+	{
+		if (!LocksRefresh.IsReady())
+		{
+			return false;
 		}
+
+		// Only update the states of the files for which the locks changed, if any
+		const TArray<FString> ChangedPaths = LocksRefresh.Get();
+		LocksRefresh = TFuture<TArray<FString>>();
+		bStatesUpdated = PlasticSourceControlUtils::UpdateCachedLocks(ChangedPaths);
 	}
 
-	if (bStatesUpdated)
+	const double Now = FPlatformTime::Seconds();
+	// Note: the background refresh of the locks waits for the interactive commands in the queue, to not delay them further
+	if (bWorkspaceFound && IsAvailable() && (PlasticScmVersion >= PlasticSourceControlVersions::SmartLocks)
+		&& (PendingCommands[static_cast<int32>(EPlasticCommandPriority::Interactive)].Num() == 0)
+		&& (Now - LocksRefreshTime >= GetDefault<UPlasticSourceControlProjectSettings>()->LocksCacheExpirationDelayMinutes * 60.0))
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FPlasticSourceControlProvider::Tick::BroadcastStateUpdate);
-		OnSourceControlStateChanged.Broadcast();
+		LocksRefreshTime = Now;
+
+		// Copy the parameters of the command on the Game Thread, where they can change
+		const FString RepositorySpecification = GetRepositorySpecification();
+		const FString WorkingBranch = (PlasticScmVersion >= PlasticSourceControlVersions::WorkingBranch) ? BranchName : FString();
+		FPlatformAtomics::InterlockedExchange(&bLocksRefreshCancelled, 0);
+		const volatile int32* CancelFlag = &bLocksRefreshCancelled;
+		LocksRefresh = Async(EAsyncExecution::ThreadPool, [RepositorySpecification, WorkingBranch, CancelFlag]()
+		{
+			PlasticSourceControlShell::FScopedCancellation Cancellation(CancelFlag);
+			TArray<FString> ChangedPaths;
+			PlasticSourceControlUtils::RefreshLocksCache(RepositorySpecification, WorkingBranch, ChangedPaths);
+			return ChangedPaths;
+		});
 	}
+
+	return bStatesUpdated;
 }
 
 TArray<TSharedRef<ISourceControlLabel>> FPlasticSourceControlProvider::GetLabels(const FString& InMatchingSpec) const
@@ -794,7 +1103,12 @@ ECommandResult::Type FPlasticSourceControlProvider::ExecuteSynchronousCommand(FP
 
 	// Display the progress dialog if a string was provided
 	{
-		FScopedSourceControlProgress Progress(Task);
+		// The progress dialog lets the user cancel the command
+		FScopedSourceControlProgress Progress(Task, FSimpleDelegate::CreateLambda([&InCommand]()
+		{
+			UE_LOG(LogSourceControl, Log, TEXT("ExecuteSynchronousCommand: %s cancelled by the user"), *InCommand.Operation->GetName().ToString());
+			InCommand.Cancel();
+		}));
 
 		// Issue the command asynchronously...
 		IssueCommand(InCommand);
@@ -838,7 +1152,11 @@ ECommandResult::Type FPlasticSourceControlProvider::ExecuteSynchronousCommand(FP
 		// always do one more Tick() to make sure the command queue is cleaned up.
 		Tick();
 
-		if (InCommand.bCommandSuccessful)
+		if (InCommand.IsCancelled())
+		{
+			Result = ECommandResult::Cancelled;
+		}
+		else if (InCommand.bCommandSuccessful)
 		{
 			Result = ECommandResult::Succeeded;
 		}
@@ -861,13 +1179,112 @@ ECommandResult::Type FPlasticSourceControlProvider::ExecuteSynchronousCommand(FP
 	return Result;
 }
 
+// Synchronous commands and explicit user actions are dispatched ahead of the speculative commands run in the background
+static EPlasticCommandPriority GetCommandPriority(const FPlasticSourceControlCommand& InCommand)
+{
+	static const FName InteractiveOperations[] = {
+		"CheckOut", "CheckIn", "Revert", "RevertUnchanged", "RevertAll", "Unlock", "MarkForAdd", "Delete", "Copy", "Resolve"
+	};
+
+	if (!InCommand.bAutoDelete)
+	{
+		return EPlasticCommandPriority::Interactive;
+	}
+	const FName OperationName = InCommand.Operation->GetName();
+	for (const FName& InteractiveOperation : InteractiveOperations)
+	{
+		if (OperationName == InteractiveOperation)
+		{
+			return EPlasticCommandPriority::Interactive;
+		}
+	}
+	return EPlasticCommandPriority::Background;
+}
+
+void FPlasticSourceControlProvider::DispatchCommands()
+{
+	if (GThreadPool == nullptr)
+	{
+		return;
+	}
+
+	// Limit the number of commands running to the number of 'cm shell' processes, since they would only wait for one of them to be available,
+	// so that the next command to run is still chosen by priority when one completes.
+	// Background commands are limited to the shared shells, so that one more slot, and the primary shell, are always left to an interactive command.
+	const int32 MaxRunningBackgroundCommands = PlasticSourceControlShell::GetShellPoolSize();
+	const int32 MaxRunningCommands = MaxRunningBackgroundCommands + 1;
+	int32 NumRunningCommands = 0;
+	int32 NumRunningBackgroundCommands = 0;
+	for (const FPlasticSourceControlCommand* Command : CommandQueue)
+	{
+		if (Command->bDispatched && !Command->bExecuteProcessed)
+		{
+			NumRunningCommands++;
+			if (Command->Priority == EPlasticCommandPriority::Background)
+			{
+				NumRunningBackgroundCommands++;
+			}
+		}
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	for (int32 PriorityIndex = 0; (PriorityIndex < static_cast<int32>(EPlasticCommandPriority::Count)) && (NumRunningCommands < MaxRunningCommands); PriorityIndex++)
+	{
+		const bool bIsBackground = (PriorityIndex == static_cast<int32>(EPlasticCommandPriority::Background));
+		TArray<FPlasticSourceControlCommand*>& Commands = PendingCommands[PriorityIndex];
+		int32 NumDispatchedCommands = 0;
+		while ((NumDispatchedCommands < Commands.Num()) && (NumRunningCommands < MaxRunningCommands)
+			&& (!bIsBackground || (NumRunningBackgroundCommands < MaxRunningBackgroundCommands)))
+		{
+			FPlasticSourceControlCommand* Command = Commands[NumDispatchedCommands++];
+			const double WaitTime = Now - Command->StartTimestamp;
+			FPlasticCommandQueueStats& Stats = CommandQueueStats[PriorityIndex];
+			Stats.NumDispatched++;
+			Stats.TotalWaitTime += WaitTime;
+			Stats.MaxWaitTime = FMath::Max(Stats.MaxWaitTime, WaitTime);
+
+			Command->bDispatched = true;
+			GThreadPool->AddQueuedWork(Command);
+			NumRunningCommands++;
+			if (bIsBackground)
+			{
+				NumRunningBackgroundCommands++;
+			}
+		}
+		Commands.RemoveAt(0, NumDispatchedCommands);
+	}
+}
+
+FPlasticCommandQueueStats FPlasticSourceControlProvider::GetCommandQueueStats(const EPlasticCommandPriority InPriority) const
+{
+	FPlasticCommandQueueStats Stats = CommandQueueStats[static_cast<int32>(InPriority)];
+	Stats.QueueDepth = PendingCommands[static_cast<int32>(InPriority)].Num();
+	return Stats;
+}
+
+void FPlasticSourceControlProvider::LogCommandQueueStats() const
+{
+	static const TCHAR* PriorityNames[] = { TEXT("Interactive"), TEXT("Background") };
+	static_assert(UE_ARRAY_COUNT(PriorityNames) == static_cast<int32>(EPlasticCommandPriority::Count), "PriorityNames must match EPlasticCommandPriority");
+
+	for (int32 PriorityIndex = 0; PriorityIndex < static_cast<int32>(EPlasticCommandPriority::Count); PriorityIndex++)
+	{
+		const FPlasticCommandQueueStats Stats = GetCommandQueueStats(static_cast<EPlasticCommandPriority>(PriorityIndex));
+		const double AverageWaitTime = (Stats.NumDispatched > 0) ? Stats.TotalWaitTime / Stats.NumDispatched : 0.0;
+		UE_LOG(LogSourceControl, Display, TEXT("%s commands: %d queued, %d dispatched, waited %.3lfs on average (max %.3lfs)"),
+			PriorityNames[PriorityIndex], Stats.QueueDepth, Stats.NumDispatched, AverageWaitTime, Stats.MaxWaitTime);
+	}
+}
+
 ECommandResult::Type FPlasticSourceControlProvider::IssueCommand(FPlasticSourceControlCommand& InCommand)
 {
 	if (GThreadPool != nullptr)
 	{
-		// Queue this to our worker thread(s) for resolving
-		GThreadPool->AddQueuedWork(&InCommand);
+		// Queue this by priority, to be dispatched to our worker thread(s) for resolving
+		InCommand.Priority = GetCommandPriority(InCommand);
 		CommandQueue.Add(&InCommand);
+		PendingCommands[static_cast<int32>(InCommand.Priority)].Add(&InCommand);
+		DispatchCommands();
 		return ECommandResult::Succeeded;
 	}
 	else
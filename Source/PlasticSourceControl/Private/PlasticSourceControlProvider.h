@@ -5,10 +5,16 @@
 #include "CoreMinimal.h"
 #include "ISourceControlProvider.h"
 #include "IPlasticSourceControlWorker.h"
+#include "PlasticSourceControlChangesetFilesCache.h"
+#include "PlasticSourceControlRevisionCache.h"
+#include "PlasticSourceControlCommand.h"
 #include "PlasticSourceControlConsole.h"
 #include "PlasticSourceControlMenu.h"
 #include "PlasticSourceControlSettings.h"
+#include "PlasticSourceControlStateCache.h"
+#include "PlasticSourceControlWorkspaceWatcher.h"
 #include "SoftwareVersion.h"
+#include "Async/Future.h"
 
 #include "Runtime/Launch/Resources/Version.h"
 
@@ -188,6 +194,9 @@ public:
 	/** Helper function used to update state cache */
 	TSharedRef<class FPlasticSourceControlState, ESPMode::ThreadSafe> GetStateInternal(const FString& InFilename);
 
+	/** Helper function used to update the state cache only for files already in it (returns null otherwise) */
+	TSharedPtr<class FPlasticSourceControlState, ESPMode::ThreadSafe> FindStateInternal(const FString& InFilename) const;
+
 #if ENGINE_MAJOR_VERSION == 5
 	/** Helper function used to update changelists state cache */
 	TSharedRef<class FPlasticSourceControlChangelistState, ESPMode::ThreadSafe> GetStateInternal(const FPlasticSourceControlChangelist& InChangelist);
@@ -202,6 +211,39 @@ public:
 	/** Remove a named file from the state cache */
 	bool RemoveFileFromCache(const FString& Filename);
 
+	/** Change the case of the filename of a state in the cache */
+	void RenameCaseInCache(const FPlasticSourceControlStateRef& InState, const FString& InFilename);
+
+	/**
+	 * Returns the states from the cache of the files in a directory and its sub-directories, based on a given predicate.
+	 * Faster than GetCachedStateByPredicate() since only the states under the directory are visited, and safe to call from any thread.
+	 */
+	TArray<FPlasticSourceControlStateRef> GetCachedStatesUnderDirectory(const FString& InDirectory, TFunctionRef<bool(const FPlasticSourceControlStateRef&)> InPredicate) const;
+
+	/** Statistics of the queue of commands of a priority, waiting to be dispatched to the worker threads */
+	FPlasticCommandQueueStats GetCommandQueueStats(const EPlasticCommandPriority InPriority) const;
+
+	/** Log the statistics of the queues of commands of each priority */
+	void LogCommandQueueStats() const;
+
+	/** The cache of the states of the files */
+	const FPlasticSourceControlStateCache& GetStateCache() const
+	{
+		return StateCache;
+	}
+
+	/** The cache of the files of the changesets, filled by the worker threads */
+	FPlasticSourceControlChangesetFilesCache& GetChangesetFilesCache()
+	{
+		return ChangesetFilesCache;
+	}
+
+	/** The cache of the contents of the revisions downloaded for diffs, shared with the other editor sessions */
+	const FPlasticSourceControlRevisionCache& GetRevisionCache() const
+	{
+		return RevisionCache;
+	}
+
 #if ENGINE_MAJOR_VERSION == 5
 	/** Remove a changelist from the state cache */
 	bool RemoveChangelistFromCache(const FPlasticSourceControlChangelist& Changelist);
@@ -220,6 +262,12 @@ public:
 		return PlasticSourceControlSettings;
 	}
 
+	/** Access the watcher of the files changed on disk in the workspace */
+	FPlasticSourceControlWorkspaceWatcher& AccessWorkspaceWatcher()
+	{
+		return WorkspaceWatcher;
+	}
+
 	/** Save the Plastic source control settings */
 	void SaveSettings()
 	{
@@ -253,12 +301,36 @@ private:
 	/** Issue a command asynchronously if possible. */
 	ECommandResult::Type IssueCommand(class FPlasticSourceControlCommand& InCommand);
 
+	/** Dispatch the queued commands to the worker threads, by priority, as long as there are less commands running than 'cm shell' processes */
+	void DispatchCommands();
+
+	/** Remove the files which status has been updated recently, within the freshness window of the project settings */
+	void RemoveRecentlyUpdatedFiles(TArray<FString>& InOutFiles) const;
+
+	/** Merge an asynchronous UpdateStatus operation into a pending one with the same options, if any has not started yet */
+	bool CoalesceUpdateStatus(const FSourceControlOperationRef& InOperation, const TArray<FString>& InFiles, const FSourceControlOperationComplete& InOperationCompleteDelegate);
+
 	/** Output any messages this command holds */
 	void OutputCommandMessages(const class FPlasticSourceControlCommand& InCommand) const;
 
 	/** Update workspace status on Connect and UpdateStatus operations */
 	void UpdateWorkspaceStatus(const class FPlasticSourceControlCommand& InCommand);
 
+	/** Run the completion delegates of the asynchronous operations completed without a command of their own (see DeferredCompletions) */
+	void ProcessDeferredCompletions();
+
+	/** Cancel the commands not dispatched yet, and run the completion delegates of the asynchronous ones, when closing the connection */
+	void CancelPendingCommands();
+
+	/** Remove the first command that completed its execution from the queue, if any */
+	class FPlasticSourceControlCommand* PopCompletedCommand();
+
+	/** Update the states from a completed command and run its completion delegate, returning true if any state was updated */
+	bool ProcessCompletedCommand(class FPlasticSourceControlCommand& InCommand);
+
+	/** Periodically refresh the cache of locks in the background, and update the states of the files for which the locks changed */
+	bool TickLocksRefresh();
+
 	/** Called after a package has been saved to disk, to update the source control cache */
 #if ENGINE_MAJOR_VERSION == 4
 	void HandlePackageSaved(const FString& InPackageFilename, UObject* Outer);
@@ -299,18 +371,39 @@ private:
 	/** Current Changeset Number */
 	int32 ChangesetNumber = 0;
 
-	/** State caches */
-	TMap<FString, TSharedRef<class FPlasticSourceControlState, ESPMode::ThreadSafe> > StateCache;
+	/** State caches (the cache of files can be read from worker threads) */
+	FPlasticSourceControlStateCache StateCache;
 #if ENGINE_MAJOR_VERSION == 5
 	TMap<FPlasticSourceControlChangelist, TSharedRef<class FPlasticSourceControlChangelistState, ESPMode::ThreadSafe> > ChangelistsStateCache;
 #endif
 
+	/** Cache of the files of the changesets (can be read and filled from worker threads) */
+	FPlasticSourceControlChangesetFilesCache ChangesetFilesCache;
+
+	/** Cache of the contents of the revisions downloaded for diffs (can be used from worker threads) */
+	FPlasticSourceControlRevisionCache RevisionCache;
+
 	/** The currently registered source control operations */
 	TMap<FName, FGetPlasticSourceControlWorker> WorkersMap;
 
 	/** Queue for commands given by the main thread */
 	TArray < FPlasticSourceControlCommand* > CommandQueue;
 
+	/** Commands waiting to be dispatched to the worker threads, by priority (a subset of the CommandQueue) */
+	TArray<FPlasticSourceControlCommand*> PendingCommands[static_cast<int32>(EPlasticCommandPriority::Count)];
+
+	/** Completion of an asynchronous operation without a command of its own (skipped, or cancelled while merged into another one), run from the next Tick() like the completion of a command */
+	struct FDeferredCompletion
+	{
+		FSourceControlOperationRef Operation;
+		FSourceControlOperationComplete OperationCompleteDelegate;
+		ECommandResult::Type Result;
+	};
+	TArray<FDeferredCompletion> DeferredCompletions;
+
+	/** Statistics of the commands dispatched, by priority */
+	FPlasticCommandQueueStats CommandQueueStats[static_cast<int32>(EPlasticCommandPriority::Count)];
+
 	/** For notifying when the source control states in the cache have changed */
 	FSourceControlStateChanged OnSourceControlStateChanged;
 
@@ -322,4 +415,16 @@ private:
 
 	/** The settings for Plastic source control */
 	FPlasticSourceControlSettings PlasticSourceControlSettings;
+
+	/** Watcher of the files changed on disk in the workspace, to restrict the status of whole directories */
+	FPlasticSourceControlWorkspaceWatcher WorkspaceWatcher;
+
+	/** Background refresh of the cache of locks, giving the server paths for which the locks changed */
+	TFuture<TArray<FString>> LocksRefresh;
+
+	/** Set to cancel the background refresh of the cache of locks, when closing the provider */
+	volatile int32 bLocksRefreshCancelled = 0;
+
+	/** Time of the last background refresh of the cache of locks */
+	double LocksRefreshTime = 0.0;
 };
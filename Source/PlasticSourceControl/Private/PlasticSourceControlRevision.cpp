@@ -1,7 +1,9 @@
 // Copyright (c) 2025 Unity Technologies
 
 #include "PlasticSourceControlRevision.h"
+#include "PlasticSourceControlEditorSettings.h"
 #include "PlasticSourceControlModule.h"
+#include "PlasticSourceControlProvider.h"
 #include "PlasticSourceControlState.h"
 #include "PlasticSourceControlUtils.h"
 
@@ -68,9 +70,21 @@ bool FPlasticSourceControlRevision::Get(FString& InOutFilename, EConcurrency::Ty
 			UE_LOG(LogSourceControl, Error, TEXT("Unknown revision for %s!"), *Filename);
 		}
 
-		if (!RevisionSpecification.IsEmpty())
+		// The same content is often downloaded again under another revision specification, or by another editor session
+		const FPlasticSourceControlRevisionCache& RevisionCache = FPlasticSourceControlModule::Get().GetProvider().GetRevisionCache();
+		const int64 RevisionCacheSizeBytes = static_cast<int64>(GetDefault<UPlasticSourceControlEditorSettings>()->RevisionCacheSizeMB) * 1024 * 1024;
+		const bool bUseRevisionCache = !Hash.IsEmpty() && (RevisionCacheSizeBytes > 0);
+		if (bUseRevisionCache && RevisionCache.Find(Hash, InOutFilename))
+		{
+			bCommandSuccessful = true;
+		}
+		else if (!RevisionSpecification.IsEmpty())
 		{
 			bCommandSuccessful = PlasticSourceControlUtils::RunGetFile(RevisionSpecification, InOutFilename);
+			if (bCommandSuccessful && bUseRevisionCache)
+			{
+				RevisionCache.Add(Hash, InOutFilename, RevisionCacheSizeBytes);
+			}
 		}
 		if (!bCommandSuccessful && FPaths::FileExists(InOutFilename))
 		{
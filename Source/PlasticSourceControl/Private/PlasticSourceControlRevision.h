@@ -80,6 +80,9 @@ public:
 
 	/** The size of the file at this revision */
 	int32 FileSize;
+
+	/** The hash of the content of the file at this revision (base64 encoded MD5, as reported by the history), empty if unknown */
+	FString Hash;
 };
 
 /** History composed of the last 100 revisions of the file */
@@ -0,0 +1,189 @@
+// Copyright (c) 2025 Unity Technologies
+
+#include "PlasticSourceControlRevisionCache.h"
+
+#include "ISourceControlModule.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Base64.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+
+// Extension of the files being written, before being moved in place
+static const TCHAR* TempFileExtension = TEXT(".tmp");
+
+// Age after which a temporary file is considered left over by a session that crashed while writing it
+static const FTimespan TempFileMaxAge = FTimespan::FromHours(1.0);
+
+// Interval after which the size of the cache is computed again from its directory, since other sessions add and evict files too
+static const double ScanInterval = 10.0 * 60.0;
+
+// Decode the base64 MD5 hash of a content, returning false if it is not a valid hash
+static bool DecodeHash(const FString& InHash, TArray<uint8>& OutHashBytes)
+{
+	return FBase64::Decode(InHash, OutHashBytes) && (OutHashBytes.Num() == 16);
+}
+
+FPlasticSourceControlRevisionCache::FPlasticSourceControlRevisionCache()
+	: CacheDir(FPaths::Combine(FPlatformProcess::UserSettingsDir(), TEXT("PlasticSourceControl"), TEXT("Revisions")))
+{
+}
+
+FPlasticSourceControlRevisionCache::FPlasticSourceControlRevisionCache(const FString& InCacheDir)
+	: CacheDir(InCacheDir)
+{
+}
+
+FString FPlasticSourceControlRevisionCache::GetCachedFilename(const FString& InHash) const
+{
+	// The base64 hash contains '/' and '+', so use its hexadecimal form as a filename, in a sub-directory by its first byte to keep directories small
+	TArray<uint8> HashBytes;
+	if (!DecodeHash(InHash, HashBytes))
+	{
+		return FString();
+	}
+	const FString HexHash = BytesToHex(HashBytes.GetData(), HashBytes.Num()).ToLower();
+	return FPaths::Combine(CacheDir, HexHash.Left(2), HexHash);
+}
+
+bool FPlasticSourceControlRevisionCache::Find(const FString& InHash, const FString& InFilename) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPlasticSourceControlRevisionCache::Find);
+
+	const FString CachedFilename = GetCachedFilename(InHash);
+	if (CachedFilename.IsEmpty() || (IFileManager::Get().FileSize(*CachedFilename) < 0))
+	{
+		return false;
+	}
+
+	// The cached file can be evicted by another session at any time: failing to copy it is a cache miss
+	if (IFileManager::Get().Copy(*InFilename, *CachedFilename, true, true) != COPY_OK)
+	{
+		IFileManager::Get().Delete(*InFilename, false, false, true);
+		return false;
+	}
+
+	IFileManager::Get().SetTimeStamp(*CachedFilename, FDateTime::UtcNow());
+	UE_LOG(LogSourceControl, Verbose, TEXT("RevisionCache: found %s for %s"), *InHash, *InFilename);
+	return true;
+}
+
+bool FPlasticSourceControlRevisionCache::Add(const FString& InHash, const FString& InFilename, const int64 InMaxSizeBytes) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPlasticSourceControlRevisionCache::Add);
+
+	const FString CachedFilename = GetCachedFilename(InHash);
+	if (CachedFilename.IsEmpty() || (InMaxSizeBytes <= 0))
+	{
+		return false;
+	}
+
+	if (IFileManager::Get().FileSize(*CachedFilename) >= 0)
+	{
+		IFileManager::Get().SetTimeStamp(*CachedFilename, FDateTime::UtcNow());
+		return true;
+	}
+
+	// Never cache a file under the hash of another content (eg a download interrupted, or a file modified meanwhile)
+	TArray<uint8> HashBytes;
+	const FMD5Hash FileHash = FMD5Hash::HashFile(*InFilename);
+	if (!DecodeHash(InHash, HashBytes) || !FileHash.IsValid() || (FMemory::Memcmp(FileHash.GetBytes(), HashBytes.GetData(), HashBytes.Num()) != 0))
+	{
+		UE_LOG(LogSourceControl, Warning, TEXT("RevisionCache: %s doesn't match its hash %s"), *InFilename, *InHash);
+		return false;
+	}
+
+	// Write to a name unique to this session and thread, then move it in place: if another session added the same content meanwhile, keep its file
+	const FString TempFilename = FString::Printf(TEXT("%s-%u-%s%s"), *CachedFilename, FPlatformProcess::GetCurrentProcessId(), *FGuid::NewGuid().ToString(), TempFileExtension);
+	bool bAdded = false;
+	if (IFileManager::Get().Copy(*TempFilename, *InFilename, true, true) == COPY_OK)
+	{
+		bAdded = IFileManager::Get().Move(*CachedFilename, *TempFilename, false, true, false, true) || (IFileManager::Get().FileSize(*CachedFilename) >= 0);
+	}
+	IFileManager::Get().Delete(*TempFilename, false, false, true);
+
+	if (bAdded)
+	{
+		UE_LOG(LogSourceControl, Verbose, TEXT("RevisionCache: added %s from %s"), *InHash, *InFilename);
+
+		// Only scan the directory of the cache if its size might exceed the limit, or if the last scan is too old
+		bool bScanRequired = true;
+		{
+			FScopeLock Lock(&CriticalSection);
+			const int64 FileSize = IFileManager::Get().FileSize(*CachedFilename);
+			if ((EstimatedSize >= 0) && (EstimatedSize + FileSize <= InMaxSizeBytes) && (FPlatformTime::Seconds() - LastScanTime < ScanInterval))
+			{
+				EstimatedSize += FMath::Max<int64>(FileSize, 0);
+				bScanRequired = false;
+			}
+		}
+		if (bScanRequired)
+		{
+			Trim(InMaxSizeBytes);
+		}
+	}
+	return bAdded;
+}
+
+int64 FPlasticSourceControlRevisionCache::Trim(const int64 InMaxSizeBytes) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPlasticSourceControlRevisionCache::Trim);
+
+	FScopeLock Lock(&CriticalSection);
+
+	struct FCachedFile
+	{
+		FString Filename;
+		FDateTime ModificationTime;
+		int64 FileSize;
+	};
+	TArray<FCachedFile> CachedFiles;
+	int64 TotalSize = 0;
+	const FDateTime Now = FDateTime::UtcNow();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.IterateDirectoryStatRecursively(*CacheDir, [&CachedFiles, &TotalSize, &Now, &PlatformFile](const TCHAR* InFilename, const FFileStatData& InStatData)
+	{
+		if (!InStatData.bIsDirectory)
+		{
+			if (FCString::Strstr(InFilename, TempFileExtension) == nullptr)
+			{
+				CachedFiles.Add({ InFilename, InStatData.ModificationTime, InStatData.FileSize });
+				TotalSize += InStatData.FileSize;
+			}
+			else if (Now - InStatData.ModificationTime > TempFileMaxAge)
+			{
+				PlatformFile.DeleteFile(InFilename);
+			}
+		}
+		return true;
+	});
+
+	if (TotalSize > InMaxSizeBytes)
+	{
+		CachedFiles.Sort([](const FCachedFile& InLhs, const FCachedFile& InRhs) { return InLhs.ModificationTime < InRhs.ModificationTime; });
+		int32 NumDeleted = 0;
+		for (const FCachedFile& CachedFile : CachedFiles)
+		{
+			if (TotalSize <= InMaxSizeBytes)
+			{
+				break;
+			}
+			// A file in use by another session can't be deleted (on Windows): keep it and evict the next one
+			if (PlatformFile.DeleteFile(*CachedFile.Filename) || !PlatformFile.FileExists(*CachedFile.Filename))
+			{
+				TotalSize -= CachedFile.FileSize;
+				NumDeleted++;
+			}
+		}
+		UE_LOG(LogSourceControl, Verbose, TEXT("RevisionCache: evicted %d files, %lld bytes left"), NumDeleted, TotalSize);
+	}
+
+	EstimatedSize = TotalSize;
+	LastScanTime = FPlatformTime::Seconds();
+
+	return TotalSize;
+}
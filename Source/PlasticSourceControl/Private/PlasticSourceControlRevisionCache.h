@@ -0,0 +1,71 @@
+// Copyright (c) 2025 Unity Technologies
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Content-addressed cache of the revisions of files downloaded for diffs, keyed by the hash of their content as reported by the history,
+ * so that the same content is only downloaded once, whatever the revision specification used to get it.
+ *
+ * The cache is a directory of files named after the hash of their content, shared by all the editor sessions of the user:
+ * - a file is written to a unique temporary name, then moved in place, so that another session never reads a partially written file,
+ * - using a file updates its modification time, and the least recently used files are deleted when the cache exceeds its size limit,
+ * - the size of the cache is estimated from the files added by this session, and only computed again from the directory above the limit,
+ *   or after a while to account for the files added or evicted by other sessions,
+ * - a file deleted by another session while being looked up is simply a cache miss.
+ *
+ * @note Thread-safe: used by the worker threads and by the game thread.
+ */
+class FPlasticSourceControlRevisionCache
+{
+public:
+	/** Use the default directory of the cache, shared by all the projects and editor sessions of the user */
+	FPlasticSourceControlRevisionCache();
+
+	explicit FPlasticSourceControlRevisionCache(const FString& InCacheDir);
+
+	/**
+	 * Copy the cached content with this hash to a file, and mark it as the most recently used.
+	 * @param	InHash		Hash of the content of the revision (base64 encoded MD5)
+	 * @param	InFilename	The file to write the content to
+	 * @returns false if the content is not in the cache (or the hash is invalid)
+	 */
+	bool Find(const FString& InHash, const FString& InFilename) const;
+
+	/**
+	 * Add the content of a downloaded revision to the cache, then evict the least recently used contents above the size limit.
+	 * @param	InHash			Hash of the content of the revision (base64 encoded MD5)
+	 * @param	InFilename		The file downloaded
+	 * @param	InMaxSizeBytes	Size limit of the cache (the cache is disabled if not positive)
+	 * @returns true if the content is in the cache, false if the file doesn't match the hash
+	 */
+	bool Add(const FString& InHash, const FString& InFilename, const int64 InMaxSizeBytes) const;
+
+	/**
+	 * Delete the least recently used contents until the total size of the cache is within the limit.
+	 * @returns the total size of the cache after eviction
+	 */
+	int64 Trim(const int64 InMaxSizeBytes) const;
+
+	/** Directory of the cache */
+	const FString& GetCacheDir() const
+	{
+		return CacheDir;
+	}
+
+private:
+	/** Path of the file caching the content with this hash, empty if the hash is invalid */
+	FString GetCachedFilename(const FString& InHash) const;
+
+	FString CacheDir;
+
+	/** Serialize the evictions of the threads of this session (other sessions can evict concurrently) */
+	mutable FCriticalSection CriticalSection;
+
+	/** Estimated total size of the cache, from its last scan and the files added since then (negative if not scanned yet) */
+	mutable int64 EstimatedSize = -1;
+
+	/** Time of the last scan of the directory of the cache */
+	mutable double LastScanTime = 0.0;
+};
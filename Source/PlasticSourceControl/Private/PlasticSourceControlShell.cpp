@@ -3,18 +3,25 @@
 #include "PlasticSourceControlShell.h"
 
 #include "Notification.h"
-#include "PlasticSourceControlModule.h"
-#include "PlasticSourceControlProvider.h"
+#include "PlasticSourceControlProjectSettings.h"
 #include "PlasticSourceControlVersions.h"
 
 #include "ISourceControlModule.h"
 
 #include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+#include "HAL/IConsoleManager.h"
 #include "HAL/PlatformProcess.h"
 #include "HAL/PlatformTime.h"
+#include "Misc/QueuedThreadPool.h"
+
+#include "Runtime/Launch/Resources/Version.h"
+
+#include <atomic>
 
 #if PLATFORM_LINUX
 #include <sys/ioctl.h>
+#include <poll.h>
 #endif
 
 #if PLATFORM_WINDOWS
@@ -30,44 +37,235 @@ namespace PlasticSourceControlShell
 {
 static const TCHAR* ShellCommandResultText = TEXT("CommandResult ");
 
-// In/Out Pipes for the 'cm shell' persistent child process
-static void*			ShellOutputPipeRead = nullptr;
-static void*			ShellOutputPipeWrite = nullptr;
-static void*			ShellErrorPipeRead = nullptr;
-static void*			ShellErrorPipeWrite = nullptr;
-static void*			ShellInputPipeRead = nullptr;
-static void*			ShellInputPipeWrite = nullptr;
-static FProcHandle		ShellProcessHandle;
-static FCriticalSection	ShellCriticalSection;
-static size_t			ShellCommandCounter = -1;
-static double			ShellCumulatedTime = 0.;
+// Maximum number of shared 'cm shell' processes in the pool (see UPlasticSourceControlProjectSettings::ShellPoolSize)
+static constexpr int32 ShellPoolMaxSize = 8;
 
-// Whether we already ran a status command to warm up the current shell process
-static bool             bShellIsWarmedUp = false;
+// One 'cm shell' persistent child process, with its own In/Out Pipes
+struct FShellProcess
+{
+	void*			OutputPipeRead = nullptr;
+	void*			OutputPipeWrite = nullptr;
+	void*			ErrorPipeRead = nullptr;
+	void*			ErrorPipeWrite = nullptr;
+	void*			InputPipeRead = nullptr;
+	void*			InputPipeWrite = nullptr;
+	FProcHandle		ProcessHandle;
+	FCriticalSection CriticalSection;	// Held while a command is running on this shell
+	size_t			CommandCounter = -1;
+	double			CumulatedTime = 0.;
+	int32			Index = 0;
+	FString			PathToPlasticBinary;	// Used to restart the shell
+	FString			WorkingDirectory;
+};
 
-// Internal function to cleanup (called under the critical section)
-static void _CleanupBackgroundCommandLineShell()
+// Pool of 'cm shell' processes: the first one is the primary shell, reserved to mutating and interactive commands,
+// so that they never wait behind long background commands, and the other ones are shared by the read-only commands
+static FShellProcess	ShellPool[ShellPoolMaxSize + 1];
+static std::atomic<int32> ShellPoolNumShells(1);
+// Read lock taken by all commands (mutating commands are serialized on the primary shell),
+// Write lock taken by Launch()/Terminate() to wait for all running commands
+static FRWLock			ShellPoolLock;
+// Round-robin index used to wait for a shared shell when none of them is idle
+static std::atomic<uint32> ShellPoolNextIndex(0);
+
+// Index of the first shell shared by the read-only commands: only the primary shell if no other one could be launched
+static int32 _GetFirstSharedShellIndex()
 {
-	FPlatformProcess::ClosePipe(ShellOutputPipeRead, ShellOutputPipeWrite);
-	FPlatformProcess::ClosePipe(ShellErrorPipeRead, ShellErrorPipeWrite);
-	FPlatformProcess::ClosePipe(ShellInputPipeRead, ShellInputPipeWrite);
-	ShellOutputPipeRead = ShellOutputPipeWrite = nullptr;
-	ShellErrorPipeRead = ShellErrorPipeWrite = nullptr;
-	ShellInputPipeRead = ShellInputPipeWrite = nullptr;
+	return (ShellPoolNumShells > 1) ? 1 : 0;
 }
 
-static bool _GetShellIsWarmedUp()
+// Whether we already ran a status command to warm up the current shell processes
+static std::atomic<bool> bShellIsWarmedUp(false);
+
+// Flag set to cancel the commands run by the current thread, if any (see FScopedCancellation)
+static thread_local const volatile int32* ThreadCancelFlag = nullptr;
+
+// Whether the commands run by the current thread can use the primary shell (see FScopedInteractivePriority)
+static thread_local bool bThreadIsInteractive = false;
+
+// Time spent by the current thread running commands in a shell (see GetThreadCommandsTime)
+static thread_local double ThreadCommandsTime = 0.0;
+
+// Histogram of the latency of the commands, per method used to wait for the output of 'cm shell'
+enum class EShellReadMethod : uint8
 {
-	return bShellIsWarmedUp;
+	SleepPolling,
+	EventDriven,
+	Count
+};
+static const TCHAR*		ShellReadMethodNames[] = { TEXT("sleep polling"), TEXT("event driven") };
+static const double		ShellLatencyBucketsMs[] = { 1., 2., 5., 10., 20., 50., 100., 200., 500., 1000., 2000., 5000., 10000. };
+static constexpr int32	ShellLatencyNumBuckets = UE_ARRAY_COUNT(ShellLatencyBucketsMs) + 1; // last bucket for all longer commands
+static uint32			ShellLatencyHistogram[(int32)EShellReadMethod::Count][ShellLatencyNumBuckets] = {};
+static FCriticalSection	ShellLatencyCriticalSection;
+
+static void AddToLatencyHistogram(const EShellReadMethod InReadMethod, const double InElapsedTime)
+{
+	const double ElapsedTimeMs = InElapsedTime * 1000.;
+	int32 Bucket = 0;
+	while ((Bucket < ShellLatencyNumBuckets - 1) && (ElapsedTimeMs > ShellLatencyBucketsMs[Bucket]))
+	{
+		Bucket++;
+	}
+
+	FScopeLock Lock(&ShellLatencyCriticalSection);
+	ShellLatencyHistogram[(int32)InReadMethod][Bucket]++;
 }
 
-static void _SetShellIsWarmedUp()
+#if PLATFORM_LINUX
+static TAutoConsoleVariable<bool> CVarShellEventDrivenReads(
+	TEXT("PlasticSCM.ShellEventDrivenReads"),
+	true,
+	TEXT("Wait for the output of 'cm shell' with poll() instead of sleeping 1ms between each read of the pipes."),
+	ECVF_Default);
+
+// Wait until the 'cm shell' outputs something on stdout or stderr, or until the timeout expires
+static void _WaitForShellOutput(const FShellProcess& InShell, const int32 InTimeoutMs)
 {
-	bShellIsWarmedUp = true;
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlShell::_WaitForShellOutput);
+
+	pollfd PollFds[2];
+	PollFds[0].fd = static_cast<const FPipeHandle*>(InShell.OutputPipeRead)->GetHandle();
+	PollFds[0].events = POLLIN;
+	PollFds[0].revents = 0;
+	PollFds[1].fd = static_cast<const FPipeHandle*>(InShell.ErrorPipeRead)->GetHandle();
+	PollFds[1].events = POLLIN;
+	PollFds[1].revents = 0;
+	poll(PollFds, UE_ARRAY_COUNT(PollFds), InTimeoutMs);
+}
+#endif
+
+/**
+ * Parse the raw UTF-8 output of 'cm shell' as it arrives, looking for the "CommandResult" line terminating the command.
+ *
+ * Only the last incomplete line is kept as bytes, complete lines are converted and appended to the results,
+ * so the terminator is searched for only once per chunk instead of rescanning the whole results each time.
+ * Alternatively, complete lines can be given as raw UTF-8 to a visitor, without any conversion.
+ */
+class FShellOutputParser
+{
+public:
+	explicit FShellOutputParser(const FUtf8LineVisitor* InUtf8LineVisitor)
+		: Utf8LineVisitor(InUtf8LineVisitor)
+	{
+	}
+
+	/**
+	 * Consume a new chunk of output.
+	 *
+	 * @param	InOutput		The raw bytes read from the stdout pipe
+	 * @param	OutResults		Complete lines are appended to the results (without the CommandResult line), unless visited
+	 * @param	OutResultCode	The result code of the command, when found
+	 * @returns true when the CommandResult line has been found, marking the end of the command
+	 */
+	bool Consume(const TArray<uint8>& InOutput, FString& OutResults, int32& OutResultCode)
+	{
+		const int32 ScanStart = PendingBytes.Num();
+		PendingBytes.Append(InOutput);
+
+		// Only complete lines are considered, to never split a multi-bytes UTF-8 character
+		int32 LastLineEnd = PendingBytes.Num() - 1;
+		while ((LastLineEnd >= ScanStart) && (PendingBytes[LastLineEnd] != '\n'))
+		{
+			LastLineEnd--;
+		}
+		if (LastLineEnd < ScanStart)
+		{
+			return false;
+		}
+
+		// Search the line containing the result code, only in the last few bytes, for approximately the last line
+		const int32 CommandResultLen = FCStringAnsi::Strlen(CommandResultText);
+		for (int32 Index = FMath::Max(0, LastLineEnd - CommandResultLen - 20); Index + CommandResultLen <= LastLineEnd; Index++)
+		{
+			if (FMemory::Memcmp(&PendingBytes[Index], CommandResultText, CommandResultLen) == 0)
+			{
+				ANSICHAR ResultCode[16] = {};
+				FMemory::Memcpy(ResultCode, &PendingBytes[Index + CommandResultLen], FMath::Min<int32>(LastLineEnd - Index - CommandResultLen, UE_ARRAY_COUNT(ResultCode) - 1));
+				OutResultCode = FCStringAnsi::Atoi(ResultCode);
+				Output(PendingBytes.GetData(), Index, OutResults);
+				PendingBytes.Reset();
+				return true;
+			}
+		}
+
+		Output(PendingBytes.GetData(), LastLineEnd + 1, OutResults);
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5
+		PendingBytes.RemoveAt(0, LastLineEnd + 1, EAllowShrinking::No);
+#else
+		PendingBytes.RemoveAt(0, LastLineEnd + 1, false);
+#endif
+		return false;
+	}
+
+	/** Append any incomplete last line to the results, e.g. before logging them */
+	void Flush(FString& OutResults)
+	{
+		Output(PendingBytes.GetData(), PendingBytes.Num(), OutResults);
+		PendingBytes.Reset();
+	}
+
+private:
+	void Output(const uint8* InBytes, const int32 InNum, FString& OutResults) const
+	{
+		if (Utf8LineVisitor)
+		{
+			VisitLines(reinterpret_cast<const ANSICHAR*>(InBytes), InNum);
+		}
+		else if (InNum > 0)
+		{
+			const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(InBytes), InNum);
+			OutResults.Append(Converted.Get(), Converted.Length());
+		}
+	}
+
+	void VisitLines(const ANSICHAR* InBytes, const int32 InNum) const
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlShell::FShellOutputParser::VisitLines);
+
+		int32 LineStart = 0;
+		while (LineStart < InNum)
+		{
+			int32 LineEnd = LineStart;
+			while ((LineEnd < InNum) && (InBytes[LineEnd] != '\n'))
+			{
+				LineEnd++;
+			}
+			int32 LineLen = LineEnd - LineStart;
+			if ((LineLen > 0) && (InBytes[LineStart + LineLen - 1] == '\r'))
+			{
+				LineLen--;
+			}
+			if (LineLen > 0) // skip empty lines
+			{
+				(*Utf8LineVisitor)(FAnsiStringView(InBytes + LineStart, LineLen));
+			}
+			LineStart = LineEnd + 1;
+		}
+	}
+
+	static constexpr const ANSICHAR* CommandResultText = "CommandResult ";
+
+	/** Optional visitor of complete lines, instead of appending them to the results */
+	const FUtf8LineVisitor* Utf8LineVisitor;
+
+	/** Bytes of the current incomplete line */
+	TArray<uint8> PendingBytes;
+};
+
+// Internal function to cleanup (called under the critical section of the shell)
+static void _CleanupBackgroundCommandLineShell(FShellProcess& InShell)
+{
+	FPlatformProcess::ClosePipe(InShell.OutputPipeRead, InShell.OutputPipeWrite);
+	FPlatformProcess::ClosePipe(InShell.ErrorPipeRead, InShell.ErrorPipeWrite);
+	FPlatformProcess::ClosePipe(InShell.InputPipeRead, InShell.InputPipeWrite);
+	InShell.OutputPipeRead = InShell.OutputPipeWrite = nullptr;
+	InShell.ErrorPipeRead = InShell.ErrorPipeWrite = nullptr;
+	InShell.InputPipeRead = InShell.InputPipeWrite = nullptr;
 }
 
-// Internal function to launch the Unity Version Control background 'cm' process in interactive shell mode (called under the critical section)
-static bool _StartBackgroundPlasticShell(const FString& InPathToPlasticBinary, const FString& InWorkingDirectory)
+// Internal function to launch the Unity Version Control background 'cm' process in interactive shell mode (called under the critical section of the shell)
+static bool _StartBackgroundPlasticShell(FShellProcess& InShell, const FString& InPathToPlasticBinary, const FString& InWorkingDirectory)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlShell::_StartBackgroundPlasticShell);
 
@@ -77,73 +275,74 @@ static bool _StartBackgroundPlasticShell(const FString& InPathToPlasticBinary, c
 	const bool bLaunchHidden = true;				// the new process will be minimized in the task bar
 	const bool bLaunchReallyHidden = bLaunchHidden; // the new process will not have a window or be in the task bar
 
-	bShellIsWarmedUp = false;
-
 	const double StartTimestamp = FPlatformTime::Seconds();
 
-	verify(FPlatformProcess::CreatePipe(ShellOutputPipeRead, ShellOutputPipeWrite, false));	// For reading outputs (stdout) from cm shell child process
-	verify(FPlatformProcess::CreatePipe(ShellErrorPipeRead, ShellErrorPipeWrite, false));	// For reading errors (stderr) from cm shell child process
-	verify(FPlatformProcess::CreatePipe(ShellInputPipeRead, ShellInputPipeWrite, true));	// For writing commands (stdin) to cm shell child process
+	InShell.PathToPlasticBinary = InPathToPlasticBinary;
+	InShell.WorkingDirectory = InWorkingDirectory;
+
+	verify(FPlatformProcess::CreatePipe(InShell.OutputPipeRead, InShell.OutputPipeWrite, false));	// For reading outputs (stdout) from cm shell child process
+	verify(FPlatformProcess::CreatePipe(InShell.ErrorPipeRead, InShell.ErrorPipeWrite, false));		// For reading errors (stderr) from cm shell child process
+	verify(FPlatformProcess::CreatePipe(InShell.InputPipeRead, InShell.InputPipeWrite, true));		// For writing commands (stdin) to cm shell child process
 
 #if !PLATFORM_LINUX // PLATFORM_WINDOWS || PLATFORM_MAC
-	ShellProcessHandle = FPlatformProcess::CreateProc(*InPathToPlasticBinary, *FullCommand, bLaunchDetached, bLaunchHidden, bLaunchReallyHidden, nullptr, 0, *InWorkingDirectory, ShellOutputPipeWrite, ShellInputPipeRead, ShellErrorPipeWrite);
+	InShell.ProcessHandle = FPlatformProcess::CreateProc(*InPathToPlasticBinary, *FullCommand, bLaunchDetached, bLaunchHidden, bLaunchReallyHidden, nullptr, 0, *InWorkingDirectory, InShell.OutputPipeWrite, InShell.InputPipeRead, InShell.ErrorPipeWrite);
 #else // PLATFORM_LINUX
 	// Update working directory
 	char OriginalWorkingDirectory[PATH_MAX];
 	getcwd(OriginalWorkingDirectory, PATH_MAX);
 	chdir(TCHAR_TO_ANSI(*InWorkingDirectory));
 
-	ShellProcessHandle = FPlatformProcess::CreateProc(*InPathToPlasticBinary, *FullCommand, bLaunchDetached, bLaunchHidden, bLaunchReallyHidden, nullptr, 0, nullptr, ShellOutputPipeWrite, ShellInputPipeRead, ShellErrorPipeWrite, ShellErrorPipeWrite);
+	InShell.ProcessHandle = FPlatformProcess::CreateProc(*InPathToPlasticBinary, *FullCommand, bLaunchDetached, bLaunchHidden, bLaunchReallyHidden, nullptr, 0, nullptr, InShell.OutputPipeWrite, InShell.InputPipeRead, InShell.ErrorPipeWrite, InShell.ErrorPipeWrite);
 
 	// Restore working directory
 	chdir(OriginalWorkingDirectory);
 #endif
 
-	if (!ShellProcessHandle.IsValid())
+	if (!InShell.ProcessHandle.IsValid())
 	{
 		UE_LOG(LogSourceControl, Warning, TEXT("Failed to launch 'cm shell'")); // not a bug, just no Unity Version Control cli found
-		_CleanupBackgroundCommandLineShell();
+		_CleanupBackgroundCommandLineShell(InShell);
 	}
 	else
 	{
 		const double ElapsedTime = (FPlatformTime::Seconds() - StartTimestamp);
-		UE_LOG(LogSourceControl, Verbose, TEXT("_StartBackgroundPlasticShell: '%s %s' ok (in %.3lfs, handle %d)"), *InPathToPlasticBinary, *FullCommand, ElapsedTime, ShellProcessHandle.Get());
-		ShellCommandCounter = 0;
-		ShellCumulatedTime = ElapsedTime;
+		UE_LOG(LogSourceControl, Verbose, TEXT("_StartBackgroundPlasticShell[%d]: '%s %s' ok (in %.3lfs, handle %d)"), InShell.Index, *InPathToPlasticBinary, *FullCommand, ElapsedTime, InShell.ProcessHandle.Get());
+		InShell.CommandCounter = 0;
+		InShell.CumulatedTime = ElapsedTime;
 	}
 
-	return ShellProcessHandle.IsValid();
+	return InShell.ProcessHandle.IsValid();
 }
 
-// Internal function (called under the critical section)
+// Internal function (called under the critical section of the shell)
 // bInForceExit: set to true to immediately force close the process without trying to "exit" and wait for it
-static void _ExitBackgroundCommandLineShell(const bool bInForceExit = false)
+static void _ExitBackgroundCommandLineShell(FShellProcess& InShell, const bool bInForceExit = false)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlShell::_ExitBackgroundCommandLineShell);
 
-	if (ShellProcessHandle.IsValid())
+	if (InShell.ProcessHandle.IsValid())
 	{
-		if (FPlatformProcess::IsProcRunning(ShellProcessHandle))
+		if (FPlatformProcess::IsProcRunning(InShell.ProcessHandle))
 		{
 			if (bInForceExit)
 			{
-				UE_LOG(LogSourceControl, Verbose, TEXT("_ExitBackgroundCommandLineShell: TerminateProc"));
-				FPlatformProcess::TerminateProc(ShellProcessHandle);
+				UE_LOG(LogSourceControl, Verbose, TEXT("_ExitBackgroundCommandLineShell[%d]: TerminateProc"), InShell.Index);
+				FPlatformProcess::TerminateProc(InShell.ProcessHandle);
 			}
 			else
 			{
 				// Tell the 'cm shell' to exit
-				UE_LOG(LogSourceControl, Verbose, TEXT("_ExitBackgroundCommandLineShell: exit..."));
-				FPlatformProcess::WritePipe(ShellInputPipeWrite, TEXT("exit"));
+				UE_LOG(LogSourceControl, Verbose, TEXT("_ExitBackgroundCommandLineShell[%d]: exit..."), InShell.Index);
+				FPlatformProcess::WritePipe(InShell.InputPipeWrite, TEXT("exit"));
 				// And wait up to one second for its termination
 				const double Timeout = 1.0;
 				const double StartTimestamp = FPlatformTime::Seconds();
-				while (FPlatformProcess::IsProcRunning(ShellProcessHandle))
+				while (FPlatformProcess::IsProcRunning(InShell.ProcessHandle))
 				{
 					if ((FPlatformTime::Seconds() - StartTimestamp) > Timeout)
 					{
-						UE_LOG(LogSourceControl, Warning, TEXT("_ExitBackgroundCommandLineShell: cm shell didn't stop gracefully in %lfs."), Timeout);
-						FPlatformProcess::TerminateProc(ShellProcessHandle);
+						UE_LOG(LogSourceControl, Warning, TEXT("_ExitBackgroundCommandLineShell[%d]: cm shell didn't stop gracefully in %lfs."), InShell.Index, Timeout);
+						FPlatformProcess::TerminateProc(InShell.ProcessHandle);
 						break;
 					}
 					FPlatformProcess::Sleep(0.01f);
@@ -152,39 +351,121 @@ static void _ExitBackgroundCommandLineShell(const bool bInForceExit = false)
 		}
 		else
 		{
-			UE_LOG(LogSourceControl, Verbose, TEXT("_ExitBackgroundCommandLineShell: 'cm shell' already stopped"));
+			UE_LOG(LogSourceControl, Verbose, TEXT("_ExitBackgroundCommandLineShell[%d]: 'cm shell' already stopped"), InShell.Index);
 		}
-		FPlatformProcess::CloseProc(ShellProcessHandle);
-		_CleanupBackgroundCommandLineShell();
+		FPlatformProcess::CloseProc(InShell.ProcessHandle);
+		_CleanupBackgroundCommandLineShell(InShell);
 	}
 }
 
-// Internal function (called under the critical section)
+// Internal function (called under the critical section of the shell)
 // bInForceExit: set to true to immediately force close the process without trying to "exit" and wait for it
-static void _RestartBackgroundCommandLineShell(const bool bInForceExit = false)
+static void _RestartBackgroundCommandLineShell(FShellProcess& InShell, const bool bInForceExit = false)
 {
-	const FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
-	const FString& PathToPlasticBinary = Provider.AccessSettings().GetBinaryPath();
-	const FString& WorkingDirectory = Provider.GetPathToWorkspaceRoot();
+	// Copy the parameters the shell was launched with, since they are set again when starting it
+	const FString PathToPlasticBinary = InShell.PathToPlasticBinary;
+	const FString WorkingDirectory = InShell.WorkingDirectory;
 
-	_ExitBackgroundCommandLineShell(bInForceExit);
-	_StartBackgroundPlasticShell(PathToPlasticBinary, WorkingDirectory);
+	_ExitBackgroundCommandLineShell(InShell, bInForceExit);
+	_StartBackgroundPlasticShell(InShell, PathToPlasticBinary, WorkingDirectory);
 }
 
-// Internal function (called under the critical section)
-static bool _RunCommandInternal(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, FString& OutResults, FString& OutErrors)
+// Internal function to exit all the shells of the pool (called under the write lock of the pool)
+static void _ExitAllBackgroundCommandLineShells()
+{
+	for (int32 Index = 0; Index < ShellPoolNumShells; Index++)
+	{
+		FScopeLock Lock(&ShellPool[Index].CriticalSection);
+		_ExitBackgroundCommandLineShell(ShellPool[Index]);
+	}
+}
+
+// Whether the command only reads information, so that it can run concurrently to other read-only commands on any idle shell of the pool.
+// Anything not listed here is considered to mutate the workspace or the repository, and is run exclusively on the primary shell.
+static bool IsReadOnlyCommand(const FString& InCommand, const TArray<FString>& InParameters)
+{
+	static const TCHAR* ReadOnlyCommands[] = {
+		TEXT("status"), TEXT("fileinfo"), TEXT("history"), TEXT("find"), TEXT("log"), TEXT("diff"), TEXT("getfile"),
+		TEXT("version"), TEXT("location"), TEXT("workspaceinfo"), TEXT("getworkspacefrompath"), TEXT("getconfig"), TEXT("checkconnection")
+	};
+	for (const TCHAR* ReadOnlyCommand : ReadOnlyCommands)
+	{
+		if (InCommand.Equals(ReadOnlyCommand))
+		{
+			return true;
+		}
+	}
+
+	// Commands with a "list" subcommand, like "lock list", "profile list" or "repository list"
+	if (InCommand.Equals(TEXT("lock")) || InCommand.Equals(TEXT("profile")) || InCommand.Equals(TEXT("repository")))
+	{
+		return (InParameters.Num() > 0) && InParameters[0].Equals(TEXT("list"));
+	}
+
+	return false;
+}
+
+// Internal function visiting the complete lines received so far, removing them from the results (called under the critical section of the shell)
+// bInLastLine: also visit the remaining incomplete line, at the end of the command
+// returns the number of characters removed from the results
+static int32 _VisitResultLines(FString& InOutResults, const bool bInLastLine, const FLineVisitor& InLineVisitor)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlShell::_VisitResultLines);
+
+	const int32 DelimLen = FCString::Strlen(pchDelim);
+	int32 LineStart = 0;
+	while (LineStart < InOutResults.Len())
+	{
+		const int32 LineEnd = InOutResults.Find(pchDelim, ESearchCase::CaseSensitive, ESearchDir::FromStart, LineStart);
+		if (LineEnd == INDEX_NONE)
+		{
+			break;
+		}
+		if (LineEnd > LineStart) // skip empty lines
+		{
+			InLineVisitor(InOutResults.Mid(LineStart, LineEnd - LineStart));
+		}
+		LineStart = LineEnd + DelimLen;
+	}
+	if (bInLastLine && (LineStart < InOutResults.Len()))
+	{
+		InLineVisitor(InOutResults.Mid(LineStart));
+		LineStart = InOutResults.Len();
+	}
+
+	const int32 NumRemoved = FMath::Min(LineStart, InOutResults.Len());
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5
+	InOutResults.RemoveAt(0, NumRemoved, EAllowShrinking::No);
+#else
+	InOutResults.RemoveAt(0, NumRemoved, false);
+#endif
+	return NumRemoved;
+}
+
+// Internal function (called under the critical section of the shell)
+// InLineVisitor: optional visitor called on each line of output as soon as it is received, instead of accumulating them in OutResults
+// InUtf8LineVisitor: optional visitor called on each line of output as raw UTF-8 bytes, without any conversion
+static bool _RunCommandInternal(FShellProcess& InShell, const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, const FLineVisitor* InLineVisitor, const FUtf8LineVisitor* InUtf8LineVisitor, FString& OutResults, FString& OutErrors)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlShell::_RunCommandInternal);
 
 	bool bResult = false;
 
-	ShellCommandCounter++;
+	// Don't even start a command cancelled while it was waiting for a shell
+	if (IsCancelRequested())
+	{
+		UE_LOG(LogSourceControl, Log, TEXT("RunCommand: '%s' cancelled"), *InCommand);
+		OutErrors = TEXT("Cancelled");
+		return false;
+	}
+
+	InShell.CommandCounter++;
 
 	// Detect previous crash of cm.exe and restart 'cm shell'
-	if (!FPlatformProcess::IsProcRunning(ShellProcessHandle))
+	if (!FPlatformProcess::IsProcRunning(InShell.ProcessHandle))
 	{
-		UE_LOG(LogSourceControl, Warning, TEXT("RunCommand: 'cm shell' has stopped. Restarting!"));
-		_RestartBackgroundCommandLineShell();
+		UE_LOG(LogSourceControl, Warning, TEXT("RunCommand: 'cm shell' [%d] has stopped. Restarting!"), InShell.Index);
+		_RestartBackgroundCommandLineShell(InShell);
 	}
 
 	// Start with the command itself ("status", "log", "checkin"...)
@@ -202,14 +483,14 @@ static bool _RunCommandInternal(const FString& InCommand, const TArray<FString>&
 		FullCommand += TEXT("\"");
 	}
 	const FString LoggableCommand = FullCommand.Left(256); // Limit command log size to 256 characters
-	UE_LOG(LogSourceControl, Verbose, TEXT("RunCommand: '%s' (%d chars, %d files)"), *LoggableCommand, FullCommand.Len()+1, InFiles.Num());
+	UE_LOG(LogSourceControl, Verbose, TEXT("RunCommand[%d]: '%s' (%d chars, %d files)"), InShell.Index, *LoggableCommand, FullCommand.Len()+1, InFiles.Num());
 	FullCommand += TEXT('\n'); // Finalize the command line
 
 	// Send command to 'cm shell' process in UTF-8
 	// NOTE: this explicit conversion to UTF-8 shouldn't be needed since FPlatformProcess::WritePipe() says it does it, but reading the implementation for Windows Platform show it merily truncates 16bits to 8bits chars!
 	// NOTE: on the other hand, ReadPipe() does the conversion from UTF-8 correctly already!
 	const FTCHARToUTF8 FullCommandUtf8(*FullCommand);
-	const bool bWriteOk = FPlatformProcess::WritePipe(ShellInputPipeWrite, reinterpret_cast<const uint8*>(FullCommandUtf8.Get()), FullCommandUtf8.Length());
+	const bool bWriteOk = FPlatformProcess::WritePipe(InShell.InputPipeWrite, reinterpret_cast<const uint8*>(FullCommandUtf8.Get()), FullCommandUtf8.Length());
 
 	// And wait up to 180.0 seconds for any kind of output from cm shell: in case of lengthier operation, intermediate output (like percentage of progress) is expected, which would refresh the timeout
 	static const double Timeout = 180.0;
@@ -218,66 +499,137 @@ static bool _RunCommandInternal(const FString& InCommand, const TArray<FString>&
 	double LastLog = StartTimestamp;
 	static const double LogInterval = 10.0; // log interval for long running operation
 	int32 PreviousLogLen = 0;
-	while (FPlatformProcess::IsProcRunning(ShellProcessHandle))
+#if PLATFORM_LINUX
+	const EShellReadMethod ReadMethod = CVarShellEventDrivenReads.GetValueOnAnyThread() ? EShellReadMethod::EventDriven : EShellReadMethod::SleepPolling;
+#else
+	const EShellReadMethod ReadMethod = EShellReadMethod::SleepPolling;
+#endif
+	// Raw UTF-8 output is read whenever waiting for output events, or when required by the visitor
+	const bool bReadRawOutput = (ReadMethod == EShellReadMethod::EventDriven) || (InUtf8LineVisitor != nullptr);
+	FShellOutputParser OutputParser(InUtf8LineVisitor);
+	while (FPlatformProcess::IsProcRunning(InShell.ProcessHandle))
 	{
-		FString Errors = FPlatformProcess::ReadPipe(ShellErrorPipeRead);
+		if (IsCancelRequested())
+		{
+			// In case of cancellation, discard the partial output, and force the 'cm shell' process, still busy with the command, to restart
+			// (the other shells of the pool are not affected)
+			UE_LOG(LogSourceControl, Warning, TEXT("RunCommand: '%s' CANCELLED after %.3lfs output (%d chars)"), *LoggableCommand, (FPlatformTime::Seconds() - StartTimestamp), OutResults.Len());
+			_RestartBackgroundCommandLineShell(InShell, true);
+			OutResults.Empty();
+			OutErrors = TEXT("Cancelled");
+			return false;
+		}
+
+		bool bHasOutput = false;
+#if PLATFORM_LINUX
+		if (ReadMethod == EShellReadMethod::EventDriven)
+		{
+			// Block until 'cm shell' outputs something, waking up regularly to check for long running operation, timeout and Engine exit
+			_WaitForShellOutput(InShell, 100);
+		}
+#endif
+		FString Errors = FPlatformProcess::ReadPipe(InShell.ErrorPipeRead);
 		if (!Errors.IsEmpty())
 		{
 			OutErrors.Append(Errors);
 		}
-		FString Output = FPlatformProcess::ReadPipe(ShellOutputPipeRead);
-		if (!Output.IsEmpty())
+		if (bReadRawOutput)
 		{
-			TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlShell::_RunCommandInternal::ParseOutput);
-
-			LastActivity = FPlatformTime::Seconds(); // freshen the timestamp while cm is still actively outputting information
-			OutResults.Append(MoveTemp(Output));
-			// Search the output for the line containing the result code, also indicating the end of the command (only search in the last few characters, for approximately the last line)
-			const uint32 IndexCommandResult = OutResults.Find(ShellCommandResultText, ESearchCase::CaseSensitive, ESearchDir::FromStart, OutResults.Len() - 20);
-			if (INDEX_NONE != IndexCommandResult)
+			TArray<uint8> Output;
+			if (FPlatformProcess::ReadPipeToArray(InShell.OutputPipeRead, Output) && (Output.Num() > 0))
 			{
-				const uint32 IndexEndResult = OutResults.Find(pchDelim, ESearchCase::CaseSensitive, ESearchDir::FromStart, IndexCommandResult + 14);
-				if (INDEX_NONE != IndexEndResult)
+				TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlShell::_RunCommandInternal::ParseOutput);
+
+				bHasOutput = true;
+				LastActivity = FPlatformTime::Seconds(); // freshen the timestamp while cm is still actively outputting information
+				int32 ResultCode = 0;
+				if (OutputParser.Consume(Output, OutResults, ResultCode))
 				{
-					const FString Result = OutResults.Mid(IndexCommandResult + 14, IndexEndResult - IndexCommandResult - 14);
-					const int32 ResultCode = FCString::Atoi(*Result);
 					bResult = (ResultCode == 0);
-					// remove the CommandResult line from the OutResults
-					OutResults.RemoveAt(IndexCommandResult, OutResults.Len() - IndexCommandResult);
 					break;
 				}
+				if (InLineVisitor)
+				{
+					PreviousLogLen = FMath::Max(0, PreviousLogLen - _VisitResultLines(OutResults, false, *InLineVisitor));
+				}
 			}
 		}
-		else if ((FPlatformTime::Seconds() - LastLog > LogInterval) && (PreviousLogLen < OutResults.Len()))
+		else
 		{
-			// In case of long running operation, start to print intermediate output from cm shell (like percentage of progress)
-			UE_LOG(LogSourceControl, Log, TEXT("RunCommand: '%s' in progress for %.3lfs... (%d chars):\n%s"), *InCommand, (FPlatformTime::Seconds() - StartTimestamp), OutResults.Len() - PreviousLogLen, *OutResults.Mid(PreviousLogLen, 4096)); // Limit result size to 4096 characters
-			PreviousLogLen = OutResults.Len();
-			LastLog = FPlatformTime::Seconds(); // freshen the timestamp of last log
+			FString Output = FPlatformProcess::ReadPipe(InShell.OutputPipeRead);
+			if (!Output.IsEmpty())
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlShell::_RunCommandInternal::ParseOutput);
+
+				bHasOutput = true;
+				LastActivity = FPlatformTime::Seconds(); // freshen the timestamp while cm is still actively outputting information
+				OutResults.Append(MoveTemp(Output));
+				// Search the output for the line containing the result code, also indicating the end of the command (only search in the last few characters, for approximately the last line)
+				const uint32 IndexCommandResult = OutResults.Find(ShellCommandResultText, ESearchCase::CaseSensitive, ESearchDir::FromStart, OutResults.Len() - 20);
+				if (INDEX_NONE != IndexCommandResult)
+				{
+					const uint32 IndexEndResult = OutResults.Find(pchDelim, ESearchCase::CaseSensitive, ESearchDir::FromStart, IndexCommandResult + 14);
+					if (INDEX_NONE != IndexEndResult)
+					{
+						const FString Result = OutResults.Mid(IndexCommandResult + 14, IndexEndResult - IndexCommandResult - 14);
+						const int32 ResultCode = FCString::Atoi(*Result);
+						bResult = (ResultCode == 0);
+						// remove the CommandResult line from the OutResults
+						OutResults.RemoveAt(IndexCommandResult, OutResults.Len() - IndexCommandResult);
+						break;
+					}
+				}
+				if (InLineVisitor)
+				{
+					PreviousLogLen = FMath::Max(0, PreviousLogLen - _VisitResultLines(OutResults, false, *InLineVisitor));
+				}
+			}
 		}
-		else if (FPlatformTime::Seconds() - LastActivity > Timeout)
+
+		if (!bHasOutput)
 		{
-			// In case of timeout, ask the blocking 'cm shell' process to exit, detach from it and restart it immediately
-			UE_LOG(LogSourceControl, Error, TEXT("RunCommand: '%s' TIMEOUT after %.3lfs output (%d chars):\n%s"), *InCommand, (FPlatformTime::Seconds() - StartTimestamp), OutResults.Len(), *OutResults.Mid(PreviousLogLen, 4096)); // Limit result size to 4096 characters
-			_RestartBackgroundCommandLineShell(true);
-			// Return output results as error so they get propagated to the Message Log window
-			OutErrors = MoveTemp(OutResults);
-			return false;
+			if ((FPlatformTime::Seconds() - LastLog > LogInterval) && (PreviousLogLen < OutResults.Len()))
+			{
+				// In case of long running operation, start to print intermediate output from cm shell (like percentage of progress)
+				UE_LOG(LogSourceControl, Log, TEXT("RunCommand: '%s' in progress for %.3lfs... (%d chars):\n%s"), *InCommand, (FPlatformTime::Seconds() - StartTimestamp), OutResults.Len() - PreviousLogLen, *OutResults.Mid(PreviousLogLen, 4096)); // Limit result size to 4096 characters
+				PreviousLogLen = OutResults.Len();
+				LastLog = FPlatformTime::Seconds(); // freshen the timestamp of last log
+			}
+			else if (FPlatformTime::Seconds() - LastActivity > Timeout)
+			{
+				// In case of timeout, ask the blocking 'cm shell' process to exit, detach from it and restart it immediately
+				OutputParser.Flush(OutResults);
+				UE_LOG(LogSourceControl, Error, TEXT("RunCommand: '%s' TIMEOUT after %.3lfs output (%d chars):\n%s"), *InCommand, (FPlatformTime::Seconds() - StartTimestamp), OutResults.Len(), *OutResults.Mid(PreviousLogLen, 4096)); // Limit result size to 4096 characters
+				_RestartBackgroundCommandLineShell(InShell, true);
+				// Return output results as error so they get propagated to the Message Log window
+				OutErrors = MoveTemp(OutResults);
+				return false;
+			}
+			else if (IsEngineExitRequested())
+			{
+				UE_LOG(LogSourceControl, Warning, TEXT("RunCommand: '%s' Engine Exit was requested after %.3lfs output (%d chars):\n%s"), *InCommand, (FPlatformTime::Seconds() - StartTimestamp), OutResults.Len() - PreviousLogLen, *OutResults.Mid(PreviousLogLen, 4096)); // Limit result size to 4096 characters
+				_ExitBackgroundCommandLineShell(InShell);
+			}
 		}
-		else if (IsEngineExitRequested())
+
+		if (ReadMethod == EShellReadMethod::SleepPolling)
 		{
-			UE_LOG(LogSourceControl, Warning, TEXT("RunCommand: '%s' Engine Exit was requested after %.3lfs output (%d chars):\n%s"), *InCommand, (FPlatformTime::Seconds() - StartTimestamp), OutResults.Len() - PreviousLogLen, *OutResults.Mid(PreviousLogLen, 4096)); // Limit result size to 4096 characters
-			_ExitBackgroundCommandLineShell();
+			TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlShell::_RunCommandInternal::Sleep);
+			FPlatformProcess::Sleep(0.001f);
 		}
-
-		TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlShell::_RunCommandInternal::Sleep);
-		FPlatformProcess::Sleep(0.001f);
+	}
+	OutputParser.Flush(OutResults); // in case 'cm shell' stopped in the middle of a line
+	if (InLineVisitor)
+	{
+		PreviousLogLen = FMath::Max(0, PreviousLogLen - _VisitResultLines(OutResults, true, *InLineVisitor));
 	}
 	const double ElapsedTime = (FPlatformTime::Seconds() - StartTimestamp);
+	AddToLatencyHistogram(ReadMethod, ElapsedTime);
+	ThreadCommandsTime += ElapsedTime;
 
 	if (!InCommand.Equals(TEXT("exit")))
 	{
-		if (!FPlatformProcess::IsProcRunning(ShellProcessHandle))
+		if (!FPlatformProcess::IsProcRunning(InShell.ProcessHandle))
 		{
 			// 'cm shell' normally only terminates in case of 'exit' command. Will restart on next command.
 			UE_LOG(LogSourceControl, Error, TEXT("RunCommand: '%s' 'cm shell' stopped after %.3lfs output (%d chars):\n%s"), *LoggableCommand, ElapsedTime, OutResults.Len(), *OutResults.Left(200)); // Limit long running intermediate log to 200 characters
@@ -312,59 +664,437 @@ static bool _RunCommandInternal(const FString& InCommand, const TArray<FString>&
 		bResult = false;
 	}
 	// Return output as error if result code is an error (for backward compatibility with old cm versions pre 8044)
-	else if (!bResult)
+	// (when streaming the output, the lines already visited are returned as errors by PlasticSourceControlUtils instead)
+	else if (!bResult && !InLineVisitor)
 	{
 		OutErrors = MoveTemp(OutResults);
 	}
 
-	ShellCumulatedTime += ElapsedTime;
-	UE_LOG(LogSourceControl, Verbose, TEXT("RunCommand: cumulated time spent in shell: %.3lfs (count %d)"), ShellCumulatedTime, ShellCommandCounter);
+	InShell.CumulatedTime += ElapsedTime;
+	UE_LOG(LogSourceControl, Verbose, TEXT("RunCommand: cumulated time spent in shell [%d]: %.3lfs (count %d)"), InShell.Index, InShell.CumulatedTime, InShell.CommandCounter);
 
 	return bResult;
 }
 
-// Launch the Unity Version Control 'cm shell' process in background for optimized successive commands (thread-safe)
-bool Launch(const FString& InPathToPlasticBinary, const FString& InWorkingDirectory)
+static void _ResizeCommandThreadPool();
+
+// Internal function launching the pool of 'cm shell' processes
+static bool _LaunchShells(const FString& InPathToPlasticBinary, const FString& InWorkingDirectory)
 {
 	// Protect public APIs from multi-thread access
-	FScopeLock Lock(&ShellCriticalSection);
+	FRWScopeLock PoolLock(ShellPoolLock, SLT_Write);
+
+	// terminate previous shells if some are already running
+	_ExitAllBackgroundCommandLineShells();
+
+	bShellIsWarmedUp = false;
+	// The primary shell comes in addition to the shared ones
+	ShellPoolNumShells = FMath::Clamp(GetDefault<UPlasticSourceControlProjectSettings>()->ShellPoolSize, 1, ShellPoolMaxSize) + 1;
 
-	// terminate previous shell if one is already running
-	_ExitBackgroundCommandLineShell();
+	// Start the primary shell first, and only launch the other ones if it succeeded (else there is no Unity Version Control cli found)
+	for (int32 Index = 0; Index < ShellPoolNumShells; Index++)
+	{
+		FShellProcess& Shell = ShellPool[Index];
+		FScopeLock Lock(&Shell.CriticalSection);
+		Shell.Index = Index;
+		if (!_StartBackgroundPlasticShell(Shell, InPathToPlasticBinary, InWorkingDirectory))
+		{
+			// Shrink the pool to the shells that could be launched (the primary shell being then shared if it is the only one)
+			ShellPoolNumShells = FMath::Max(Index, 1);
+			return (Index > 0);
+		}
+	}
 
-	return _StartBackgroundPlasticShell(InPathToPlasticBinary, InWorkingDirectory);
+	return true;
 }
 
-// Terminate the background 'cm shell' process and associated pipes (thread-safe)
+// Launch the pool of Unity Version Control 'cm shell' processes in background for optimized successive commands (thread-safe)
+bool Launch(const FString& InPathToPlasticBinary, const FString& InWorkingDirectory)
+{
+	const bool bLaunched = _LaunchShells(InPathToPlasticBinary, InWorkingDirectory);
+
+	// Size the pool of threads to the new pool of shells, once the shells are unlocked, since it waits for the tasks running commands
+	_ResizeCommandThreadPool();
+
+	return bLaunched;
+}
+
+// Terminate the background 'cm shell' processes and associated pipes (thread-safe)
 void Terminate()
 {
 	// Protect public APIs from multi-thread access
-	FScopeLock Lock(&ShellCriticalSection);
+	FRWScopeLock PoolLock(ShellPoolLock, SLT_Write);
 
-	_ExitBackgroundCommandLineShell();
+	_ExitAllBackgroundCommandLineShells();
 }
 
-void SetShellIsWarmedUp()
+FDedicatedShell::FDedicatedShell()
+	: Shell(MakeUnique<FShellProcess>())
+{
+	Shell->Index = -1;
+}
+
+FDedicatedShell::~FDedicatedShell()
 {
-	FScopeLock Lock(&ShellCriticalSection);
+	Terminate();
+}
+
+bool FDedicatedShell::Launch(const FString& InPathToPlasticBinary, const FString& InWorkingDirectory)
+{
+	FScopeLock Lock(&Shell->CriticalSection);
+	_ExitBackgroundCommandLineShell(*Shell);
+	return _StartBackgroundPlasticShell(*Shell, InPathToPlasticBinary, InWorkingDirectory);
+}
+
+void FDedicatedShell::Terminate()
+{
+	FScopeLock Lock(&Shell->CriticalSection);
+	_ExitBackgroundCommandLineShell(*Shell);
+}
+
+bool FDedicatedShell::RunCommand(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, FString& OutResults, FString& OutErrors)
+{
+	FScopeLock Lock(&Shell->CriticalSection);
+	return _RunCommandInternal(*Shell, InCommand, InParameters, InFiles, nullptr, nullptr, OutResults, OutErrors);
+}
+
+FScopedCancellation::FScopedCancellation(const volatile int32* InCancelFlag)
+	: PreviousCancelFlag(ThreadCancelFlag)
+{
+	ThreadCancelFlag = InCancelFlag;
+}
+
+FScopedCancellation::~FScopedCancellation()
+{
+	ThreadCancelFlag = PreviousCancelFlag;
+}
+
+bool IsCancelRequested()
+{
+	return (ThreadCancelFlag != nullptr) && (FPlatformAtomics::AtomicRead(ThreadCancelFlag) != 0);
+}
+
+FScopedInteractivePriority::FScopedInteractivePriority(const bool bInIsInteractive)
+	: bPreviousIsInteractive(bThreadIsInteractive)
+{
+	bThreadIsInteractive = bInIsInteractive;
+}
+
+FScopedInteractivePriority::~FScopedInteractivePriority()
+{
+	bThreadIsInteractive = bPreviousIsInteractive;
+}
 
-	_SetShellIsWarmedUp();
+void SetShellIsWarmedUp()
+{
+	bShellIsWarmedUp = true;
 }
 
 bool GetShellIsWarmedUp()
 {
-	FScopeLock Lock(&ShellCriticalSection);
+	return bShellIsWarmedUp;
+}
+
+void LogLatencyHistogram()
+{
+	FScopeLock Lock(&ShellLatencyCriticalSection);
+
+	for (int32 Method = 0; Method < (int32)EShellReadMethod::Count; Method++)
+	{
+		uint32 Total = 0;
+		for (int32 Bucket = 0; Bucket < ShellLatencyNumBuckets; Bucket++)
+		{
+			Total += ShellLatencyHistogram[Method][Bucket];
+		}
+		if (Total == 0)
+		{
+			continue;
+		}
+
+		UE_LOG(LogSourceControl, Display, TEXT("Latency of %u commands (%s):"), Total, ShellReadMethodNames[Method]);
+		for (int32 Bucket = 0; Bucket < ShellLatencyNumBuckets; Bucket++)
+		{
+			const uint32 Count = ShellLatencyHistogram[Method][Bucket];
+			if (Bucket < ShellLatencyNumBuckets - 1)
+			{
+				UE_LOG(LogSourceControl, Display, TEXT("  <= %5.0lfms: %6u (%5.1lf%%)"), ShellLatencyBucketsMs[Bucket], Count, 100. * Count / Total);
+			}
+			else
+			{
+				UE_LOG(LogSourceControl, Display, TEXT("  >  %5.0lfms: %6u (%5.1lf%%)"), ShellLatencyBucketsMs[Bucket - 1], Count, 100. * Count / Total);
+			}
+		}
+	}
+}
+
+int32 GetShellPoolSize()
+{
+	return ShellPoolNumShells - _GetFirstSharedShellIndex();
+}
+
+double GetThreadCommandsTime()
+{
+	return ThreadCommandsTime;
+}
+
+// Dedicated pool of threads running blocking commands, created on first use and sized to the pool of shells,
+// then rebuilt by Launch() if the size of the pool of shells changed (see _ResizeCommandThreadPool)
+static FQueuedThreadPool* CommandThreadPool = nullptr;
+static int32 CommandThreadPoolNumThreads = 0;
+static bool bCommandThreadPoolShutdown = false;
+static FCriticalSection CommandThreadPoolCriticalSection;
+
+// Internal function returning the pool of threads, created on first use, or nullptr after its shutdown (called under CommandThreadPoolCriticalSection)
+static FQueuedThreadPool* _GetCommandThreadPool()
+{
+	if ((CommandThreadPool == nullptr) && !bCommandThreadPoolShutdown)
+	{
+		CommandThreadPoolNumThreads = GetShellPoolSize();
+		CommandThreadPool = FQueuedThreadPool::Allocate();
+		verify(CommandThreadPool->Create(CommandThreadPoolNumThreads, 256 * 1024, TPri_Normal, TEXT("PlasticSourceControlCommandThreadPool")));
+		UE_LOG(LogSourceControl, Verbose, TEXT("CommandThreadPool: %d threads"), CommandThreadPoolNumThreads);
+	}
+	return CommandThreadPool;
+}
+
+// Internal function destroying a pool of threads detached from CommandThreadPool, out of the critical section,
+// since it waits for the running tasks, that can start other tasks
+static void _DestroyCommandThreadPool(FQueuedThreadPool* InPool)
+{
+	if (InPool != nullptr)
+	{
+		// Tasks not started yet are abandoned, and run by the thread waiting for them
+		InPool->Destroy();
+		delete InPool;
+	}
+}
+
+// Internal function destroying the pool of threads if its size doesn't match the pool of shells anymore, to create it again on next use
+static void _ResizeCommandThreadPool()
+{
+	FQueuedThreadPool* PreviousPool = nullptr;
+	{
+		FScopeLock Lock(&CommandThreadPoolCriticalSection);
+		if ((CommandThreadPool != nullptr) && (CommandThreadPoolNumThreads != GetShellPoolSize()))
+		{
+			UE_LOG(LogSourceControl, Verbose, TEXT("CommandThreadPool: resize from %d to %d threads"), CommandThreadPoolNumThreads, GetShellPoolSize());
+			PreviousPool = CommandThreadPool;
+			CommandThreadPool = nullptr;
+		}
+	}
+	_DestroyCommandThreadPool(PreviousPool);
+}
 
-	return _GetShellIsWarmedUp();
+void ShutdownCommandThreadPool()
+{
+	FQueuedThreadPool* PreviousPool = nullptr;
+	{
+		FScopeLock Lock(&CommandThreadPoolCriticalSection);
+		// Any task started from now on is run by the thread starting it
+		bCommandThreadPoolShutdown = true;
+		PreviousPool = CommandThreadPool;
+		CommandThreadPool = nullptr;
+	}
+	_DestroyCommandThreadPool(PreviousPool);
+}
+
+class FCommandTask::FQueuedWork : public IQueuedWork
+{
+public:
+	explicit FQueuedWork(TFunction<void()>&& InFunction)
+		: Function(MoveTemp(InFunction))
+		, DoneEvent(FPlatformProcess::GetSynchEventFromPool(true))
+	{
+	}
+
+	virtual ~FQueuedWork()
+	{
+		FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+	}
+
+	virtual void DoThreadedWork() override
+	{
+		Function();
+		DoneEvent->Trigger();
+	}
+
+	virtual void Abandon() override
+	{
+		bAbandoned = true;
+		DoneEvent->Trigger();
+	}
+
+	void Start()
+	{
+		{
+			FScopeLock Lock(&CommandThreadPoolCriticalSection);
+			Pool = _GetCommandThreadPool();
+			if (Pool != nullptr)
+			{
+				Pool->AddQueuedWork(this);
+				return;
+			}
+		}
+
+		// After the shutdown of the pool, the task is run by the thread starting it
+		DoThreadedWork();
+	}
+
+	void Wait()
+	{
+		if (bWaited)
+		{
+			return;
+		}
+		bWaited = true;
+
+		// A pool that has been resized or shut down meanwhile has already run or abandoned the task
+		bool bRetracted = false;
+		{
+			FScopeLock Lock(&CommandThreadPoolCriticalSection);
+			bRetracted = (Pool != nullptr) && (Pool == CommandThreadPool) && Pool->RetractQueuedWork(this);
+		}
+		if (bRetracted)
+		{
+			Function();
+			return;
+		}
+		DoneEvent->Wait();
+		if (bAbandoned)
+		{
+			Function();
+		}
+	}
+
+private:
+	TFunction<void()> Function;
+	FEvent* DoneEvent;
+	FQueuedThreadPool* Pool = nullptr; // Pool the task was queued to, only compared to the current one since it can have been destroyed
+	std::atomic<bool> bAbandoned{false};
+	bool bWaited = false;
+};
+
+FCommandTask::FCommandTask(TFunction<void()>&& InFunction)
+	: QueuedWork(MakeUnique<FQueuedWork>([Function = MoveTemp(InFunction), CancelFlag = ThreadCancelFlag, bIsInteractive = bThreadIsInteractive]()
+	{
+		// Run the commands of the task with the cancellation flag and the priority of the thread that created it
+		FScopedCancellation Cancellation(CancelFlag);
+		FScopedInteractivePriority InteractivePriority(bIsInteractive);
+		Function();
+	}))
+{
+	QueuedWork->Start();
+}
+
+FCommandTask::~FCommandTask()
+{
+	QueuedWork->Wait();
+}
+
+void FCommandTask::Wait()
+{
+	QueuedWork->Wait();
+}
+
+void ParallelForCommands(const int32 InNum, const TFunctionRef<void(int32)>& InBody)
+{
+	std::atomic<int32> NextIndex(0);
+	auto RunIterations = [&NextIndex, InNum, &InBody]()
+	{
+		for (int32 Index = NextIndex++; Index < InNum; Index = NextIndex++)
+		{
+			InBody(Index);
+		}
+	};
+
+	// The calling thread takes part, so only start enough tasks to use all the shells
+	const int32 NumTasks = FMath::Min(InNum, GetShellPoolSize()) - 1;
+	TArray<TUniquePtr<FCommandTask>> Tasks;
+	Tasks.Reserve(FMath::Max(NumTasks, 0));
+	for (int32 Task = 0; Task < NumTasks; Task++)
+	{
+		Tasks.Add(MakeUnique<FCommandTask>(RunIterations));
+	}
+	RunIterations();
+	// Tasks not started yet find no iteration left when run by this thread
+	for (TUniquePtr<FCommandTask>& Task : Tasks)
+	{
+		Task->Wait();
+	}
+}
+
+// Internal function dispatching the command to the pool of shells, with an optional line visitor
+static bool _RunCommand(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, const FLineVisitor* InLineVisitor, const FUtf8LineVisitor* InUtf8LineVisitor, FString& OutResults, FString& OutErrors)
+{
+	FRWScopeLock PoolLock(ShellPoolLock, SLT_ReadOnly);
+
+	if (!IsReadOnlyCommand(InCommand, InParameters))
+	{
+		// Mutating commands are run one at a time on the primary shell, without waiting for the read-only commands running on the shared shells:
+		// a status running meanwhile can report the states of the files before or after the change, as if it had run just before or just after it.
+		FScopeLock Lock(&ShellPool[0].CriticalSection);
+
+		return _RunCommandInternal(ShellPool[0], InCommand, InParameters, InFiles, InLineVisitor, InUtf8LineVisitor, OutResults, OutErrors);
+	}
+
+	// Read-only commands of interactive operations prefer the primary shell, only used by short commands, to not wait behind the background ones
+	if (bThreadIsInteractive)
+	{
+		for (int32 Index = 0; Index < ShellPoolNumShells; Index++)
+		{
+			FShellProcess& Shell = ShellPool[Index];
+			if (Shell.CriticalSection.TryLock())
+			{
+				const bool bResult = _RunCommandInternal(Shell, InCommand, InParameters, InFiles, InLineVisitor, InUtf8LineVisitor, OutResults, OutErrors);
+				Shell.CriticalSection.Unlock();
+				return bResult;
+			}
+		}
+
+		FScopeLock Lock(&ShellPool[0].CriticalSection);
+
+		return _RunCommandInternal(ShellPool[0], InCommand, InParameters, InFiles, InLineVisitor, InUtf8LineVisitor, OutResults, OutErrors);
+	}
+
+	// Other read-only commands are dispatched to whichever shared shell of the pool is idle
+	const int32 FirstSharedShellIndex = _GetFirstSharedShellIndex();
+	const int32 NumSharedShells = ShellPoolNumShells - FirstSharedShellIndex;
+	for (int32 Index = FirstSharedShellIndex; Index < ShellPoolNumShells; Index++)
+	{
+		FShellProcess& Shell = ShellPool[Index];
+		if (Shell.CriticalSection.TryLock())
+		{
+			const bool bResult = _RunCommandInternal(Shell, InCommand, InParameters, InFiles, InLineVisitor, InUtf8LineVisitor, OutResults, OutErrors);
+			Shell.CriticalSection.Unlock();
+			return bResult;
+		}
+	}
+
+	// All shared shells are busy: wait for one of them, in a round-robin fashion to spread the load
+	FShellProcess& Shell = ShellPool[FirstSharedShellIndex + ShellPoolNextIndex++ % NumSharedShells];
+	FScopeLock Lock(&Shell.CriticalSection);
+
+	return _RunCommandInternal(Shell, InCommand, InParameters, InFiles, InLineVisitor, InUtf8LineVisitor, OutResults, OutErrors);
 }
 
 // Run command and return the raw result
 bool RunCommand(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, FString& OutResults, FString& OutErrors)
 {
-	// Protect public APIs from multi-thread access
-	FScopeLock Lock(&ShellCriticalSection);
+	return _RunCommand(InCommand, InParameters, InFiles, nullptr, nullptr, OutResults, OutErrors);
+}
 
-	return _RunCommandInternal(InCommand, InParameters, InFiles, OutResults, OutErrors);
+// Run command and visit each line of the result as soon as it is received
+bool RunCommand(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, const FLineVisitor& InLineVisitor, FString& OutErrors)
+{
+	FString PendingResults;
+	return _RunCommand(InCommand, InParameters, InFiles, &InLineVisitor, nullptr, PendingResults, OutErrors);
+}
+
+// Run command and visit each line of the result as soon as it is received, as raw UTF-8
+bool RunCommandUtf8(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, const FUtf8LineVisitor& InUtf8LineVisitor, FString& OutErrors)
+{
+	FString PendingResults;
+	return _RunCommand(InCommand, InParameters, InFiles, nullptr, &InUtf8LineVisitor, PendingResults, OutErrors);
 }
 
 } // namespace PlasticSourceControlShell
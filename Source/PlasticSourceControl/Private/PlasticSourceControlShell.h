@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/StringView.h"
 
 namespace PlasticSourceControlShell
 {
@@ -12,9 +13,14 @@ namespace PlasticSourceControlShell
 	constexpr const TCHAR* pchDelim = TEXT("\n");
 #endif
 
+/** Visitor called on each line of output of a command, without its delimiter (empty lines are skipped) */
+typedef TFunctionRef<void(FString&& InLine)> FLineVisitor;
+
+/** Visitor called on each line of output of a command as raw UTF-8 bytes, without its delimiter (empty lines are skipped) */
+typedef TFunctionRef<void(FAnsiStringView InLine)> FUtf8LineVisitor;
 
 /**
- * Launch the Unity Version Control "shell" command line process to run it in the background.
+ * Launch the pool of Unity Version Control "shell" command line processes to run them in the background.
  *
  * @param	InPathToPlasticBinary	The path to the Plastic binary
  * @param	InWorkspaceRoot			The workspace from where to run the command - usually the Game directory
@@ -22,23 +28,130 @@ namespace PlasticSourceControlShell
  */
 bool Launch(const FString& InPathToPlasticBinary, const FString& InWorkspaceRoot);
 
-/** Terminate the background 'cm shell' process and associated pipes */
+/** Terminate the background 'cm shell' processes and associated pipes */
 void Terminate();
 
-/** Mark the current shell process as already warmed up - i.e. we already ran a preliminary 'status' command. */
+struct FShellProcess;
+
+/**
+ * A 'cm shell' process of its own, outside of the pool used by the provider, to run commands in isolation (eg in tests, with a fake cm)
+ * without affecting the commands run concurrently by the Editor. Its commands can be cancelled the same way (see FScopedCancellation).
+ */
+class FDedicatedShell
+{
+public:
+	FDedicatedShell();
+
+	/** Terminate the 'cm shell' process, if any */
+	~FDedicatedShell();
+
+	/** Launch the 'cm shell' process, terminating any previous one */
+	bool Launch(const FString& InPathToPlasticBinary, const FString& InWorkingDirectory);
+
+	/** Terminate the 'cm shell' process and associated pipes */
+	void Terminate();
+
+	/** Run a Plastic command on this shell, waiting for any other command running on it (see PlasticSourceControlShell::RunCommand) */
+	bool RunCommand(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, FString& OutResults, FString& OutErrors);
+
+private:
+	TUniquePtr<FShellProcess> Shell;
+};
+
+/** Mark the current shell processes as already warmed up - i.e. we already ran a preliminary 'status' command. */
 void SetShellIsWarmedUp();
 
 /**
- * Retrieve whether the current shell process was already warmed up - i.e. we already ran a preliminary 'status' command.
+ * Retrieve whether the current shell processes were already warmed up - i.e. we already ran a preliminary 'status' command.
  *
- * @returns true if the shell process was already warmed up
+ * @returns true if the shell processes were already warmed up
  */
 bool GetShellIsWarmedUp();
 
+/**
+ * Scope during which the commands run by the current thread can be cancelled, by setting the given flag from any other thread.
+ *
+ * A cancelled command stops waiting for its output, and only the 'cm shell' process running it is recycled;
+ * any further command run by the same thread in the scope fails immediately, without being sent to a shell.
+ * The scope extends to the FCommandTask and ParallelForCommands started by the thread during the scope.
+ */
+class FScopedCancellation
+{
+public:
+	explicit FScopedCancellation(const volatile int32* InCancelFlag);
+	~FScopedCancellation();
+
+private:
+	const volatile int32* PreviousCancelFlag;
+};
+
+/** Whether the commands run by the current thread have been cancelled (see FScopedCancellation) */
+bool IsCancelRequested();
+
+/**
+ * Scope during which the commands run by the current thread are part of an interactive operation,
+ * so that they can use the primary shell, reserved to them and to the mutating commands, instead of waiting for a shared one.
+ */
+class FScopedInteractivePriority
+{
+public:
+	explicit FScopedInteractivePriority(const bool bInIsInteractive);
+	~FScopedInteractivePriority();
+
+private:
+	bool bPreviousIsInteractive;
+};
+
+/** Log the histogram of the latency of all commands run so far, per method used to wait for the output of the shell (sleep polling vs event driven). */
+void LogLatencyHistogram();
+
+/** Number of 'cm shell' processes of the pool shared by the background commands, thus the number of them that can run concurrently (the primary shell being reserved to interactive commands) */
+int32 GetShellPoolSize();
+
+/** Time spent so far by the current thread running commands in a shell, without the time waiting for a shell to be available */
+double GetThreadCommandsTime();
+
+/**
+ * Task running blocking commands on a dedicated pool of threads sized to the pool of shells,
+ * instead of on the workers of the task graph or on a new thread for each task.
+ *
+ * A task that no thread of the pool has started yet when it is waited for is run by the waiting thread instead,
+ * so that tasks waiting for other tasks can never starve the pool. After ShutdownCommandThreadPool(), tasks run on the thread starting them.
+ * The pool is sized to the pool of shells, and rebuilt by Launch() when its size changed.
+ * The commands of a task run with the cancellation flag and the priority of the thread that created it (see FScopedCancellation and FScopedInteractivePriority).
+ */
+class FCommandTask
+{
+public:
+	explicit FCommandTask(TFunction<void()>&& InFunction);
+
+	/** Wait for the task to complete (mandatory before its destruction) */
+	~FCommandTask();
+
+	/** Wait for the task to complete, running it on the current thread if it has not started yet */
+	void Wait();
+
+private:
+	class FQueuedWork;
+	TUniquePtr<FQueuedWork> QueuedWork;
+};
+
+/**
+ * Run a body running blocking commands for each index, concurrently on the pool of threads of FCommandTask and on the calling thread.
+ * Indices are handed out one at a time, so that long and short iterations are balanced between threads.
+ */
+void ParallelForCommands(const int32 InNum, const TFunctionRef<void(int32)>& InBody);
+
+/** Destroy the pool of threads of FCommandTask, when the module shuts down (any task started later runs on the thread starting it) */
+void ShutdownCommandThreadPool();
+
 
 /**
  * Run a Plastic command - the result is the output of cm, as a multi-line string.
  *
+ * Read-only commands (status, fileinfo, history, lock list, find...) run concurrently on any idle shared shell of the pool,
+ * while mutating commands (checkin, update, switch...) are run one at a time on the primary shell, also used by the interactive read-only commands.
+ *
  * @param	InCommand			The Plastic command - e.g. commit
  * @param	InParameters		The parameters to the Plastic command
  * @param	InFiles				The files to be operated on
@@ -48,4 +161,25 @@ bool GetShellIsWarmedUp();
  */
 bool RunCommand(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, FString& OutResults, FString& OutErrors);
 
+/**
+ * Run a Plastic command - each line of output of cm is given to the visitor as soon as it is received,
+ * so that it can be parsed while cm is still running, without ever holding the whole output in memory.
+ *
+ * @note The visitor is called from the thread running the command, while holding a shell of the pool: it must not run any other command.
+ *
+ * @param	InCommand			The Plastic command - e.g. status
+ * @param	InParameters		The parameters to the Plastic command
+ * @param	InFiles				The files to be operated on
+ * @param	InLineVisitor		The visitor called on each line of the results (from StdOut)
+ * @param	OutErrors			Any errors (from StdErr) as a multi-line string.
+ * @returns true if the command succeeded and returned no errors
+ */
+bool RunCommand(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, const FLineVisitor& InLineVisitor, FString& OutErrors);
+
+/**
+ * Run a Plastic command - same as above, but each line of output of cm is given as a view on the raw UTF-8 bytes received from the pipe,
+ * without converting it to an FString, so that a parser can only allocate what it needs. The view is only valid during the call.
+ */
+bool RunCommandUtf8(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, const FUtf8LineVisitor& InUtf8LineVisitor, FString& OutErrors);
+
 } // namespace PlasticSourceControlShell
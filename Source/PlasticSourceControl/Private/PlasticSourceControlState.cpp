@@ -434,25 +434,25 @@ FText FPlasticSourceControlState::GetDisplayName() const
 	if (!IsCurrent())
 	{
 		return FText::Format(LOCTEXT("NotCurrent", "Not at the head revision CS:{0} {1} (local revision is CS:{2})"),
-			FText::AsNumber(DepotRevisionChangeset), FText::FromString(HeadUserName), FText::AsNumber(LocalRevisionChangeset, &NoCommas));
+			FText::AsNumber(DepotRevisionChangeset), FText::FromString(HeadUserName.Get()), FText::AsNumber(LocalRevisionChangeset, &NoCommas));
 	}
 
 	if (!IsCheckedOutImplementation())
 	{
 		if (IsCheckedOutOther())
 		{
-			return FText::Format(LOCTEXT("CheckedOutOther", "Checked out by {0} on {1} (in {2}) since {3}"), FText::FromString(LockedBy), FText::FromString(LockedBranch), FText::FromString(LockedWhere), FText::AsDateTime(LockedDate));
+			return FText::Format(LOCTEXT("CheckedOutOther", "Checked out by {0} on {1} (in {2}) since {3}"), FText::FromString(LockedBy.Get()), FText::FromString(LockedBranch.Get()), FText::FromString(LockedWhere.Get()), FText::AsDateTime(LockedDate));
 		}
 
 		if (IsRetainedInOtherBranch())
 		{
-			return FText::Format(LOCTEXT("RetainedLock", "Retained on {0} by {1} since {2}"), FText::FromString(LockedBranch), FText::FromString(RetainedBy), FText::AsDateTime(LockedDate));
+			return FText::Format(LOCTEXT("RetainedLock", "Retained on {0} by {1} since {2}"), FText::FromString(LockedBranch.Get()), FText::FromString(RetainedBy.Get()), FText::AsDateTime(LockedDate));
 		}
 
 		if (IsModifiedInOtherBranch())
 		{
 			return FText::Format(LOCTEXT("ModifiedOtherBranch", "Modified in {0} as CS:{1} by {2} (local revision is CS:{3})"),
-				FText::FromString(HeadBranch), FText::AsNumber(HeadChangeList, &NoCommas), FText::FromString(HeadUserName), FText::AsNumber(LocalRevisionChangeset, &NoCommas));
+				FText::FromString(HeadBranch.Get()), FText::AsNumber(HeadChangeList, &NoCommas), FText::FromString(HeadUserName.Get()), FText::AsNumber(LocalRevisionChangeset, &NoCommas));
 		}
 	}
 
@@ -502,25 +502,25 @@ FText FPlasticSourceControlState::GetDisplayTooltip() const
 	if (!IsCurrent())
 	{
 		return FText::Format(LOCTEXT("NotCurrent_Tooltip", "Not at the head revision CS:{0} {1} (local revision is CS:{2})"),
-			FText::AsNumber(DepotRevisionChangeset), FText::FromString(HeadUserName), FText::AsNumber(LocalRevisionChangeset, &NoCommas));
+			FText::AsNumber(DepotRevisionChangeset), FText::FromString(HeadUserName.Get()), FText::AsNumber(LocalRevisionChangeset, &NoCommas));
 	}
 
 	if (!IsCheckedOutImplementation())
 	{
 		if (IsCheckedOutOther())
 		{
-			return FText::Format(LOCTEXT("CheckedOutOther_Tooltip", "Checked out by {0} on {1} (in {2}) since {3}"), FText::FromString(LockedBy), FText::FromString(LockedBranch), FText::FromString(LockedWhere), FText::AsDateTime(LockedDate));
+			return FText::Format(LOCTEXT("CheckedOutOther_Tooltip", "Checked out by {0} on {1} (in {2}) since {3}"), FText::FromString(LockedBy.Get()), FText::FromString(LockedBranch.Get()), FText::FromString(LockedWhere.Get()), FText::AsDateTime(LockedDate));
 		}
 
 		if (IsRetainedInOtherBranch())
 		{
-			return FText::Format(LOCTEXT("RetainedLock_Tooltip", "Retained on {0} by {1} since {2}"), FText::FromString(LockedBranch), FText::FromString(RetainedBy), FText::AsDateTime(LockedDate));
+			return FText::Format(LOCTEXT("RetainedLock_Tooltip", "Retained on {0} by {1} since {2}"), FText::FromString(LockedBranch.Get()), FText::FromString(RetainedBy.Get()), FText::AsDateTime(LockedDate));
 		}
 
 		if (IsModifiedInOtherBranch())
 		{
 			return FText::Format(LOCTEXT("ModifiedOtherBranch_Tooltip", "Modified in {0} as CS:{1} by {2} (local revision is CS:{3})"),
-				FText::FromString(HeadBranch), FText::AsNumber(HeadChangeList, &NoCommas), FText::FromString(HeadUserName), FText::AsNumber(LocalRevisionChangeset, &NoCommas));
+				FText::FromString(HeadBranch.Get()), FText::AsNumber(HeadChangeList, &NoCommas), FText::FromString(HeadUserName.Get()), FText::AsNumber(LocalRevisionChangeset, &NoCommas));
 		}
 	}
 
@@ -682,7 +682,7 @@ bool FPlasticSourceControlState::IsCheckedOutOther(FString* Who) const
 {
 	if (Who != NULL)
 	{
-		*Who = LockedBy;
+		*Who = LockedBy.Get();
 	}
 
 	// An asset is locked somewhere else if it is Locked but not CheckedOut on the current workspace
@@ -715,7 +715,7 @@ bool FPlasticSourceControlState::IsModifiedInOtherBranch(const FString& CurrentB
 */
 bool FPlasticSourceControlState::GetOtherBranchHeadModification(FString& HeadBranchOut, FString& ActionOut, int32& HeadChangeListOut) const
 {
-	HeadBranchOut = HeadBranch;
+	HeadBranchOut = HeadBranch.Get();
 	ActionOut = HeadAction;
 	HeadChangeListOut = HeadChangeList;
 
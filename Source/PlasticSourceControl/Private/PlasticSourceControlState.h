@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "ISourceControlState.h"
 #include "ISourceControlRevision.h"
+#include "PlasticSourceControlInternedString.h"
 #include "PlasticSourceControlRevision.h"
 
 #include "Runtime/Launch/Resources/Version.h"
@@ -79,7 +80,12 @@ public:
 		{
 			History = MoveTemp(InState.History);
 		}
-		LocalFilename = MoveTemp(InState.LocalFilename);
+		// The filename of a cached state is also its key in the cache, that other threads can be reading:
+		// a case-only rename is applied by the cache itself, under the lock of the shard (see FPlasticSourceControlStateCache::RenameCase())
+		if (!LocalFilename.Equals(InState.LocalFilename, ESearchCase::IgnoreCase))
+		{
+			LocalFilename = MoveTemp(InState.LocalFilename);
+		}
 		WorkspaceState = InState.WorkspaceState;
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
 		PendingResolveInfo = MoveTemp(InState.PendingResolveInfo);
@@ -185,11 +191,16 @@ public:
 	/** History of the item, if any */
 	TPlasticSourceControlHistory History;
 
-	/** Filename on disk */
+	/**
+	 * Filename on disk
+	 *
+	 * @note Kept as a full string, not split into an interned directory and a leaf name, since GetFilename() returns a reference to it;
+	 * it is instead shared with the key of the state in the cache (see FPlasticSourceControlStateCache).
+	 */
 	FString LocalFilename;
 
 	/** Depot and Server info (in the form repo@server:port) */
-	FString RepSpec;
+	FPlasticSourceControlInternedString RepSpec;
 
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
 	/** Pending rev info with which a file must be resolved, invalid if no resolve pending */
@@ -209,13 +220,13 @@ public:
 	TArray<FString> PendingMergeParameters;
 
 	/** If a user (another or ourself) has this file locked, this contains their name. */
-	FString LockedBy;
+	FPlasticSourceControlInternedString LockedBy;
 
 	/** Location (Workspace) where the file was exclusively checked-out. */
-	FString LockedWhere;
+	FPlasticSourceControlInternedString LockedWhere;
 
 	/** Branch where the file was Locked or is Retained. */
-	FString LockedBranch;
+	FPlasticSourceControlInternedString LockedBranch;
 
 	/** Item id of the locked file (for an admin to unlock it). */
 	int32 LockedId = INVALID_REVISION;
@@ -224,7 +235,7 @@ public:
 	FDateTime LockedDate = 0;
 
 	/** If a user (another or ourself) has this file Retained on another branch, this contains their name. */
-	FString RetainedBy;
+	FPlasticSourceControlInternedString RetainedBy;
 
 	/** State of the workspace */
 	EWorkspaceState WorkspaceState = EWorkspaceState::Unknown;
@@ -247,13 +258,13 @@ public:
 	FDateTime TimeStamp = 0;
 
 	/** The branch with the head change list */
-	FString HeadBranch;
+	FPlasticSourceControlInternedString HeadBranch;
 
 	/** The type of action of the last modification */
 	FString HeadAction;
 
 	/** The user of the last modification */
-	FString HeadUserName;
+	FPlasticSourceControlInternedString HeadUserName;
 
 	/** The last file modification time */
 	int64 HeadModTime;
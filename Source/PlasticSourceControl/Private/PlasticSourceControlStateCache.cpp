@@ -0,0 +1,299 @@
+// Copyright (c) 2025 Unity Technologies
+
+#include "PlasticSourceControlStateCache.h"
+
+#include "ISourceControlModule.h"
+
+// Directory of a file, ie. the path up to its last slash (empty if none)
+static FString GetDirectory(const FString& InFilename)
+{
+	int32 SlashIndex = INDEX_NONE;
+	if (InFilename.FindLastChar(TEXT('/'), SlashIndex))
+	{
+		return InFilename.Left(SlashIndex);
+	}
+	return FString();
+}
+
+FPlasticSourceControlStateCache::FPlasticSourceControlStateCache()
+	: DirectoryIndex(MakeUnique<FDirectoryNode>())
+{
+}
+
+FPlasticSourceControlStateCache::FDirectoryNode& FPlasticSourceControlStateCache::FindOrAddDirectory(const FString& InDirectory)
+{
+	TArray<FString> Components;
+	InDirectory.ParseIntoArray(Components, TEXT("/"), true);
+
+	FDirectoryNode* Node = DirectoryIndex.Get();
+	for (FString& Component : Components)
+	{
+		TUniquePtr<FDirectoryNode>& SubDirectory = Node->SubDirectories.FindOrAdd(MoveTemp(Component));
+		if (!SubDirectory.IsValid())
+		{
+			SubDirectory = MakeUnique<FDirectoryNode>();
+		}
+		Node = SubDirectory.Get();
+	}
+	return *Node;
+}
+
+FPlasticSourceControlStateCache::FDirectoryNode* FPlasticSourceControlStateCache::FindDirectory(const FString& InDirectory) const
+{
+	TArray<FString> Components;
+	InDirectory.ParseIntoArray(Components, TEXT("/"), true);
+
+	FDirectoryNode* Node = DirectoryIndex.Get();
+	for (const FString& Component : Components)
+	{
+		const TUniquePtr<FDirectoryNode>* SubDirectory = Node->SubDirectories.Find(Component);
+		if (SubDirectory == nullptr)
+		{
+			return nullptr;
+		}
+		Node = SubDirectory->Get();
+	}
+	return Node;
+}
+
+FPlasticSourceControlStateRef FPlasticSourceControlStateCache::FindOrAdd(const FString& InFilename)
+{
+	FShard& Shard = GetShard(InFilename);
+	{
+		FReadScopeLock ReadLock(Shard.Lock);
+		if (const FPlasticSourceControlStateRef* State = Shard.States.Find(InFilename))
+		{
+			// found cached item
+			return *State;
+		}
+	}
+
+	FWriteScopeLock WriteLock(Shard.Lock);
+	// Check again, since another thread could have added the same file since the read lock was released
+	if (const FPlasticSourceControlStateRef* State = Shard.States.Find(InFilename))
+	{
+		return *State;
+	}
+
+	// cache an unknown state for this item, and index it by directory (while holding the lock of the shard so that a concurrent Remove() cannot interleave)
+	FPlasticSourceControlStateRef NewState = MakeShareable(new FPlasticSourceControlState(FString(InFilename)));
+	Shard.States.Add(NewState);
+	{
+		FWriteScopeLock IndexLock(DirectoryIndexLock);
+		FindOrAddDirectory(GetDirectory(InFilename)).Files.Add(NewState);
+	}
+	return NewState;
+}
+
+FPlasticSourceControlStatePtr FPlasticSourceControlStateCache::Find(const FString& InFilename) const
+{
+	const FShard& Shard = GetShard(InFilename);
+	FReadScopeLock ReadLock(Shard.Lock);
+	if (const FPlasticSourceControlStateRef* State = Shard.States.Find(InFilename))
+	{
+		return *State;
+	}
+	return nullptr;
+}
+
+bool FPlasticSourceControlStateCache::Remove(const FString& InFilename)
+{
+	FShard& Shard = GetShard(InFilename);
+	FWriteScopeLock WriteLock(Shard.Lock);
+	FPlasticSourceControlStatePtr State;
+	if (const FPlasticSourceControlStateRef* FoundState = Shard.States.Find(InFilename))
+	{
+		State = *FoundState;
+		Shard.States.Remove(InFilename);
+	}
+	if (!State.IsValid())
+	{
+		return false;
+	}
+
+	FWriteScopeLock IndexLock(DirectoryIndexLock);
+	// Note: empty directories are kept in the index, to be reused by next files, until the cache is emptied
+	if (FDirectoryNode* Directory = FindDirectory(GetDirectory(InFilename)))
+	{
+		Directory->Files.RemoveSingleSwap(State.ToSharedRef());
+	}
+	return true;
+}
+
+void FPlasticSourceControlStateCache::RenameCase(const FPlasticSourceControlStateRef& InState, const FString& InFilename)
+{
+	check(InState->LocalFilename.Equals(InFilename, ESearchCase::IgnoreCase));
+
+	// Filenames being hashed case-insensitively, the state stays in the same shard, and in the same node of the tree of directories
+	FShard& Shard = GetShard(InFilename);
+	FWriteScopeLock WriteLock(Shard.Lock);
+	if (Shard.States.Remove(InState->LocalFilename) > 0)
+	{
+		InState->LocalFilename = InFilename;
+		Shard.States.Add(InState);
+	}
+	else
+	{
+		InState->LocalFilename = InFilename;
+	}
+}
+
+void FPlasticSourceControlStateCache::Empty()
+{
+	// Hold the locks of all the shards and of the index for the whole operation (taken in the same order as FindOrAdd() and Remove()),
+	// so that no lookup can ever see the index pointing to states already removed from the shards
+	TArray<TSet<FPlasticSourceControlStateRef, FStateKeyFuncs>> RemovedStates;
+	RemovedStates.Reserve(NumShards);
+	TUniquePtr<FDirectoryNode> RemovedDirectoryIndex;
+	for (FShard& Shard : Shards)
+	{
+		Shard.Lock.WriteLock();
+	}
+	{
+		FWriteScopeLock IndexLock(DirectoryIndexLock);
+		for (FShard& Shard : Shards)
+		{
+			RemovedStates.Add(MoveTemp(Shard.States));
+			Shard.States.Reset();
+		}
+		RemovedDirectoryIndex = MoveTemp(DirectoryIndex);
+		DirectoryIndex = MakeUnique<FDirectoryNode>();
+	}
+	for (FShard& Shard : Shards)
+	{
+		Shard.Lock.WriteUnlock();
+	}
+
+	// The states and the nodes of the index are freed after releasing the locks
+}
+
+void FPlasticSourceControlStateCache::LogMemoryReport() const
+{
+	// Memory that each state would use to store its own copy of the strings now interned
+	auto GetInternedSize = [](const FPlasticSourceControlInternedString& InString)
+	{
+		return InString.IsEmpty() ? 0 : (InString.Get().Len() + 1) * sizeof(TCHAR);
+	};
+
+	int32 NumStates = 0;
+	SIZE_T StatesSize = 0;
+	SIZE_T FilenamesSize = 0;
+	SIZE_T InternedStringsSize = 0;
+	for (const FShard& Shard : Shards)
+	{
+		FReadScopeLock ReadLock(Shard.Lock);
+		NumStates += Shard.States.Num();
+		StatesSize += Shard.States.GetAllocatedSize();
+		for (const FPlasticSourceControlStateRef& State : Shard.States)
+		{
+			StatesSize += sizeof(FPlasticSourceControlState) + State->LocalFilename.GetAllocatedSize() + State->MovedFrom.GetAllocatedSize() + State->History.GetAllocatedSize();
+			FilenamesSize += sizeof(FString) + State->LocalFilename.GetAllocatedSize();
+			InternedStringsSize += GetInternedSize(State->RepSpec) + GetInternedSize(State->LockedBy) + GetInternedSize(State->LockedWhere) + GetInternedSize(State->LockedBranch)
+				+ GetInternedSize(State->RetainedBy) + GetInternedSize(State->HeadBranch) + GetInternedSize(State->HeadUserName);
+		}
+	}
+
+	// Overhead of the tree of directories indexing the states (the names of the directories, and the references to the states)
+	int32 NumDirectories = 0;
+	SIZE_T DirectoryIndexSize = 0;
+	{
+		FReadScopeLock IndexLock(DirectoryIndexLock);
+		TArray<const FDirectoryNode*, TInlineAllocator<64>> DirectoriesToVisit;
+		DirectoriesToVisit.Add(DirectoryIndex.Get());
+		while (DirectoriesToVisit.Num() > 0)
+		{
+			const FDirectoryNode* Node = DirectoriesToVisit.Pop();
+			NumDirectories++;
+			DirectoryIndexSize += sizeof(FDirectoryNode) + Node->SubDirectories.GetAllocatedSize() + Node->Files.GetAllocatedSize();
+			for (const TPair<FString, TUniquePtr<FDirectoryNode>>& SubDirectory : Node->SubDirectories)
+			{
+				DirectoryIndexSize += SubDirectory.Key.GetAllocatedSize();
+				DirectoriesToVisit.Add(SubDirectory.Value.Get());
+			}
+		}
+	}
+	StatesSize += DirectoryIndexSize;
+
+	int32 NumInternedStrings = 0;
+	SIZE_T InternedTableSize = 0;
+	FPlasticSourceControlInternedString::GetTableStats(NumInternedStrings, InternedTableSize);
+
+	// The filenames were previously duplicated as keys of the map of states
+	const int64 SavedSize = static_cast<int64>(FilenamesSize) + static_cast<int64>(InternedStringsSize) - static_cast<int64>(InternedTableSize);
+	UE_LOG(LogSourceControl, Display, TEXT("State cache: %d states using %llu KiB"), NumStates, static_cast<uint64>(StatesSize / 1024));
+	UE_LOG(LogSourceControl, Display, TEXT(" - directory index: %d directories using %llu KiB (included above)"), NumDirectories, static_cast<uint64>(DirectoryIndexSize / 1024));
+	UE_LOG(LogSourceControl, Display, TEXT(" - filenames shared with the keys of the cache: %llu KiB saved"), static_cast<uint64>(FilenamesSize / 1024));
+	UE_LOG(LogSourceControl, Display, TEXT(" - %d interned strings (branches, users, workspaces, repspecs) using %llu KiB instead of %llu KiB"),
+		NumInternedStrings, static_cast<uint64>(InternedTableSize / 1024), static_cast<uint64>(InternedStringsSize / 1024));
+	UE_LOG(LogSourceControl, Display, TEXT(" - total memory saved: %lld KiB"), SavedSize / 1024);
+}
+
+int32 FPlasticSourceControlStateCache::Num() const
+{
+	int32 NumStates = 0;
+	for (const FShard& Shard : Shards)
+	{
+		FReadScopeLock ReadLock(Shard.Lock);
+		NumStates += Shard.States.Num();
+	}
+	return NumStates;
+}
+
+TArray<FPlasticSourceControlStateRef> FPlasticSourceControlStateCache::GetByPredicate(TFunctionRef<bool(const FPlasticSourceControlStateRef&)> InPredicate) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPlasticSourceControlStateCache::GetByPredicate);
+
+	TArray<FPlasticSourceControlStateRef> Result;
+	TArray<FPlasticSourceControlStateRef> ShardStates;
+	for (const FShard& Shard : Shards)
+	{
+		// Copy the states of the shard to evaluate the predicate without holding the lock
+		{
+			FReadScopeLock ReadLock(Shard.Lock);
+			ShardStates = Shard.States.Array();
+		}
+		for (const FPlasticSourceControlStateRef& State : ShardStates)
+		{
+			if (InPredicate(State))
+			{
+				Result.Add(State);
+			}
+		}
+	}
+	return Result;
+}
+
+TArray<FPlasticSourceControlStateRef> FPlasticSourceControlStateCache::GetUnderDirectory(const FString& InDirectory, TFunctionRef<bool(const FPlasticSourceControlStateRef&)> InPredicate) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPlasticSourceControlStateCache::GetUnderDirectory);
+
+	// Collect the states of the sub-tree of the directory, to evaluate the predicate without holding the lock
+	TArray<FPlasticSourceControlStateRef> States;
+	{
+		FReadScopeLock IndexLock(DirectoryIndexLock);
+		if (const FDirectoryNode* Directory = FindDirectory(InDirectory))
+		{
+			TArray<const FDirectoryNode*, TInlineAllocator<64>> DirectoriesToVisit;
+			DirectoriesToVisit.Add(Directory);
+			while (DirectoriesToVisit.Num() > 0)
+			{
+				const FDirectoryNode* Node = DirectoriesToVisit.Pop();
+				States.Append(Node->Files);
+				for (const TPair<FString, TUniquePtr<FDirectoryNode>>& SubDirectory : Node->SubDirectories)
+				{
+					DirectoriesToVisit.Add(SubDirectory.Value.Get());
+				}
+			}
+		}
+	}
+
+	TArray<FPlasticSourceControlStateRef> Result;
+	for (const FPlasticSourceControlStateRef& State : States)
+	{
+		if (InPredicate(State))
+		{
+			Result.Add(State);
+		}
+	}
+	return Result;
+}
@@ -0,0 +1,115 @@
+// Copyright (c) 2025 Unity Technologies
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include "Templates/UniquePtr.h"
+
+#include "PlasticSourceControlState.h"
+
+/**
+ * Cache of the states of the files, by absolute filename, that worker threads can read safely while the game thread updates it.
+ *
+ * The map of states is split in shards, each protected by its own read/write lock, to limit contention between threads.
+ * A tree of the directories indexes the same states by path, so that the states under a directory are found
+ * by walking the sub-tree of this directory instead of scanning the whole cache.
+ *
+ * @note Filenames are case-insensitive, like the keys of a TMap of FString, and only the case of the filename of a cached state can change (see RenameCase()).
+ * @note Only the structure of the cache is thread-safe: states themselves are still only updated by the game thread.
+ */
+class FPlasticSourceControlStateCache
+{
+public:
+	FPlasticSourceControlStateCache();
+
+	/** Find the state of a file, or cache a new unknown state for it */
+	FPlasticSourceControlStateRef FindOrAdd(const FString& InFilename);
+
+	/** Find the state of a file (returns null if not in the cache) */
+	FPlasticSourceControlStatePtr Find(const FString& InFilename) const;
+
+	/** Remove the state of a file from the cache */
+	bool Remove(const FString& InFilename);
+
+	/** Change the case of the filename of a cached state, that is also its key, removing and adding it back under the write lock of its shard */
+	void RenameCase(const FPlasticSourceControlStateRef& InState, const FString& InFilename);
+
+	/** Remove all the states from the cache */
+	void Empty();
+
+	/** Log the memory used by the states of the cache, and the memory saved by sharing their filenames and interning their strings */
+	void LogMemoryReport() const;
+
+	/** Number of states in the cache */
+	int32 Num() const;
+
+	/** All the states of the cache matching a predicate (evaluated without holding any lock, so it can access the cache) */
+	TArray<FPlasticSourceControlStateRef> GetByPredicate(TFunctionRef<bool(const FPlasticSourceControlStateRef&)> InPredicate) const;
+
+	/**
+	 * The states of the files in a directory and all its sub-directories matching a predicate,
+	 * visiting only the states under this directory instead of the whole cache.
+	 *
+	 * @param	InDirectory		Absolute path of the directory, with or without a trailing slash
+	 * @param	InPredicate		Filter of the states (evaluated without holding any lock, so it can access the cache)
+	 */
+	TArray<FPlasticSourceControlStateRef> GetUnderDirectory(const FString& InDirectory, TFunctionRef<bool(const FPlasticSourceControlStateRef&)> InPredicate) const;
+
+private:
+	/** Number of shards of the map of states, a power of two */
+	static constexpr int32 NumShards = 16;
+
+	/** Use the filename of the state itself as its key, instead of a copy of it */
+	struct FStateKeyFuncs : BaseKeyFuncs<FPlasticSourceControlStateRef, FString, false>
+	{
+		static const FString& GetSetKey(const FPlasticSourceControlStateRef& InState)
+		{
+			return InState->LocalFilename;
+		}
+		static bool Matches(const FString& InLhs, const FString& InRhs)
+		{
+			return InLhs.Equals(InRhs, ESearchCase::IgnoreCase);
+		}
+		static uint32 GetKeyHash(const FString& InKey)
+		{
+			return GetTypeHash(InKey);
+		}
+	};
+
+	struct FShard
+	{
+		mutable FRWLock Lock;
+		TSet<FPlasticSourceControlStateRef, FStateKeyFuncs> States;
+	};
+
+	/** Node of the tree of directories, with the states of the files directly in this directory */
+	struct FDirectoryNode
+	{
+		TMap<FString, TUniquePtr<FDirectoryNode>> SubDirectories;
+		TArray<FPlasticSourceControlStateRef> Files;
+	};
+
+	FShard& GetShard(const FString& InFilename)
+	{
+		return Shards[GetTypeHash(InFilename) & (NumShards - 1)];
+	}
+	const FShard& GetShard(const FString& InFilename) const
+	{
+		return Shards[GetTypeHash(InFilename) & (NumShards - 1)];
+	}
+
+	/** Find the node of a directory, creating it and its parents if needed (requires the write lock of the index) */
+	FDirectoryNode& FindOrAddDirectory(const FString& InDirectory);
+
+	/** Find the node of a directory (requires a lock of the index, the write lock to modify the node) */
+	FDirectoryNode* FindDirectory(const FString& InDirectory) const;
+
+	FShard Shards[NumShards];
+
+	/** Lock of the tree of directories, always taken after the lock of a shard */
+	mutable FRWLock DirectoryIndexLock;
+
+	/** Root of the tree of directories */
+	TUniquePtr<FDirectoryNode> DirectoryIndex;
+};
@@ -14,10 +14,13 @@
 #include "PlasticSourceControlShell.h"
 #include "PlasticSourceControlState.h"
 #include "PlasticSourceControlVersions.h"
+#include "PlasticSourceControlWorkspaceWatcher.h"
 #include "ISourceControlModule.h"
 
+#include "Containers/Queue.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
 #include "SoftwareVersion.h"
 #include "ScopedTempFile.h"
 
@@ -26,6 +29,8 @@
 #include "PlasticSourceControlChangelistState.h"
 #endif
 
+#include <atomic>
+
 #if PLATFORM_WINDOWS
 #include "Windows/AllowWindowsPlatformTypes.h"
 #include "Windows/WindowsPlatformMisc.h"
@@ -67,6 +72,105 @@ bool RunCommand(const FString& InCommand, const TArray<FString>& InParameters, c
 	return bResult;
 }
 
+/**
+ * Last lines of output of a streamed command, returned as errors if the command fails without any error output,
+ * like the whole output of a command that is not streamed (for backward compatibility with old cm versions pre 8044).
+ * Only the last lines are kept, in buffers reused once full, to not hold the whole output of a successful command in memory.
+ */
+template<typename CharType>
+class TStreamedOutputTail
+{
+public:
+	static constexpr int32 MaxNumLines = 1000;
+
+	void Add(const CharType* InLine, const int32 InLen)
+	{
+		if (Lines.Num() < MaxNumLines)
+		{
+			Lines.Emplace(InLine, InLen);
+		}
+		else
+		{
+			Lines[NextIndex].Reset();
+			Lines[NextIndex].Append(InLine, InLen);
+			NextIndex = (NextIndex + 1) % MaxNumLines;
+		}
+	}
+
+	void AppendTo(TArray<FString>& OutLines) const
+	{
+		for (int32 Index = 0; Index < Lines.Num(); Index++)
+		{
+			OutLines.Add(ToString(Lines[(NextIndex + Index) % Lines.Num()]));
+		}
+	}
+
+private:
+	static FString ToString(const TArray<TCHAR>& InLine)
+	{
+		return FString(InLine.Num(), InLine.GetData());
+	}
+
+	static FString ToString(const TArray<ANSICHAR>& InLine)
+	{
+		const FUTF8ToTCHAR Converted(InLine.GetData(), InLine.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	TArray<TArray<CharType>> Lines;
+	int32 NextIndex = 0;
+};
+
+// Parse the errors of a streamed command, or return its last lines of output as errors if it failed without any error output
+template<typename CharType>
+static void ParseStreamedCommandErrors(const bool bInResult, const FString& InErrors, const TStreamedOutputTail<CharType>& InOutputTail, TArray<FString>& OutErrorMessages)
+{
+	if (!InErrors.IsEmpty())
+	{
+		TArray<FString> ParsedErrors;
+		InErrors.ParseIntoArray(ParsedErrors, PlasticSourceControlShell::pchDelim, true);
+		OutErrorMessages.Append(MoveTemp(ParsedErrors));
+	}
+	else if (!bInResult)
+	{
+		InOutputTail.AppendTo(OutErrorMessages);
+	}
+}
+
+// Run a command and visit each line of results as soon as it is received
+bool RunCommand(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, const TFunctionRef<void(FString&&)>& InLineVisitor, TArray<FString>& OutErrorMessages)
+{
+	FString Errors;
+	TStreamedOutputTail<TCHAR> OutputTail;
+
+	const bool bResult = PlasticSourceControlShell::RunCommand(InCommand, InParameters, InFiles, [&InLineVisitor, &OutputTail](FString&& InLine)
+	{
+		OutputTail.Add(*InLine, InLine.Len());
+		InLineVisitor(MoveTemp(InLine));
+	}, Errors);
+
+	ParseStreamedCommandErrors(bResult, Errors, OutputTail, OutErrorMessages);
+
+	return bResult;
+}
+
+// Run a command and visit each line of results as soon as it is received, as raw UTF-8
+bool RunCommandUtf8(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, const TFunctionRef<void(FAnsiStringView)>& InUtf8LineVisitor, TArray<FString>& OutErrorMessages)
+{
+	FString Errors;
+	TStreamedOutputTail<ANSICHAR> OutputTail;
+
+	const bool bResult = PlasticSourceControlShell::RunCommandUtf8(InCommand, InParameters, InFiles, [&InUtf8LineVisitor, &OutputTail](FAnsiStringView InLine)
+	{
+		OutputTail.Add(InLine.GetData(), InLine.Len());
+		InUtf8LineVisitor(InLine);
+	}, Errors);
+
+	ParseStreamedCommandErrors(bResult, Errors, OutputTail, OutErrorMessages);
+
+	return bResult;
+}
+
 FString FindPlasticBinaryPath()
 {
 #if PLATFORM_WINDOWS
@@ -399,8 +503,9 @@ FString UserNameToDisplayName(const FString& InUserName)
  * @param[out]	OutErrorMessages	Error messages from the "status" command
  * @param[out]	OutStates			States of files for witch the status has been gathered (distinct than InFiles in case of a "directory status")
  * @param[out]	OutChangeset		The current Changeset Number
+ * @param[in]	InStateSink			Optional consumer of the states of a "directory status", called as soon as each one is parsed (they are then not returned in OutStates)
  */
-static bool RunStatus(const FString& InDir, TArray<FString>&& InFiles, const EStatusSearchType InSearchType, TArray<FString>& OutErrorMessages, TArray<FPlasticSourceControlState>& OutStates, int32& OutChangeset)
+static bool RunStatus(const FString& InDir, TArray<FString>&& InFiles, const EStatusSearchType InSearchType, TArray<FString>& OutErrorMessages, TArray<FPlasticSourceControlState>& OutStates, int32& OutChangeset, const TFunction<void(FPlasticSourceControlState&&)>& InStateSink = nullptr)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlUtils::RunStatus);
 
@@ -443,42 +548,45 @@ static bool RunStatus(const FString& InDir, TArray<FString>&& InFiles, const ESt
 	{
 		OnePath.Add(InDir);
 	}
-	TArray<FString> Results;
+	const bool bWholeDirectory = (InFiles.Num() == 1) && (InFiles[0] == InDir);
+	// Parse each line of result into a state as soon as it is received
+	PlasticSourceControlParsers::FStatusResultParser StatusParser;
 	TArray<FString> ErrorMessages;
-	const bool bResult = RunCommand(TEXT("status"), Parameters, OnePath, Results, ErrorMessages);
-	OutErrorMessages.Append(MoveTemp(ErrorMessages));
-	if (bResult)
+	const bool bResult = RunCommandUtf8(TEXT("status"), Parameters, OnePath, [&StatusParser, &InStateSink, bWholeDirectory](FAnsiStringView InResult)
 	{
-		// Parse the first line of status with the Changeset number, then remove it to work on a plain list of files
-		if (Results.Num() > 0)
+		const int32 NumStates = StatusParser.States.Num();
+		StatusParser.ParseLine(InResult);
+		// The state of a file found by a directory status is final as soon as it is parsed, so it can be consumed right away
+		if (bWholeDirectory && InStateSink && (StatusParser.States.Num() > NumStates))
 		{
-			PlasticSourceControlParsers::GetChangesetFromWorkspaceStatus(Results, OutChangeset);
-#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5
-			Results.RemoveAt(0, EAllowShrinking::No);
-#else
-			Results.RemoveAt(0, 1, false);
-#endif
+			InStateSink(CopyTemp(StatusParser.States.Last()));
 		}
-
-		// Normalize file paths in the result (convert all '\' to '/')
-		for (FString& Result : Results)
+	}, ErrorMessages);
+	OutErrorMessages.Append(MoveTemp(ErrorMessages));
+	if (bResult)
+	{
+		if (StatusParser.Changeset != -1)
 		{
-			FPaths::NormalizeFilename(Result);
+			OutChangeset = StatusParser.Changeset;
 		}
 
-		const bool bWholeDirectory = (InFiles.Num() == 1) && (InFiles[0] == InDir);
 		if (bWholeDirectory)
 		{
 			// 1) Special case for "status" of a directory: requires a specific parse logic.
 			//   (this is triggered by the "Submit to Source Control" top menu button, but also for the initial check, the global Revert etc)
 			UE_LOG(LogSourceControl, Verbose, TEXT("RunStatus(%s): 1) special case for status of a directory:"), *InDir);
-			PlasticSourceControlParsers::ParseDirectoryStatusResult(InDir, Results, OutStates);
+			// Serialize the update of the cache of states, since directories can be processed concurrently (see RunUpdateStatus())
+			static FCriticalSection DirectoryStatusCriticalSection;
+			FScopeLock Lock(&DirectoryStatusCriticalSection);
+			// States already given to InStateSink are only parsed here to update the cache of the files not found anymore
+			TArray<FPlasticSourceControlState> ConsumedStates;
+			PlasticSourceControlParsers::ParseDirectoryStatusResult(InDir, MoveTemp(StatusParser.States), InStateSink ? ConsumedStates : OutStates);
 		}
 		else
 		{
 			// 2) General case for one or more files in the same directory.
 			UE_LOG(LogSourceControl, Verbose, TEXT("RunStatus(%s...): 2) general case for %d file(s) in a directory (%s)"), *InFiles[0], InFiles.Num(), *InDir);
-			PlasticSourceControlParsers::ParseFileStatusResult(MoveTemp(InFiles), Results, OutStates);
+			PlasticSourceControlParsers::ParseFileStatusResult(MoveTemp(InFiles), MoveTemp(StatusParser.States), OutStates);
 		}
 	}
 
@@ -486,40 +594,71 @@ static bool RunStatus(const FString& InDir, TArray<FString>&& InFiles, const ESt
 }
 
 // Cache Locks with a Timestamp, and an InvalidateCachedLocks() function
+// The locks are kept in an immutable index by server path, shared with the callers, and replaced as a whole when updated
 class FLocksCache
 {
 public:
 	void Reset()
 	{
 		FScopeLock Lock(&CriticalSection);
-		Locks.Reset();
+		LocksIndex.Reset();
 		Timestamp = FDateTime();
+		Generation++;
 	}
 
 	void SetLocks(const TArray<FPlasticSourceControlLockRef>& InLocks)
 	{
-		Locks = InLocks;
+		LocksIndex = MakeShared<const FPlasticSourceControlLocksIndex, ESPMode::ThreadSafe>(InLocks);
 		Timestamp = FDateTime::Now();
+		Generation++;
 	}
 
-	bool GetLocks(TArray<FPlasticSourceControlLockRef>& OutLocks)
+	bool GetLocks(FPlasticSourceControlLocksIndexPtr& OutLocksIndex)
 	{
 		const FTimespan ElapsedTime = FDateTime::Now() - Timestamp;
-		if (ElapsedTime.GetTotalMinutes() < GetDefault<UPlasticSourceControlProjectSettings>()->LocksCacheExpirationDelayMinutes)
+		if (LocksIndex.IsValid() && (ElapsedTime.GetTotalMinutes() < GetDefault<UPlasticSourceControlProjectSettings>()->LocksCacheExpirationDelayMinutes))
 		{
-			UE_LOG(LogSourceControl, Verbose, TEXT("FLocksCache::GetLocks(%d)"), Locks.Num());
-			OutLocks = Locks;
+			UE_LOG(LogSourceControl, Verbose, TEXT("FLocksCache::GetLocks(%d)"), LocksIndex->GetLocks().Num());
+			OutLocksIndex = LocksIndex;
 			return true;
 		}
 		return false;
 	}
 
+	/** Patch the list of locks in place, without changing its expiration (the index being shared, a new one is built if the patch changed the list) */
+	void PatchLocks(TFunctionRef<bool(TArray<FPlasticSourceControlLockRef>& InOutLocks)> InPatch)
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (LocksIndex.IsValid())
+		{
+			TArray<FPlasticSourceControlLockRef> Locks = LocksIndex->GetLocks();
+			if (InPatch(Locks))
+			{
+				LocksIndex = MakeShared<const FPlasticSourceControlLocksIndex, ESPMode::ThreadSafe>(Locks);
+				Generation++;
+			}
+		}
+	}
+
+	/** The index of locks even if expired, or null if never listed (or invalidated) */
+	const FPlasticSourceControlLocksIndexPtr& GetLocksIndex() const
+	{
+		return LocksIndex;
+	}
+
+	/** Incremented on each change of the locks, to detect a change made while a new list was being retrieved */
+	uint32 GetGeneration() const
+	{
+		return Generation;
+	}
+
 public:
 	FCriticalSection CriticalSection;
 
 private:
-	TArray<FPlasticSourceControlLockRef> Locks;
+	FPlasticSourceControlLocksIndexPtr LocksIndex;
 	FDateTime Timestamp;
+	uint32 Generation = 0;
 };
 
 static FLocksCache LocksCacheForAllDestBranches;
@@ -532,35 +671,50 @@ void InvalidateLocksCache()
 	LocksCacheForWorkingBranch.Reset();
 }
 
-bool RunListLocks(const FPlasticSourceControlProvider& InProvider, const bool bInForAllDestBranches, TArray<FPlasticSourceControlLockRef>& OutLocks)
+// Apply the same patch to both caches of locks
+static void PatchLocksCaches(TFunctionRef<bool(TArray<FPlasticSourceControlLockRef>& InOutLocks)> InPatch)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlUtils::RunListLocks);
-
-	FLocksCache& LocksCache = bInForAllDestBranches ? LocksCacheForAllDestBranches : LocksCacheForWorkingBranch;
-
-	FScopeLock ScopeLock(&LocksCache.CriticalSection);
+	LocksCacheForAllDestBranches.PatchLocks(InPatch);
+	LocksCacheForWorkingBranch.PatchLocks(InPatch);
+}
 
-	if (LocksCache.GetLocks(OutLocks))
-		return true;
+// All the suffixes of the absolute paths of files starting with a slash, that is all the server paths they could match (see FPlasticSourceControlLocksIndex::FindBySuffix())
+static TSet<FString> GetServerPathCandidates(const TArray<FString>& InFiles)
+{
+	TSet<FString> ServerPaths;
+	for (const FString& File : InFiles)
+	{
+		for (int32 SlashIndex = File.Len() - 1; SlashIndex >= 0; SlashIndex--)
+		{
+			if (File[SlashIndex] == TEXT('/'))
+			{
+				ServerPaths.Add(File.RightChop(SlashIndex));
+			}
+		}
+	}
+	return ServerPaths;
+}
 
+// Run a Plastic "lock list" command and parse it, restricted to the locks applying to a working branch if specified, and to some files if any
+static bool RunListLocksCommand(const FString& InRepositorySpecification, const FString& InWorkingBranch, const TArray<FString>& InFiles, TArray<FPlasticSourceControlLockRef>& OutLocks)
+{
 	TArray<FString> Results;
 	TArray<FString> ErrorMessages;
 	TArray<FString> Parameters;
 	Parameters.Add(TEXT("list"));
 	Parameters.Add(TEXT("--machinereadable"));
 	Parameters.Add(TEXT("--smartlocks"));
-	Parameters.Add(FString::Printf(TEXT("--repository=\"%s\""), *InProvider.GetRepositorySpecification()));
+	Parameters.Add(FString::Printf(TEXT("--repository=\"%s\""), *InRepositorySpecification));
 	Parameters.Add(TEXT("--anystatus"));
 	Parameters.Add(TEXT("--fieldseparator=\"") FILE_STATUS_SEPARATOR TEXT("\""));
 	// NOTE: --dateformat was added to smartlocks a couple of releases later in version 11.0.16.8133
 	Parameters.Add(TEXT("--dateformat=yyyy-MM-ddTHH:mm:ss"));
-	// For displaying Locks as a status overlay icon in the Content Browser, restricts the Locks to only those applying to the current branch so there can be only one and never any ambiguity
-	if (!bInForAllDestBranches && (InProvider.GetPlasticScmVersion() >= PlasticSourceControlVersions::WorkingBranch))
+	if (!InWorkingBranch.IsEmpty())
 	{
 		// Note: here is one of the rare places where we need to use a branch name, not a workspace selector
-		Parameters.Add(FString::Printf(TEXT("--workingbranch=\"%s\""), *InProvider.GetBranchName()));
+		Parameters.Add(FString::Printf(TEXT("--workingbranch=\"%s\""), *InWorkingBranch));
 	}
-	const bool bResult = RunCommand(TEXT("lock"), Parameters, TArray<FString>(), Results, ErrorMessages);
+	const bool bResult = RunCommand(TEXT("lock"), Parameters, InFiles, Results, ErrorMessages);
 
 	if (bResult)
 	{
@@ -571,56 +725,518 @@ bool RunListLocks(const FPlasticSourceControlProvider& InProvider, const bool bI
 			FPlasticSourceControlLock&& Lock = PlasticSourceControlParsers::ParseLockInfo(Result);
 			OutLocks.Add(MakeShareable(new FPlasticSourceControlLock(Lock)));
 		}
+	}
+
+	return bResult;
+}
+
+// The working branch to restrict the locks to, for displaying Locks as a status overlay icon in the Content Browser, so there can be only one and never any ambiguity
+static FString GetLocksWorkingBranch(const FPlasticSourceControlProvider& InProvider, const bool bInForAllDestBranches)
+{
+	if (!bInForAllDestBranches && (InProvider.GetPlasticScmVersion() >= PlasticSourceControlVersions::WorkingBranch))
+	{
+		return InProvider.GetBranchName();
+	}
+	return FString();
+}
+
+// Replace the locks of a cache by the ones listed for some files, removing the previous locks for which InIsReplaced returns true
+static void ReplaceLocksInCache(FLocksCache& InOutLocksCache, const TArray<FPlasticSourceControlLockRef>& InLocks, TFunctionRef<bool(const FPlasticSourceControlLock& InLock)> InIsReplaced)
+{
+	InOutLocksCache.PatchLocks([&](TArray<FPlasticSourceControlLockRef>& InOutLocks)
+	{
+		const int32 NumRemoved = InOutLocks.RemoveAll([&InIsReplaced](const FPlasticSourceControlLockRef& InLock)
+		{
+			return InIsReplaced(*InLock);
+		});
+		InOutLocks.Append(InLocks);
+		return (NumRemoved > 0) || (InLocks.Num() > 0);
+	});
+}
+
+void UpdateLocksCacheOnCheckOut(const FPlasticSourceControlProvider& InProvider, const TArray<FString>& InFiles)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlUtils::UpdateLocksCacheOnCheckOut);
+
+	// Nothing to patch if the locks were never listed: the next status will list them
+	auto IsListed = [](FLocksCache& InLocksCache)
+	{
+		FScopeLock ScopeLock(&InLocksCache.CriticalSection);
+		return InLocksCache.GetLocksIndex().IsValid();
+	};
+	if (!IsListed(LocksCacheForAllDestBranches) && !IsListed(LocksCacheForWorkingBranch))
+	{
+		return;
+	}
+
+	// Only the server knows which files are lockable, so list the locks of the checked-out files, including the new ones taken by the checkout,
+	// with a single "lock list" of these files restricted to the working branch (much cheaper than listing all the locks again)
+	const FString WorkingBranch = GetLocksWorkingBranch(InProvider, false);
+	TArray<FPlasticSourceControlLockRef> FilesLocks;
+	if (!RunListLocksCommand(InProvider.GetRepositorySpecification(), WorkingBranch, InFiles, FilesLocks))
+	{
+		InvalidateLocksCache();
+		return;
+	}
+
+	TSet<FString> ServerPaths;
+	ServerPaths.Reserve(FilesLocks.Num());
+	for (const FPlasticSourceControlLockRef& Lock : FilesLocks)
+	{
+		ServerPaths.Add(Lock->Path);
+	}
+	ReplaceLocksInCache(LocksCacheForWorkingBranch, FilesLocks, [&ServerPaths](const FPlasticSourceControlLock& InLock)
+	{
+		return ServerPaths.Contains(InLock.Path);
+	});
+
+	if (WorkingBranch.IsEmpty())
+	{
+		// Without a working branch, the list is the same for all destination branches
+		ReplaceLocksInCache(LocksCacheForAllDestBranches, FilesLocks, [&ServerPaths](const FPlasticSourceControlLock& InLock)
+		{
+			return ServerPaths.Contains(InLock.Path);
+		});
+		return;
+	}
+
+	// The checkout only took locks from this workspace on its branch: the locks of these files applying to other branches are left as they are,
+	// until the next background refresh of the locks (see FPlasticSourceControlProvider::TickLocksRefresh())
+	const FString& BranchName = InProvider.GetBranchName();
+	const FString& WorkspaceName = InProvider.GetWorkspaceName();
+	TArray<FPlasticSourceControlLockRef> OwnLocks = FilesLocks.FilterByPredicate([&BranchName, &WorkspaceName](const FPlasticSourceControlLockRef& InLock)
+	{
+		return (InLock->Branch == BranchName) && (InLock->Workspace == WorkspaceName);
+	});
+	ReplaceLocksInCache(LocksCacheForAllDestBranches, OwnLocks, [&ServerPaths, &BranchName, &WorkspaceName](const FPlasticSourceControlLock& InLock)
+	{
+		return ServerPaths.Contains(InLock.Path) && (InLock.Branch == BranchName) && (InLock.Workspace == WorkspaceName);
+	});
+}
+
+void UpdateLocksCacheOnCheckIn(const FPlasticSourceControlProvider& InProvider, const TArray<FString>& InFiles)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlUtils::UpdateLocksCacheOnCheckIn);
+
+	const TSet<FString> ServerPaths = GetServerPathCandidates(InFiles);
+	const FString& BranchName = InProvider.GetBranchName();
+	const FString& WorkspaceName = InProvider.GetWorkspaceName();
+
+	// The locks taken in this workspace on the checked-in files are released if the changes reached their destination branch,
+	// else they are "Retained" on the current branch until the changes are merged to their destination branch
+	PatchLocksCaches([&](TArray<FPlasticSourceControlLockRef>& InOutLocks)
+	{
+		bool bPatched = false;
+		for (int32 LockIndex = InOutLocks.Num() - 1; LockIndex >= 0; LockIndex--)
+		{
+			const FPlasticSourceControlLockRef& Lock = InOutLocks[LockIndex];
+			if (Lock->bIsLocked && (Lock->Branch == BranchName) && (Lock->Workspace == WorkspaceName) && ServerPaths.Contains(Lock->Path))
+			{
+				if (Lock->DestinationBranch == BranchName)
+				{
+					InOutLocks.RemoveAt(LockIndex);
+				}
+				else
+				{
+					FPlasticSourceControlLockRef NewLock = MakeShared<FPlasticSourceControlLock, ESPMode::ThreadSafe>(*Lock);
+					NewLock->Status = TEXT("Retained");
+					NewLock->bIsLocked = false;
+					InOutLocks[LockIndex] = MoveTemp(NewLock);
+				}
+				bPatched = true;
+			}
+		}
+		return bPatched;
+	});
+}
+
+void UpdateLocksCacheOnUnlock(const TArray<FPlasticSourceControlLockRef>& InLocks, const bool bInRemove)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlUtils::UpdateLocksCacheOnUnlock);
+
+	// Locks are unlocked by item id for the branch they were taken on (see FPlasticUnlockWorker)
+	TSet<TTuple<int32, FString>> UnlockedItems;
+	UnlockedItems.Reserve(InLocks.Num());
+	for (const FPlasticSourceControlLockRef& Lock : InLocks)
+	{
+		UnlockedItems.Add(MakeTuple(Lock->ItemId, Lock->Branch));
+	}
+
+	// Removing a lock removes it whatever its status, while releasing a lock only affects it if "Locked":
+	// it then falls back to "Retained" only if changes were already checked in the branch, which is only known by the server,
+	// so a released lock is removed from the cache, and gets back from the next refresh of the cache if it is still "Retained"
+	PatchLocksCaches([&](TArray<FPlasticSourceControlLockRef>& InOutLocks)
+	{
+		const int32 NumRemoved = InOutLocks.RemoveAll([&](const FPlasticSourceControlLockRef& InLock)
+		{
+			return (bInRemove || InLock->bIsLocked) && UnlockedItems.Contains(MakeTuple(InLock->ItemId, InLock->Branch));
+		});
+		return NumRemoved > 0;
+	});
+}
 
-		LocksCache.SetLocks(OutLocks);
+bool RunListLocks(const FPlasticSourceControlProvider& InProvider, const bool bInForAllDestBranches, TArray<FPlasticSourceControlLockRef>& OutLocks)
+{
+	FPlasticSourceControlLocksIndexPtr LocksIndex;
+	const bool bResult = RunListLocks(InProvider, bInForAllDestBranches, LocksIndex);
+	if (LocksIndex.IsValid())
+	{
+		OutLocks = LocksIndex->GetLocks();
+	}
+	return bResult;
+}
+
+bool RunListLocks(const FPlasticSourceControlProvider& InProvider, const bool bInForAllDestBranches, FPlasticSourceControlLocksIndexPtr& OutLocksIndex)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlUtils::RunListLocks);
+
+	FLocksCache& LocksCache = bInForAllDestBranches ? LocksCacheForAllDestBranches : LocksCacheForWorkingBranch;
+
+	FScopeLock ScopeLock(&LocksCache.CriticalSection);
+
+	if (LocksCache.GetLocks(OutLocksIndex))
+		return true;
+
+	TArray<FPlasticSourceControlLockRef> Locks;
+	const bool bResult = RunListLocksCommand(InProvider.GetRepositorySpecification(), GetLocksWorkingBranch(InProvider, bInForAllDestBranches), TArray<FString>(), Locks);
+	if (bResult)
+	{
+		LocksCache.SetLocks(Locks);
+		LocksCache.GetLocks(OutLocksIndex);
+
+		UE_LOG(LogSourceControl, Verbose, TEXT("RunListLocks: %d locks"), Locks.Num());
+	}
+
+	return bResult;
+}
+
+static bool AreSameLocks(const TArray<FPlasticSourceControlLockRef>& InLocks, const TArray<FPlasticSourceControlLockRef>& InOtherLocks)
+{
+	if (InLocks.Num() != InOtherLocks.Num())
+	{
+		return false;
+	}
+	for (int32 LockIndex = 0; LockIndex < InLocks.Num(); LockIndex++)
+	{
+		const FPlasticSourceControlLock& Lock = *InLocks[LockIndex];
+		const FPlasticSourceControlLock& OtherLock = *InOtherLocks[LockIndex];
+		if ((Lock.ItemId != OtherLock.ItemId) || (Lock.Status != OtherLock.Status) || (Lock.Date != OtherLock.Date)
+			|| (Lock.Owner != OtherLock.Owner) || (Lock.Workspace != OtherLock.Workspace)
+			|| (Lock.Branch != OtherLock.Branch) || (Lock.DestinationBranch != OtherLock.DestinationBranch))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool RefreshLocksCache(const FString& InRepositorySpecification, const FString& InWorkingBranch, TArray<FString>& OutChangedPaths)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlUtils::RefreshLocksCache);
+
+	FLocksCache& LocksCache = LocksCacheForWorkingBranch;
+
+	uint32 Generation;
+	{
+		FScopeLock ScopeLock(&LocksCache.CriticalSection);
+		// Nothing to refresh if the locks were never listed: the next status will list them
+		if (!LocksCache.GetLocksIndex().IsValid())
+		{
+			return false;
+		}
+		Generation = LocksCache.GetGeneration();
+	}
+
+	// Retrieve the new list of locks without holding the cache, so that the status of files is not blocked in the meantime
+	TArray<FPlasticSourceControlLockRef> Locks;
+	if (!RunListLocksCommand(InRepositorySpecification, InWorkingBranch, TArray<FString>(), Locks))
+	{
+		return false;
+	}
+
+	FScopeLock ScopeLock(&LocksCache.CriticalSection);
+	// Discard the new list if the cache changed in the meantime (patched by a local operation, or invalidated), since it might predate the change
+	if (LocksCache.GetGeneration() != Generation)
+	{
+		UE_LOG(LogSourceControl, Verbose, TEXT("RefreshLocksCache: discarded, the cache changed in the meantime"));
+		return false;
+	}
+
+	const FPlasticSourceControlLocksIndexPtr PreviousLocksIndex = LocksCache.GetLocksIndex();
+	LocksCache.SetLocks(Locks);
+	const FPlasticSourceControlLocksIndexPtr& LocksIndex = LocksCache.GetLocksIndex();
+
+	// Diff the locks of each server path, from either the previous or the new list
+	TSet<FString> ServerPaths;
+	ServerPaths.Reserve(PreviousLocksIndex->GetLocks().Num() + Locks.Num());
+	for (const FPlasticSourceControlLockRef& Lock : PreviousLocksIndex->GetLocks())
+	{
+		ServerPaths.Add(Lock->Path);
+	}
+	for (const FPlasticSourceControlLockRef& Lock : Locks)
+	{
+		ServerPaths.Add(Lock->Path);
+	}
+	for (const FString& ServerPath : ServerPaths)
+	{
+		if (!AreSameLocks(PreviousLocksIndex->FindByPath(ServerPath), LocksIndex->FindByPath(ServerPath)))
+		{
+			OutChangedPaths.Add(ServerPath);
+		}
+	}
+
+	UE_LOG(LogSourceControl, Verbose, TEXT("RefreshLocksCache: %d locks, %d paths changed"), Locks.Num(), OutChangedPaths.Num());
+
+	return true;
+}
+
+// Local files of the server paths of the repository of the workspace, as reported by "fileinfo" (see UpdateCachedLocks())
+static FRWLock LocalFilesByServerPathLock;
+static TMap<FString, FString> LocalFilesByServerPath;
+
+void AddServerPath(const FString& InServerPath, const FString& InFilename)
+{
+	FWriteScopeLock WriteLock(LocalFilesByServerPathLock);
+	LocalFilesByServerPath.Add(InServerPath, InFilename);
+}
+
+void ResetServerPaths()
+{
+	FWriteScopeLock WriteLock(LocalFilesByServerPathLock);
+	LocalFilesByServerPath.Empty();
+}
+
+bool UpdateCachedLocks(const TArray<FString>& InChangedPaths)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlUtils::UpdateCachedLocks);
+
+	if (InChangedPaths.Num() == 0)
+	{
+		return false;
+	}
+
+	FPlasticSourceControlLocksIndexPtr LocksIndex;
+	{
+		FScopeLock ScopeLock(&LocksCacheForWorkingBranch.CriticalSection);
+		LocksIndex = LocksCacheForWorkingBranch.GetLocksIndex();
+	}
+	if (!LocksIndex.IsValid())
+	{
+		return false;
+	}
+
+	FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
+	const FString& BranchName = Provider.GetBranchName();
+
+	bool bUpdatedStates = false;
+	for (const FString& ServerPath : InChangedPaths)
+	{
+		// Only update the files already in the cache, with "fileinfo" information, since they are the only ones with meaningful locks (see IsFileinfoRequired())
+		// Note: the local file of a server path is the one reported by "fileinfo", since it is not under the workspace root for files under an xlink
+		FString LocalFile;
+		{
+			FReadScopeLock ReadLock(LocalFilesByServerPathLock);
+			if (const FString* Found = LocalFilesByServerPath.Find(ServerPath))
+			{
+				LocalFile = *Found;
+			}
+		}
+		if (LocalFile.IsEmpty())
+		{
+			continue;
+		}
+		const TSharedPtr<FPlasticSourceControlState, ESPMode::ThreadSafe> State = Provider.FindStateInternal(LocalFile);
+		if (State.IsValid() && (State->DepotRevisionChangeset != ISourceControlState::INVALID_REVISION))
+		{
+			const FPlasticSourceControlInternedString PreviousLockedBy = State->LockedBy;
+			const FPlasticSourceControlInternedString PreviousRetainedBy = State->RetainedBy;
+			PlasticSourceControlParsers::ParseLocks(LocksIndex->FindByPath(ServerPath), BranchName, *State);
+			if ((State->LockedBy != PreviousLockedBy) || (State->RetainedBy != PreviousRetainedBy))
+			{
+				bUpdatedStates = true;
+			}
+		}
+	}
+
+	return bUpdatedStates;
+}
+
+TArray<FPlasticSourceControlLockRef> GetLocksForWorkingBranch(const FPlasticSourceControlProvider& InProvider, const TArray<FString>& InFiles)
+{
+	FPlasticSourceControlLocksIndexPtr LocksIndex;
+
+	// Only get locks for the current working branch
+	const bool bInForAllDestBranches = false;
+	RunListLocks(InProvider, bInForAllDestBranches, LocksIndex);
+
+	TArray<FPlasticSourceControlLockRef> MatchingLocks;
+	if (!LocksIndex.IsValid())
+	{
+		return MatchingLocks;
+	}
+	MatchingLocks.Reserve(InFiles.Num());
+
+	// Only return locks for the specified files (the server path of the lock ends the absolute path of the file)
+	for (const FString& File : InFiles)
+	{
+		if (const FPlasticSourceControlLockPtr Lock = LocksIndex->FindBySuffix(File))
+		{
+			MatchingLocks.Add(Lock.ToSharedRef());
+		}
+	}
+
+	return MatchingLocks;
+}
+
+TArray<FString> LocksToFileNames(const FString InWorkspaceRoot, const TArray<FPlasticSourceControlLockRef>& InLocks)
+{
+	TArray<FString> Files;
+
+	// Note: remove the slash '/' from the end of the Workspace root to Combine it with server paths also starting with a slash
+	const FString& WorkspaceRoot = InWorkspaceRoot[InWorkspaceRoot.Len() - 1] == TEXT('/') ? InWorkspaceRoot.LeftChop(1) : InWorkspaceRoot;
+
+	Files.Reserve(InLocks.Num());
+	for (const FPlasticSourceControlLockRef& Lock : InLocks)
+	{
+		Files.AddUnique(FPaths::Combine(WorkspaceRoot, Lock->Path));
+	}
+
+	return Files;
+}
+
+// Tells if a "fileinfo" command is required to complete the state of a file gathered by the "status" command
+static bool IsFileinfoRequired(const FPlasticSourceControlState& InState, const bool bInWholeDirectory, const bool bInUpdateHistory)
+{
+	// 1) Issue a "fileinfo" command for controlled files (to know if they are up to date and can be checked-out or checked-in)
+	// but only if controlled unchanged, or locally changed / locally deleted,
+	// optimizing for files that are CheckedOut/Added/Deleted/Moved/Copied/Replaced/NotControled/Ignored/Private/Unknown
+	// (since there is no point to check if they are up to date in these cases; they are already checked-out or not controlled).
+	// This greatly reduce the time needed to do some operations like "Add" or "Move/Rename/Copy" when there is some latency with the server (eg cloud).
+	//
+	// 2) bInWholeDirectory: In the case of a "whole directory status" triggered by the "Submit Content" operation,
+	// don't even issue a "fileinfo" command for unchanged Controlled files since they won't be considered them for submit.
+	// This greatly reduce the time needed to open the Submit window.
+	//
+	// 3) bInUpdateHistory: When the plugin needs to update the history of files, it needs to know if it's on a XLink,
+	// so the fileinfo command is required here to get the RepSpec
+	return bInUpdateHistory
+		|| ((InState.WorkspaceState == EWorkspaceState::Controlled) && !bInWholeDirectory)
+		||	(InState.WorkspaceState == EWorkspaceState::Changed)
+		||	(InState.WorkspaceState == EWorkspaceState::LocallyDeleted);
+}
+
+// Maximum number of characters of file paths listed on the command line of one chunk of a "fileinfo" or "history" command
+static const int32 ChunkMaxCommandLineLength = 64 * 1024;
+
+/**
+ * Adaptive number of files given to each chunk of a command, tuned from the latency per file observed on previous chunks.
+ *
+ * Aims for chunks taking a few seconds each, to report progress regularly and stay far from the inactivity timeout of the 'cm shell'.
+ */
+class FCommandChunkSize
+{
+public:
+	static constexpr int32 MinFiles = 20;
+	static constexpr int32 MaxFiles = 2000;
+	static constexpr double TargetSeconds = 5.0;
+
+	int32 GetMaxFiles() const
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (SecondsPerFile <= 0.0)
+		{
+			return MaxFiles / 4;
+		}
+		return FMath::Clamp(static_cast<int32>(TargetSeconds / SecondsPerFile), MinFiles, MaxFiles);
+	}
+
+	void AddMeasure(const int32 InNumFiles, const double InElapsedSeconds)
+	{
+		if (InNumFiles <= 0)
+			return;
 
-		UE_LOG(LogSourceControl, Verbose, TEXT("RunListLocks: %d locks"), OutLocks.Num());
+		FScopeLock Lock(&CriticalSection);
+		const double Measure = InElapsedSeconds / InNumFiles;
+		// Exponential moving average, to follow changes of latency with the server without jumping on one outlier
+		SecondsPerFile = (SecondsPerFile <= 0.0) ? Measure : FMath::Lerp(SecondsPerFile, Measure, 0.25);
 	}
 
-	return bResult;
-}
-
-TArray<FPlasticSourceControlLockRef> GetLocksForWorkingBranch(const FPlasticSourceControlProvider& InProvider, const TArray<FString>& InFiles)
-{
-	TArray<FPlasticSourceControlLockRef> Locks;
+private:
+	mutable FCriticalSection CriticalSection;
+	double SecondsPerFile = 0.0;
+};
 
-	// Only get locks for the current working branch
-	const bool bInForAllDestBranches = false;
-	RunListLocks(InProvider, bInForAllDestBranches, Locks);
+static FCommandChunkSize FileinfoChunkSize;
+static FCommandChunkSize HistoryChunkSize;
 
-	TArray<FPlasticSourceControlLockRef> MatchingLocks;
-	MatchingLocks.Reserve(InFiles.Num());
+/**
+ * Run a command on a list of file states split in consecutive chunks, bounded both by the length of their command line and by their number of files.
+ *
+ * Chunks run concurrently on the pool of 'cm shell' (from the dedicated pool of threads running commands), then their states are merged back into InOutStates in their original order.
+ *
+ * @param			InChunkSize			Adaptive number of files per chunk for this command
+ * @param			InIsSelected		Tells if the file of a state is to be listed on the command line (other states are only carried along in their chunk)
+ * @param			InRunChunk			Run the command on the files of a chunk, updating their states
+ * @param[out]		OutErrorMessages	Error messages of all the chunks
+ * @param[in,out]	InOutStates			States to split in chunks, updated by the command
+ */
+static bool RunCommandInChunks(FCommandChunkSize& InChunkSize, const TFunctionRef<bool(const FPlasticSourceControlState&)> InIsSelected, const TFunctionRef<bool(const TArray<FString>& InFiles, TArray<FPlasticSourceControlState>& InOutChunkStates, TArray<FString>& OutChunkErrorMessages)> InRunChunk, TArray<FString>& OutErrorMessages, TArray<FPlasticSourceControlState>& InOutStates)
+{
+	struct FChunk
+	{
+		TArray<FString> Files;
+		TArray<FPlasticSourceControlState> States;
+		TArray<FString> ErrorMessages;
+		bool bOk = true;
+	};
+	TArray<FChunk> Chunks;
 
-	// Only return locks for the specified files
-	for (const FString& File : InFiles)
+	const int32 MaxFiles = InChunkSize.GetMaxFiles();
+	int32 CommandLineLength = 0;
+	for (FPlasticSourceControlState& State : InOutStates)
 	{
-		for (const FPlasticSourceControlLockRef& Lock : Locks)
+		const bool bIsSelected = InIsSelected(State);
+		// quotes and space around each file path
+		const int32 FileLength = State.LocalFilename.Len() + 3;
+		if ((Chunks.Num() == 0) || (bIsSelected && ((Chunks.Last().Files.Num() >= MaxFiles) || (CommandLineLength + FileLength > ChunkMaxCommandLineLength))))
 		{
-			if (File.EndsWith(Lock->Path))
-			{
-				MatchingLocks.Add(Lock);
-				break;
-			}
+			Chunks.AddDefaulted();
+			CommandLineLength = 0;
+		}
+		if (bIsSelected)
+		{
+			Chunks.Last().Files.Add(State.LocalFilename);
+			CommandLineLength += FileLength;
 		}
+		Chunks.Last().States.Add(MoveTemp(State));
 	}
+	InOutStates.Reset();
 
-	return MatchingLocks;
-}
-
-TArray<FString> LocksToFileNames(const FString InWorkspaceRoot, const TArray<FPlasticSourceControlLockRef>& InLocks)
-{
-	TArray<FString> Files;
+	if (Chunks.Num() > 1)
+	{
+		UE_LOG(LogSourceControl, Verbose, TEXT("RunCommandInChunks: %d chunks of up to %d files"), Chunks.Num(), MaxFiles);
+	}
 
-	// Note: remove the slash '/' from the end of the Workspace root to Combine it with server paths also starting with a slash
-	const FString& WorkspaceRoot = InWorkspaceRoot[InWorkspaceRoot.Len() - 1] == TEXT('/') ? InWorkspaceRoot.LeftChop(1) : InWorkspaceRoot;
+	PlasticSourceControlShell::ParallelForCommands(Chunks.Num(), [&Chunks, &InChunkSize, &InRunChunk](const int32 InIndex)
+	{
+		FChunk& Chunk = Chunks[InIndex];
+		if (Chunk.Files.Num() > 0)
+		{
+			// Only measure the time spent by the command in a shell, not the time waiting for a shell to be available
+			const double StartCommandsTime = PlasticSourceControlShell::GetThreadCommandsTime();
+			Chunk.bOk = InRunChunk(Chunk.Files, Chunk.States, Chunk.ErrorMessages);
+			InChunkSize.AddMeasure(Chunk.Files.Num(), PlasticSourceControlShell::GetThreadCommandsTime() - StartCommandsTime);
+		}
+	});
 
-	Files.Reserve(InLocks.Num());
-	for (const FPlasticSourceControlLockRef& Lock : InLocks)
+	bool bResult = true;
+	for (FChunk& Chunk : Chunks)
 	{
-		Files.AddUnique(FPaths::Combine(WorkspaceRoot, Lock->Path));
+		bResult &= Chunk.bOk;
+		OutErrorMessages.Append(MoveTemp(Chunk.ErrorMessages));
+		InOutStates.Append(MoveTemp(Chunk.States));
 	}
-
-	return Files;
+	return bResult;
 }
 
 /**
@@ -638,31 +1254,13 @@ static bool RunFileinfo(const bool bInWholeDirectory, const bool bInUpdateHistor
 	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlUtils::RunFileinfo);
 
 	bool bResult = true;
-	TArray<FString> SelectedFiles;
 
 	TArray<FPlasticSourceControlState> SelectedStates;
 	TArray<FPlasticSourceControlState> OptimizedStates;
 	for (FPlasticSourceControlState& State : InOutStates)
 	{
-		// 1) Issue a "fileinfo" command for controlled files (to know if they are up to date and can be checked-out or checked-in)
-		// but only if controlled unchanged, or locally changed / locally deleted,
-		// optimizing for files that are CheckedOut/Added/Deleted/Moved/Copied/Replaced/NotControled/Ignored/Private/Unknown
-		// (since there is no point to check if they are up to date in these cases; they are already checked-out or not controlled).
-		// This greatly reduce the time needed to do some operations like "Add" or "Move/Rename/Copy" when there is some latency with the server (eg cloud).
-		//
-		// 2) bInWholeDirectory: In the case of a "whole directory status" triggered by the "Submit Content" operation,
-		// don't even issue a "fileinfo" command for unchanged Controlled files since they won't be considered them for submit.
-		// This greatly reduce the time needed to open the Submit window.
-		//
-		// 3) bInUpdateHistory: When the plugin needs to update the history of files, it needs to know if it's on a XLink,
-		// so the fileinfo command is required here to get the RepSpec
-		if (bInUpdateHistory
-			|| ((State.WorkspaceState == EWorkspaceState::Controlled) && !bInWholeDirectory)
-			||	(State.WorkspaceState == EWorkspaceState::Changed)
-			||	(State.WorkspaceState == EWorkspaceState::LocallyDeleted)
-			)
-		{
-			SelectedFiles.Add(State.LocalFilename);
+		if (IsFileinfoRequired(State, bInWholeDirectory, bInUpdateHistory))
+		{
 			SelectedStates.Add(MoveTemp(State));
 		}
 		else
@@ -674,31 +1272,47 @@ static bool RunFileinfo(const bool bInWholeDirectory, const bool bInUpdateHistor
 
 	if (SelectedStates.Num())
 	{
-		TArray<FString> Results;
-		TArray<FString> ErrorMessages;
-		TArray<FString> Parameters;
-		Parameters.Add(TEXT("--format=\"{RevisionChangeset};{RevisionHeadChangeset};{RepSpec};{LockedBy};{LockedWhere};{ServerPath}\""));
-		bResult = RunCommand(TEXT("fileinfo"), Parameters, SelectedFiles, Results, ErrorMessages);
-		OutErrorMessages.Append(MoveTemp(ErrorMessages));
-		if (bResult)
+		// Split a big selection of files in chunks to bound the length of each command line and the time without any result
+		bResult = RunCommandInChunks(FileinfoChunkSize, [](const FPlasticSourceControlState&) { return true; },
+			[](const TArray<FString>& InFiles, TArray<FPlasticSourceControlState>& InOutChunkStates, TArray<FString>& OutChunkErrorMessages)
 		{
-			PlasticSourceControlParsers::ParseFileinfoResults(Results, SelectedStates);
-			InOutStates.Append(MoveTemp(SelectedStates));
-		}
+			// Parse each line of result into its file state as soon as it is received
+			PlasticSourceControlParsers::FFileinfoResultsParser FileinfoParser(InOutChunkStates);
+			TArray<FString> Parameters;
+			Parameters.Add(TEXT("--format=\"{RevisionChangeset};{RevisionHeadChangeset};{RepSpec};{LockedBy};{LockedWhere};{ServerPath}\""));
+			const bool bChunkResult = RunCommand(TEXT("fileinfo"), Parameters, InFiles, [&FileinfoParser](FString&& InResult) { FileinfoParser.ParseLine(InResult); }, OutChunkErrorMessages);
+			if (bChunkResult)
+			{
+				FileinfoParser.Finish();
+			}
+			else
+			{
+				// Don't report the states of the files for which the fileinfo is missing
+				InOutChunkStates.Reset();
+			}
+			return bChunkResult;
+		}, OutErrorMessages, SelectedStates);
+		InOutStates.Append(MoveTemp(SelectedStates));
 	}
 
 	return bResult;
 }
 
+// Path to the file describing the merge in progress in the workspace, if any
+static FString GetMergeProgressFilename()
+{
+	const FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
+	return FPaths::Combine(*Provider.GetPathToWorkspaceRoot(), TEXT(".plastic/plastic.mergeprogress"));
+}
+
 // Check if merging, and from which changelist, then execute a cm merge command to amend status for listed files
 static bool RunCheckMergeStatus(const TArray<FString>& InFiles, TArray<FString>& OutErrorMessages, TArray<FPlasticSourceControlState>& OutStates)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlUtils::RunCheckMergeStatus);
 
 	bool bResult = false;
-	const FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
 
-	const FString MergeProgressFilename = FPaths::Combine(*Provider.GetPathToWorkspaceRoot(), TEXT(".plastic/plastic.mergeprogress"));
+	const FString MergeProgressFilename = GetMergeProgressFilename();
 	if (FPaths::FileExists(MergeProgressFilename))
 	{
 		// read in file as string
@@ -807,6 +1421,217 @@ FString FindCommonDirectory(const FString& InPath1, const FString& InPath2)
 	return InPath1.Left(IndexAfterLastCommonSeparator);
 }
 
+// Number of files requiring a "fileinfo" command in each batch of states going through the FUpdateStatusPipeline
+static const int32 UpdateStatusPipelineBatchSize = 200;
+
+/**
+ * Pipeline of "fileinfo" and "history" commands running behind a "status" command, on batches of file states.
+ *
+ * The states are queued as soon as the "status" command gives them, and each batch then goes through a "fileinfo" stage
+ * followed by an optional "history" stage. Each stage runs on its own task (and thus on its own 'cm shell' from the pool)
+ * while it has batches to process, so the three commands overlap instead of waiting for each other to complete on the whole selection.
+ */
+class FUpdateStatusPipeline
+{
+public:
+	FUpdateStatusPipeline(const bool bInWholeDirectory, const bool bInUpdateHistory, const bool bInGetHistory)
+		: bWholeDirectory(bInWholeDirectory)
+		, bUpdateHistory(bInUpdateHistory)
+		, StartTime(FPlatformTime::Seconds())
+	{
+		if (bInGetHistory)
+		{
+			HistoryStage = MakeUnique<FStage>([bInUpdateHistory](FBatch& InBatch)
+			{
+				return RunGetHistory(bInUpdateHistory, InBatch.States, InBatch.ErrorMessages);
+			}, nullptr);
+		}
+		FileinfoStage = MakeUnique<FStage>([bInWholeDirectory, bInUpdateHistory](FBatch& InBatch)
+		{
+			return RunFileinfo(bInWholeDirectory, bInUpdateHistory, InBatch.ErrorMessages, InBatch.States);
+		}, HistoryStage.Get());
+	}
+
+	~FUpdateStatusPipeline()
+	{
+		if (!bFinished)
+		{
+			TArray<FString> ErrorMessages;
+			TArray<FPlasticSourceControlState> States;
+			Finish(ErrorMessages, States);
+		}
+	}
+
+	// Queue the state of a file given by the "status" command, sending the current batch down the pipeline as soon as it is full
+	void AddState(FPlasticSourceControlState&& InState)
+	{
+		if (!PendingBatch.IsValid())
+		{
+			PendingBatch = MakeUnique<FBatch>();
+		}
+		if (IsFileinfoRequired(InState, bWholeDirectory, bUpdateHistory))
+		{
+			NumPendingFileinfo++;
+		}
+		PendingBatch->States.Add(MoveTemp(InState));
+		if (NumPendingFileinfo >= UpdateStatusPipelineBatchSize)
+		{
+			SendPendingBatch();
+		}
+	}
+
+	// Wait for all the batches to go through all the stages, then gather their results in order
+	bool Finish(TArray<FString>& OutErrorMessages, TArray<FPlasticSourceControlState>& OutStates)
+	{
+		check(!bFinished);
+		bFinished = true;
+
+		const double StatusTime = FPlatformTime::Seconds() - StartTime;
+		if (PendingBatch.IsValid())
+		{
+			SendPendingBatch();
+		}
+		// The fileinfo stage is done queuing batches to the history stage once all its tasks are done
+		FileinfoStage->Wait();
+		if (HistoryStage.IsValid())
+		{
+			HistoryStage->Wait();
+		}
+
+		bool bResult = true;
+		int32 NumStates = 0;
+		for (TUniquePtr<FBatch>& Batch : Batches)
+		{
+			bResult &= Batch->bOk;
+			NumStates += Batch->States.Num();
+			OutErrorMessages.Append(MoveTemp(Batch->ErrorMessages));
+			OutStates.Append(MoveTemp(Batch->States));
+		}
+
+		UE_LOG(LogSourceControl, Log, TEXT("UpdateStatus pipeline: %d states in %d batch(es): status %.3lfs, fileinfo %.3lfs, history %.3lfs (total %.3lfs)"),
+			NumStates, Batches.Num(), StatusTime, FileinfoStage->BusyTime, HistoryStage.IsValid() ? HistoryStage->BusyTime : 0.0, FPlatformTime::Seconds() - StartTime);
+
+		return bResult;
+	}
+
+private:
+	struct FBatch
+	{
+		TArray<FPlasticSourceControlState> States;
+		TArray<FString> ErrorMessages;
+		bool bOk = true;
+	};
+
+	// One stage of the pipeline, processing batches in order on a task started only when batches are queued, and ending once its queue is empty,
+	// before passing them to the next stage, so that no thread of the pool of commands is ever blocked waiting for batches
+	// (if no thread of the pool is available for the task, it runs when it is waited for, after all the batches are queued)
+	class FStage
+	{
+	public:
+		FStage(TFunction<bool(FBatch&)>&& InProcess, FStage* InNextStage)
+			: Process(MoveTemp(InProcess))
+			, NextStage(InNextStage)
+		{
+		}
+
+		~FStage()
+		{
+			Wait();
+		}
+
+		// Called by a single producer at a time: the "status" thread for the first stage, the task of the previous stage for the next one
+		void Enqueue(FBatch* InBatch)
+		{
+			Queue.Enqueue(InBatch);
+			if (!bRunning.exchange(true))
+			{
+				FScopeLock Lock(&TasksCriticalSection);
+				Tasks.Add(MakeUnique<PlasticSourceControlShell::FCommandTask>([this]() { Run(); }));
+			}
+		}
+
+		// Wait for the tasks of the stage, once the previous stage is done queuing batches
+		void Wait()
+		{
+			for (int32 TaskIndex = 0; ; TaskIndex++)
+			{
+				PlasticSourceControlShell::FCommandTask* Task = nullptr;
+				{
+					FScopeLock Lock(&TasksCriticalSection);
+					if (TaskIndex >= Tasks.Num())
+					{
+						break;
+					}
+					Task = Tasks[TaskIndex].Get();
+				}
+				Task->Wait();
+			}
+		}
+
+		// Time spent running commands, only written by the tasks of the stage, one at a time (read it after Wait())
+		double BusyTime = 0.0;
+
+	private:
+		void Run()
+		{
+			while (true)
+			{
+				FBatch* Batch = nullptr;
+				while (Queue.Dequeue(Batch))
+				{
+					// A batch that failed at a previous stage is only passed along
+					if (Batch->bOk)
+					{
+						const double BatchStartTime = FPlatformTime::Seconds();
+						Batch->bOk = Process(*Batch);
+						BusyTime += FPlatformTime::Seconds() - BatchStartTime;
+					}
+					if (NextStage)
+					{
+						NextStage->Enqueue(Batch);
+					}
+				}
+
+				// End the task, unless a batch has been queued meanwhile without starting a new task
+				bRunning = false;
+				if (Queue.IsEmpty() || bRunning.exchange(true))
+				{
+					break;
+				}
+			}
+		}
+
+		TFunction<bool(FBatch&)> Process;
+		FStage* NextStage;
+		TQueue<FBatch*, EQueueMode::Mpsc> Queue;
+		std::atomic<bool> bRunning{false};
+		FCriticalSection TasksCriticalSection;
+		TArray<TUniquePtr<PlasticSourceControlShell::FCommandTask>> Tasks;
+	};
+
+	void SendPendingBatch()
+	{
+		FBatch* Batch = PendingBatch.Get();
+		Batches.Add(MoveTemp(PendingBatch));
+		NumPendingFileinfo = 0;
+		FileinfoStage->Enqueue(Batch);
+	}
+
+	const bool bWholeDirectory;
+	const bool bUpdateHistory;
+	const double StartTime;
+	bool bFinished = false;
+
+	// Batches in the order of the "status" results, owned here while they go through the stages
+	TArray<TUniquePtr<FBatch>> Batches;
+	TUniquePtr<FBatch> PendingBatch;
+	int32 NumPendingFileinfo = 0;
+
+	// Declared in reverse order since the fileinfo stage passes its batches to the history stage
+	TUniquePtr<FStage> HistoryStage;
+	TUniquePtr<FStage> FileinfoStage;
+};
+
 // Structure to group all files belonging to a root dir, storing their best/longest common directory
 struct FFilesInCommonDir
 {
@@ -815,12 +1640,43 @@ struct FFilesInCommonDir
 	TArray<FString>	Files;
 };
 
-// Run a batch of Plastic "status" and "fileinfo" commands to update status of given files and directories.
-bool RunUpdateStatus(const TArray<FString>& InFiles, const EStatusSearchType InSearchType, const bool bInUpdateHistory, TArray<FString>& OutErrorMessages, TArray<FPlasticSourceControlState>& OutStates, int32& OutChangeset)
+// Run a batch of Plastic "status", "fileinfo" and "history" commands to update status and history of given files and directories.
+bool RunUpdateStatusAndHistory(const TArray<FString>& InFiles, const EStatusSearchType InSearchType, const bool bInUpdateHistory, const bool bInGetHistory, TArray<FString>& OutErrorMessages, TArray<FPlasticSourceControlState>& OutStates, int32& OutChangeset, bool& bOutGotHistory)
 {
 	bool bResults = true;
 
-	const FString& WorkspaceRoot = FPlasticSourceControlModule::Get().GetProvider().GetPathToWorkspaceRoot();
+	FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
+	const FString& WorkspaceRoot = Provider.GetPathToWorkspaceRoot();
+
+	// 0) Restrict the status of whole directories to the files changed on disk since their last full status, keeping the cached states of all other files
+	FPlasticSourceControlWorkspaceWatcher& WorkspaceWatcher = Provider.AccessWorkspaceWatcher();
+	TArray<FString> Files;
+	TArray<FString> FullStatusDirs;
+	bool bRestrictedStatus = false;
+	Files.Reserve(InFiles.Num());
+	for (const FString& File : InFiles)
+	{
+		const bool bIsDirectory = !File.IsEmpty() && (File[File.Len() - 1] == TEXT('/'));
+		if (bIsDirectory && (InSearchType == EStatusSearchType::All))
+		{
+			TArray<FString> DirtyFiles;
+			if (WorkspaceWatcher.ConsumeDirtyFiles(File, DirtyFiles))
+			{
+				UE_LOG(LogSourceControl, Verbose, TEXT("RunUpdateStatus: %d file(s) changed in %s since its last status"), DirtyFiles.Num(), *File);
+				Files.Append(MoveTemp(DirtyFiles));
+				bRestrictedStatus = true;
+				continue;
+			}
+			FullStatusDirs.Add(File);
+		}
+		Files.Add(File);
+	}
+	// Only the "status" command itself is skipped, the merge status and the history are still checked below
+	const bool bSkipStatus = bRestrictedStatus && (Files.Num() == 0);
+	if (bSkipStatus)
+	{
+		UE_LOG(LogSourceControl, Verbose, TEXT("RunUpdateStatus: no change on disk since the last status"));
+	}
 
 	// The "status" command only operate on one directory-tree at a time (whole tree recursively)
 	// not on different folders with no common root.
@@ -840,7 +1696,7 @@ bool RunUpdateStatus(const TArray<FString>& InFiles, const EStatusSearchType InS
 
 	// 1) So here we group files by path (ie. by subdirectory)
 	TMap<FString, FFilesInCommonDir> GroupOfFiles;
-	for (const FString& File : InFiles)
+	for (const FString& File : Files)
 	{
 		// Discard all file/paths that are not under the workspace root (typically excluding the Engine content)
 		if (!File.StartsWith(WorkspaceRoot))
@@ -894,45 +1750,125 @@ bool RunUpdateStatus(const TArray<FString>& InFiles, const EStatusSearchType InS
 		}
 	}
 
-	if (InFiles.Num() > 0)
+	if (Files.Num() > 0)
 	{
-		UE_LOG(LogSourceControl, Verbose, TEXT("RunUpdateStatus: %d file(s)/%d directory(ies) ('%s'...)"), InFiles.Num(), GroupOfFiles.Num(), *InFiles[0]);
+		UE_LOG(LogSourceControl, Verbose, TEXT("RunUpdateStatus: %d file(s)/%d directory(ies) ('%s'...)"), Files.Num(), GroupOfFiles.Num(), *Files[0]);
 	}
-	else
+	else if (!bSkipStatus)
 	{
 		UE_LOG(LogSourceControl, Warning, TEXT("RunUpdateStatus: NO file"));
 	}
 
 	// 2) then we can batch Plastic status operation by subdirectory
+	// The groups are independent, so they are processed concurrently (on the pool of 'cm shell' processes, from the dedicated pool of threads running commands)
+	// and their results are then merged in the same order as if they had been processed one after the other.
+	TArray<FFilesInCommonDir*> Groups;
+	Groups.Reserve(GroupOfFiles.Num());
 	for (auto& Group : GroupOfFiles)
 	{
-		const bool bWholeDirectory = ((Group.Value.Files.Num() == 1) && (Group.Value.CommonDir == Group.Value.Files[0]));
+		Groups.Add(&Group.Value);
+	}
 
-		// Run a "status" command on the directory to get workspace file states.
-		// (ie. Changed, CheckedOut, Copied, Replaced, Added, Private, Ignored, Deleted, LocallyDeleted, Moved, LocallyMoved)
+	struct FGroupResults
+	{
+		bool bGroupOk = true;
+		int32 Changeset = -1;
+		TArray<FString> ErrorMessages;
 		TArray<FPlasticSourceControlState> States;
-		const bool bGroupOk = RunStatus(Group.Value.CommonDir, MoveTemp(Group.Value.Files), InSearchType, OutErrorMessages, States, OutChangeset);
-		if (!bGroupOk)
+	};
+	TArray<FGroupResults> GroupsResults;
+	GroupsResults.SetNum(Groups.Num());
+
+	// For big selections and whole directories, "fileinfo" and "history" commands are pipelined behind the "status" commands (see FUpdateStatusPipeline)
+	bool bPipelined = (Files.Num() > UpdateStatusPipelineBatchSize);
+	for (const FFilesInCommonDir* Group : Groups)
+	{
+		bPipelined |= ((Group->Files.Num() == 1) && (Group->CommonDir == Group->Files[0]));
+	}
+	// but the history of files being merged depends on their conflicts, only known after RunCheckMergeStatus()
+	const bool bPipelinedHistory = bPipelined && bInGetHistory && !FPaths::FileExists(GetMergeProgressFilename());
+
+	PlasticSourceControlShell::ParallelForCommands(Groups.Num(), [&Groups, &GroupsResults, InSearchType, bInUpdateHistory, bPipelined, bPipelinedHistory](const int32 InIndex)
+	{
+		FFilesInCommonDir& Group = *Groups[InIndex];
+		FGroupResults& GroupResults = GroupsResults[InIndex];
+		const bool bWholeDirectory = ((Group.Files.Num() == 1) && (Group.CommonDir == Group.Files[0]));
+
+		if (bPipelined)
 		{
-			bResults = false;
+			FUpdateStatusPipeline Pipeline(bWholeDirectory, bInUpdateHistory, bPipelinedHistory);
+			GroupResults.bGroupOk = RunStatus(Group.CommonDir, MoveTemp(Group.Files), InSearchType, GroupResults.ErrorMessages, GroupResults.States, GroupResults.Changeset,
+				[&Pipeline](FPlasticSourceControlState&& InState) { Pipeline.AddState(MoveTemp(InState)); });
+			// The states of a list of files are only known once the "status" command has completed
+			for (FPlasticSourceControlState& State : GroupResults.States)
+			{
+				Pipeline.AddState(MoveTemp(State));
+			}
+			GroupResults.States.Reset();
+			TArray<FPlasticSourceControlState> PipelinedStates;
+			const bool bPipelineOk = Pipeline.Finish(GroupResults.ErrorMessages, PipelinedStates);
+			if (GroupResults.bGroupOk)
+			{
+				GroupResults.bGroupOk = bPipelineOk;
+				GroupResults.States = MoveTemp(PipelinedStates);
+			}
+			return;
 		}
-		else if (States.Num() > 0)
+
+		// Run a "status" command on the directory to get workspace file states.
+		// (ie. Changed, CheckedOut, Copied, Replaced, Added, Private, Ignored, Deleted, LocallyDeleted, Moved, LocallyMoved)
+		GroupResults.bGroupOk = RunStatus(Group.CommonDir, MoveTemp(Group.Files), InSearchType, GroupResults.ErrorMessages, GroupResults.States, GroupResults.Changeset);
+		if (GroupResults.bGroupOk && (GroupResults.States.Num() > 0))
 		{
 			// Run a "fileinfo" command to update complementary status information of given files.
 			// (ie RevisionChangeset, RevisionHeadChangeset, RepSpec, LockedBy, LockedWhere, ServerPath)
 			// In case of "whole directory status", there is no explicit file in the group (it contains only the directory)
 			// => work on the list of files discovered by RunStatus()
-			bResults &= RunFileinfo(bWholeDirectory, bInUpdateHistory, OutErrorMessages, States);
+			GroupResults.bGroupOk = RunFileinfo(bWholeDirectory, bInUpdateHistory, GroupResults.ErrorMessages, GroupResults.States);
+		}
+	});
+
+	for (FGroupResults& GroupResults : GroupsResults)
+	{
+		bResults &= GroupResults.bGroupOk;
+		if (GroupResults.Changeset != -1)
+		{
+			OutChangeset = GroupResults.Changeset;
+		}
+		OutErrorMessages.Append(MoveTemp(GroupResults.ErrorMessages));
+		OutStates.Append(MoveTemp(GroupResults.States));
+	}
+
+	if (bResults)
+	{
+		// The full status of these directories is the new reference for the changes on disk
+		for (const FString& Dir : FullStatusDirs)
+		{
+			WorkspaceWatcher.OnFullStatus(Dir);
 		}
-		OutStates.Append(MoveTemp(States));
+	}
+	else if (bRestrictedStatus)
+	{
+		// The changes on disk consumed by this failed status would be lost
+		WorkspaceWatcher.Invalidate();
 	}
 
 	// Check if merging, and from which changelist, then execute a cm merge command to amend status for listed files
-	RunCheckMergeStatus(InFiles, OutErrorMessages, OutStates);
+	RunCheckMergeStatus(Files, OutErrorMessages, OutStates);
+
+	// Else the history is left to the caller, that can turn some errors back into success (like "is not in a workspace")
+	bOutGotHistory = bPipelinedHistory;
 
 	return bResults;
 }
 
+// Run a batch of Plastic "status" and "fileinfo" commands to update status of given files and directories.
+bool RunUpdateStatus(const TArray<FString>& InFiles, const EStatusSearchType InSearchType, const bool bInUpdateHistory, TArray<FString>& OutErrorMessages, TArray<FPlasticSourceControlState>& OutStates, int32& OutChangeset)
+{
+	bool bGotHistory = false;
+	return RunUpdateStatusAndHistory(InFiles, InSearchType, bInUpdateHistory, false, OutErrorMessages, OutStates, OutChangeset, bGotHistory);
+}
+
 // Run a "getfile" command to dump the binary content of a revision into a file.
 bool RunGetFile(const FString& InRevSpec, const FString& InDumpFileName)
 {
@@ -956,17 +1892,12 @@ bool RunGetHistory(const bool bInUpdateHistory, TArray<FPlasticSourceControlStat
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(PlasticSourceControlUtils::RunGetHistory);
 
-	bool bResult = true;
-	FString Results;
-	FString Errors;
 	TArray<FString> Parameters;
 	// Detecting move and deletion is costly as it is implemented as two extra queries to the server; do it only when getting the history of the current branch
 	if (bInUpdateHistory)
 	{
 		Parameters.Add(TEXT("--moveddeleted"));
 	}
-	const FScopedTempFile HistoryResultFile(TEXT("History-"), TEXT(".xml"));
-	Parameters.Add(FString::Printf(TEXT("--xml=\"%s\""), *HistoryResultFile.GetFilename()));
 	Parameters.Add(TEXT("--encoding=\"utf-8\""));
 	const FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
 	if (Provider.GetPlasticScmVersion() >= PlasticSourceControlVersions::NewHistoryLimit)
@@ -983,33 +1914,34 @@ bool RunGetHistory(const bool bInUpdateHistory, TArray<FPlasticSourceControlStat
 		}
 	}
 
-	TArray<FString> Files;
-	Files.Reserve(InOutStates.Num());
-	for (const FPlasticSourceControlState& State : InOutStates)
+	const auto IsSelected = [bInUpdateHistory](const FPlasticSourceControlState& InState)
 	{
 		// When getting only the last revision, optimize out if DepotRevisionChangeset is invalid (ie "fileinfo" was optimized out, eg for checked-out files)
-		if (!bInUpdateHistory && State.DepotRevisionChangeset == ISourceControlState::INVALID_REVISION)
-			continue;
+		if (!bInUpdateHistory && InState.DepotRevisionChangeset == ISourceControlState::INVALID_REVISION)
+			return false;
 
-		if (State.IsSourceControlled() && !State.IsAdded())
-		{
-			Files.Add(State.LocalFilename);
-		}
-	}
-	if (Files.Num() > 0)
+		return InState.IsSourceControlled() && !InState.IsAdded();
+	};
+
+	// Split a big selection of files in chunks to bound the length of each command line and the time without any result
+	return RunCommandInChunks(HistoryChunkSize, IsSelected, [bInUpdateHistory, &Parameters](const TArray<FString>& InFiles, TArray<FPlasticSourceControlState>& InOutChunkStates, TArray<FString>& OutChunkErrorMessages)
 	{
-		bResult = RunCommand(TEXT("history"), Parameters, Files, Results, Errors);
-		if (bResult)
+		FString Results;
+		FString Errors;
+		TArray<FString> ChunkParameters = Parameters;
+		const FScopedTempFile HistoryResultFile(TEXT("History-"), TEXT(".xml"));
+		ChunkParameters.Add(FString::Printf(TEXT("--xml=\"%s\""), *HistoryResultFile.GetFilename()));
+		bool bChunkResult = RunCommand(TEXT("history"), ChunkParameters, InFiles, Results, Errors);
+		if (bChunkResult)
 		{
-			bResult = PlasticSourceControlParsers::ParseHistoryResults(bInUpdateHistory, HistoryResultFile.GetFilename(), InOutStates);
+			bChunkResult = PlasticSourceControlParsers::ParseHistoryResults(bInUpdateHistory, HistoryResultFile.GetFilename(), InOutChunkStates);
 		}
 		if (!Errors.IsEmpty())
 		{
-			OutErrorMessages.Add(MoveTemp(Errors));
+			OutChunkErrorMessages.Add(MoveTemp(Errors));
 		}
-	}
-
-	return bResult;
+		return bChunkResult;
+	}, OutErrorMessages, InOutStates);
 }
 
 // Run a Plastic "update" command to sync the workspace and parse its XML results.
@@ -1039,27 +1971,24 @@ bool RunUpdate(const TArray<FString>& InFiles, const bool bInIsPartialWorkspace,
 		bResult = PlasticSourceControlUtils::RunCommand(TEXT("update"), Parameters, TArray<FString>(), InfoMessages, OutErrorMessages);
 		if (bResult)
 		{
-			// Load and parse the result of the update command
-			FString Results;
-			if (FFileHelper::LoadFileToString(Results, *UpdateResultFile.GetFilename()))
-			{
-				bResult = PlasticSourceControlParsers::ParseUpdateResults(Results, OutUpdatedFiles);
-			}
+			// Stream the XML result file of the update command through the parser
+			bResult = PlasticSourceControlParsers::ParseUpdateResults(UpdateResultFile.GetFilename(), OutUpdatedFiles);
 		}
 	}
 	else
 	{
-		TArray<FString> Results;
 		if (!InChangesetId.IsEmpty())
 		{
 			Parameters.Add(FString::Printf(TEXT("--changeset=%s"), *InChangesetId));
 		}
 		Parameters.Add(TEXT("--report"));
 		Parameters.Add(TEXT("--machinereadable"));
-		bResult = PlasticSourceControlUtils::RunCommand(TEXT("partial update"), Parameters, InFiles, Results, OutErrorMessages);
+		// Only report the updated files if the command succeeded, else the lines parsed were errors
+		TArray<FString> UpdatedFiles;
+		bResult = PlasticSourceControlUtils::RunCommand(TEXT("partial update"), Parameters, InFiles, [&UpdatedFiles](FString&& InResult) { PlasticSourceControlParsers::ParseUpdateResult(InResult, UpdatedFiles); }, OutErrorMessages);
 		if (bResult)
 		{
-			bResult = PlasticSourceControlParsers::ParseUpdateResults(Results, OutUpdatedFiles);
+			OutUpdatedFiles.Append(MoveTemp(UpdatedFiles));
 		}
 	}
 
@@ -1261,7 +2190,8 @@ bool RunGetShelve(const int32 InShelveId, FString& OutComment, FDateTime& OutDat
 
 #endif
 
-bool RunGetChangesets(const FDateTime& InFromDate, TArray<FPlasticSourceControlChangesetRef>& OutChangesets, TArray<FString>& OutErrorMessages)
+// Run find "changesets where <conditions> order by ChangesetId desc limit <N>" and parse the results
+static bool RunFindChangesets(const TArray<FString>& InConditions, const int32 InLimit, TArray<FPlasticSourceControlChangesetRef>& OutChangesets, TArray<FString>& OutErrorMessages)
 {
 	bool bCommandSuccessful = false;
 
@@ -1270,11 +2200,15 @@ bool RunGetChangesets(const FDateTime& InFromDate, TArray<FPlasticSourceControlC
 	TArray<FString> Errors;
 	TArray<FString> Parameters;
 	Parameters.Add(TEXT("changesets"));
-	if (InFromDate != FDateTime())
+	if (InConditions.Num() > 0)
 	{
-		Parameters.Add(FString::Printf(TEXT("\"where date >= '%d/%d/%d'\""), InFromDate.GetYear(), InFromDate.GetMonth(), InFromDate.GetDay()));
+		Parameters.Add(FString::Printf(TEXT("\"where %s\""), *FString::Join(InConditions, TEXT(" and "))));
 	}
 	Parameters.Add(TEXT("order by ChangesetId desc"));
+	if (InLimit > 0)
+	{
+		Parameters.Add(FString::Printf(TEXT("limit %d"), InLimit));
+	}
 	Parameters.Add(FString::Printf(TEXT("--xml=\"%s\""), *ChangesetResultFile.GetFilename()));
 	Parameters.Add(TEXT("--encoding=\"utf-8\""));
 	bCommandSuccessful = PlasticSourceControlUtils::RunCommand(TEXT("find"), Parameters, TArray<FString>(), Results, Errors);
@@ -1290,6 +2224,39 @@ bool RunGetChangesets(const FDateTime& InFromDate, TArray<FPlasticSourceControlC
 	return bCommandSuccessful;
 }
 
+static FString GetFromDateCondition(const FDateTime& InFromDate)
+{
+	return FString::Printf(TEXT("date >= '%d/%d/%d'"), InFromDate.GetYear(), InFromDate.GetMonth(), InFromDate.GetDay());
+}
+
+bool RunGetChangesets(const FDateTime& InFromDate, const int32 InFromChangesetId, TArray<FPlasticSourceControlChangesetRef>& OutChangesets, TArray<FString>& OutErrorMessages)
+{
+	TArray<FString> Conditions;
+	if (InFromChangesetId != ISourceControlState::INVALID_REVISION)
+	{
+		Conditions.Add(FString::Printf(TEXT("changesetid > %d"), InFromChangesetId));
+	}
+	else if (InFromDate != FDateTime())
+	{
+		Conditions.Add(GetFromDateCondition(InFromDate));
+	}
+	return RunFindChangesets(Conditions, 0, OutChangesets, OutErrorMessages);
+}
+
+bool RunGetChangesetsPage(const FDateTime& InFromDate, const int32 InBeforeChangesetId, const int32 InMaxChangesets, TArray<FPlasticSourceControlChangesetRef>& OutChangesets, TArray<FString>& OutErrorMessages)
+{
+	TArray<FString> Conditions;
+	if (InFromDate != FDateTime())
+	{
+		Conditions.Add(GetFromDateCondition(InFromDate));
+	}
+	if (InBeforeChangesetId != ISourceControlState::INVALID_REVISION)
+	{
+		Conditions.Add(FString::Printf(TEXT("changesetid < %d"), InBeforeChangesetId));
+	}
+	return RunFindChangesets(Conditions, InMaxChangesets, OutChangesets, OutErrorMessages);
+}
+
 bool RunGetChangesetFiles(const FPlasticSourceControlChangesetRef& InChangeset, TArray<FPlasticSourceControlStateRef>& OutFiles, TArray<FString>& OutErrorMessages)
 {
 	bool bCommandSuccessful = false;
@@ -1371,22 +2338,19 @@ bool RunSwitch(const FString& InBranchName, const int32 InChangesetId, const boo
 		bResult = PlasticSourceControlUtils::RunCommand(TEXT("switch"), Parameters, TArray<FString>(), InfoMessages, OutErrorMessages);
 		if (bResult)
 		{
-			// Load and parse the result of the update command
-			FString Results;
-			if (FFileHelper::LoadFileToString(Results, *SwitchResultFile.GetFilename()))
-			{
-				bResult = PlasticSourceControlParsers::ParseUpdateResults(Results, OutUpdatedFiles);
-			}
+			// Stream the XML result file of the update command through the parser
+			bResult = PlasticSourceControlParsers::ParseUpdateResults(SwitchResultFile.GetFilename(), OutUpdatedFiles);
 		}
 	}
 	else
 	{
-		TArray<FString> Results;
 		Parameters.Add(TEXT("--report"));
-		bResult = PlasticSourceControlUtils::RunCommand(TEXT("partial switch"), Parameters, TArray<FString>(), Results, OutErrorMessages);
+		// Only report the updated files if the command succeeded, else the lines parsed were errors
+		TArray<FString> UpdatedFiles;
+		bResult = PlasticSourceControlUtils::RunCommand(TEXT("partial switch"), Parameters, TArray<FString>(), [&UpdatedFiles](FString&& InResult) { PlasticSourceControlParsers::ParseUpdateResult(InResult, UpdatedFiles); }, OutErrorMessages);
 		if (bResult)
 		{
-			bResult = PlasticSourceControlParsers::ParseUpdateResults(Results, OutUpdatedFiles);
+			OutUpdatedFiles.Append(MoveTemp(UpdatedFiles));
 		}
 	}
 
@@ -1471,6 +2435,10 @@ bool UpdateCachedStates(TArray<FPlasticSourceControlState>&& InStates)
 		{
 			bUpdatedStates = true;
 		}
+		if (!State->LocalFilename.Equals(InState.LocalFilename, ESearchCase::CaseSensitive))
+		{
+			Provider.RenameCaseInCache(State, InState.LocalFilename);
+		}
 		*State = MoveTemp(InState);
 		State->TimeStamp = Now;
 	}
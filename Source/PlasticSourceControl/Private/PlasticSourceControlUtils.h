@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/StringView.h"
 
 #include "PlasticSourceControlRevision.h"
 
@@ -16,6 +17,7 @@ struct FSoftwareVersion;
 typedef TSharedRef<class FPlasticSourceControlBranch, ESPMode::ThreadSafe> FPlasticSourceControlBranchRef;
 typedef TSharedRef<class FPlasticSourceControlChangeset, ESPMode::ThreadSafe> FPlasticSourceControlChangesetRef;
 typedef TSharedRef<class FPlasticSourceControlLock, ESPMode::ThreadSafe> FPlasticSourceControlLockRef;
+typedef TSharedPtr<const class FPlasticSourceControlLocksIndex, ESPMode::ThreadSafe> FPlasticSourceControlLocksIndexPtr;
 typedef TSharedRef<class FPlasticSourceControlState, ESPMode::ThreadSafe> FPlasticSourceControlStateRef;
 
 enum class EWorkspaceState;
@@ -47,6 +49,34 @@ bool RunCommand(const FString& InCommand, const TArray<FString>& InParameters, c
  */
 bool RunCommand(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, TArray<FString>& OutResults, TArray<FString>& OutErrorMessages);
 
+/**
+ * Run a Plastic command - each line of the result is given to the visitor as soon as it is received, to parse it while cm is still running.
+ *
+ * @note The visitor is called while the command is running: it must not run any other command.
+ *
+ * @param	InCommand			The Plastic command - e.g. status
+ * @param	InParameters		The parameters to the Plastic command
+ * @param	InFiles				The files to be operated on
+ * @param	InLineVisitor		The visitor called on each line of the results (from StdOut)
+ * @param	OutErrorMessages	Any errors (from StdErr) as an array per-line, or the last lines of the results if the command failed without any error
+ * @returns true if the command succeeded and returned no errors
+ */
+bool RunCommand(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, const TFunctionRef<void(FString&&)>& InLineVisitor, TArray<FString>& OutErrorMessages);
+
+/**
+ * Run a Plastic command - each line of the result is given to the visitor as a view on the raw UTF-8 bytes, without conversion to FString.
+ *
+ * @note The visitor is called while the command is running: it must not run any other command. The view is only valid during the call.
+ *
+ * @param	InCommand			The Plastic command - e.g. status
+ * @param	InParameters		The parameters to the Plastic command
+ * @param	InFiles				The files to be operated on
+ * @param	InUtf8LineVisitor	The visitor called on each line of the results (from StdOut)
+ * @param	OutErrorMessages	Any errors (from StdErr) as an array per-line, or the last lines of the results if the command failed without any error
+ * @returns true if the command succeeded and returned no errors
+ */
+bool RunCommandUtf8(const FString& InCommand, const TArray<FString>& InParameters, const TArray<FString>& InFiles, const TFunctionRef<void(FAnsiStringView)>& InUtf8LineVisitor, TArray<FString>& OutErrorMessages);
+
 /**
  * Find the path to the Plastic binary: for now relying on the Path to access the "cm" command.
  */
@@ -215,6 +245,73 @@ void InvalidateLocksCache();
  */
 bool RunListLocks(const FPlasticSourceControlProvider& InProvider, const bool bInForAllDestBranches, TArray<FPlasticSourceControlLockRef>& OutLocks);
 
+/**
+ * Run a Plastic "lock list" command and parse it, into an index by server path shared with the cache of locks.
+ *
+ * @param	InProvider				The source control provider to get the repository and current branch to ask the locks for
+ * @param   bInForAllDestBranches	Retrieve locks for all destination branches, or restrict them to only those applying to the working branch
+ * @param	OutLocksIndex			The index of the list of locks (read-only, as it is shared)
+ * @returns true if the command succeeded and returned no errors
+ */
+bool RunListLocks(const FPlasticSourceControlProvider& InProvider, const bool bInForAllDestBranches, FPlasticSourceControlLocksIndexPtr& OutLocksIndex);
+
+/**
+ * Patch the cache of locks in place after a successful checkout, instead of invalidating it,
+ * with the locks listed for the files checked out on the working branch (only the server knows which files are lockable).
+ * A single "lock list" command is run, leaving the locks applying to other branches to the background refresh of the locks.
+ *
+ * @param	InProvider			The source control provider to get the current branch, user and workspace
+ * @param	InFiles				The files checked out (absolute paths)
+ */
+void UpdateLocksCacheOnCheckOut(const FPlasticSourceControlProvider& InProvider, const TArray<FString>& InFiles);
+
+/**
+ * Patch the cache of locks in place after a successful checkin, instead of invalidating it.
+ *
+ * @param	InProvider			The source control provider to get the current branch and workspace
+ * @param	InFiles				The files checked in (absolute paths)
+ */
+void UpdateLocksCacheOnCheckIn(const FPlasticSourceControlProvider& InProvider, const TArray<FString>& InFiles);
+
+/**
+ * Patch the cache of locks in place after an unlock, instead of invalidating it.
+ *
+ * @param	InLocks				The locks released or removed
+ * @param	bInRemove			The locks were removed instead of released
+ */
+void UpdateLocksCacheOnUnlock(const TArray<FPlasticSourceControlLockRef>& InLocks, const bool bInRemove);
+
+/**
+ * Refresh the cache of locks applying to the working branch in the background, if they were already listed, and diff the new list against the cached one.
+ *
+ * @param	InRepositorySpecification	The repository to ask the locks for (copied from the provider on the Game Thread)
+ * @param	InWorkingBranch				The branch to restrict the locks to, or empty for older versions of Unity Version Control
+ * @param	OutChangedPaths				The server paths for which the locks changed
+ * @returns true if the cache was refreshed
+ */
+bool RefreshLocksCache(const FString& InRepositorySpecification, const FString& InWorkingBranch, TArray<FString>& OutChangedPaths);
+
+/**
+ * Remember the local file of a server path of the repository of the workspace, as reported by "fileinfo", to update its locks from a refresh of the cache.
+ *
+ * @note Files under an xlink are not given here: their server paths are relative to the xlinked repository, not the one the locks are listed for.
+ *
+ * @param	InServerPath		The server path of the file, relative to the root of the repository
+ * @param	InFilename			The absolute path of the file in the workspace
+ */
+void AddServerPath(const FString& InServerPath, const FString& InFilename);
+
+/** Forget the local files of all the server paths, when the workspace is closed */
+void ResetServerPaths();
+
+/**
+ * Update the lock information of the cached states of files from the cache of locks, for the server paths changed by RefreshLocksCache().
+ *
+ * @param	InChangedPaths		The server paths for which the locks changed
+ * @returns true if any state was updated in a meaningful way for the Editor
+ */
+bool UpdateCachedLocks(const TArray<FString>& InChangedPaths);
+
 /**
  * Get locks applying to the working branch for the specified files.
  *
@@ -252,6 +349,24 @@ enum class EStatusSearchType
  */
 bool RunUpdateStatus(const TArray<FString>& InFiles, const EStatusSearchType InSearchType, const bool bInUpdateHistory, TArray<FString>& OutErrorMessages, TArray<FPlasticSourceControlState>& OutStates, int32& OutChangeset);
 
+/**
+ * Run Plastic "status", "fileinfo" and optionally "history" commands and parse them.
+ *
+ * For big selections and whole directories, "fileinfo" and "history" are pipelined behind "status" on batches of files,
+ * logging the time spent in each stage.
+ *
+ * @param	InFiles				The files to be operated on
+ * @param	InSearchType		Call "status" with "--all", or with just "--controlledchanged" when doing only a quick check following a source control operation
+ * @param	bInUpdateHistory	If getting the history of files, versus only checking the heads of branches to detect newer commits
+ * @param	bInGetHistory		Pipeline the "history" command behind "status" when possible (see RunGetHistory())
+ * @param	OutErrorMessages	Any errors (from StdErr) as an array per-line
+ * @param	OutStates			States of the files
+ * @param	OutChangeset		The current Changeset Number
+ * @param	bOutGotHistory		If the history has been pipelined, else the caller has to call RunGetHistory() once it has filtered the errors it expects
+ * @returns true if the command succeeded and returned no errors
+ */
+bool RunUpdateStatusAndHistory(const TArray<FString>& InFiles, const EStatusSearchType InSearchType, const bool bInUpdateHistory, const bool bInGetHistory, TArray<FString>& OutErrorMessages, TArray<FPlasticSourceControlState>& OutStates, int32& OutChangeset, bool& bOutGotHistory);
+
 /**
  * Run a Plastic "cat" command to dump the binary content of a revision into a file.
  *
@@ -323,12 +438,23 @@ void AddShelvedFileToChangelist(FPlasticSourceControlChangelistState& InOutChang
 /**
  * Run find "changesets where date >= 'YYYY-MM-DD'" and parse the results.
  * @param	InFromDate				The date to search from
+ * @param	InFromChangesetId		Only search the changesets created after this one, ie "where changesetid > N" (optional, ignored if INVALID_REVISION)
  * @param	OutChangesets			The list of changesets, without their files
  * @param	OutErrorMessages		Any errors (from StdErr) as an array per-line
  *
  * @see RunGetChangesetFiles() below used to populated a specific changeset with its list of files
  */
-bool RunGetChangesets(const FDateTime& InFromDate, TArray<FPlasticSourceControlChangesetRef>& OutChangesets, TArray<FString>& OutErrorMessages);
+bool RunGetChangesets(const FDateTime& InFromDate, const int32 InFromChangesetId, TArray<FPlasticSourceControlChangesetRef>& OutChangesets, TArray<FString>& OutErrorMessages);
+
+/**
+ * Run find "changesets where date >= 'YYYY-MM-DD' and changesetid < N limit M" to get a page of the history, from the most recent changesets.
+ * @param	InFromDate				The date to search from (optional, ignored if FDateTime())
+ * @param	InBeforeChangesetId		Only search the changesets created before this one, ie the oldest of the previous page (INVALID_REVISION for the first page)
+ * @param	InMaxChangesets			The maximum number of changesets to list
+ * @param	OutChangesets			The list of changesets, without their files, by descending ChangesetId
+ * @param	OutErrorMessages		Any errors (from StdErr) as an array per-line
+ */
+bool RunGetChangesetsPage(const FDateTime& InFromDate, const int32 InBeforeChangesetId, const int32 InMaxChangesets, TArray<FPlasticSourceControlChangesetRef>& OutChangesets, TArray<FString>& OutErrorMessages);
 
 /**
  * Run "log cs:<ChangesetId> --xml" and parse the results to populate the files from the specified changeset.
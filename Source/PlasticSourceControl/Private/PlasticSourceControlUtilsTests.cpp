@@ -1,10 +1,36 @@
 // Copyright (c) 2025 Unity Technologies
 
 #include "PlasticSourceControlUtils.h"
+#include "IPlasticSourceControlWorker.h"
+#include "PlasticSourceControlBranch.h"
+#include "PlasticSourceControlChangeset.h"
+#include "PlasticSourceControlChangesetFilesCache.h"
+#include "PlasticSourceControlCommand.h"
+#include "PlasticSourceControlListFilter.h"
+#include "PlasticSourceControlLock.h"
+#include "PlasticSourceControlMetadataCache.h"
+#include "PlasticSourceControlModule.h"
+#include "PlasticSourceControlParsers.h"
+#include "PlasticSourceControlProvider.h"
+#include "PlasticSourceControlRevisionCache.h"
+#include "PlasticSourceControlShell.h"
+#include "PlasticSourceControlState.h"
+#include "PlasticSourceControlStateCache.h"
+#include "PlasticSourceControlXmlReader.h"
 #include "SoftwareVersion.h"
 
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 #include "Misc/AutomationTest.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "SourceControlOperations.h"
+#include "XmlParser.h"
+
+#include <atomic>
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFindCommonDirectoryUnitTest, "PlasticSCM.FindCommonDirectory", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter)
 
@@ -155,4 +181,854 @@ bool FSoftwareVersionMoreOrEqualUnitTest::RunTest(const FString& Parameters)
 	return true; // actual results are returned by TestXxx() macros
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDirectoryStatusDiffUnitTest, "PlasticSCM.DirectoryStatusDiff", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter)
+
+bool FDirectoryStatusDiffUnitTest::RunTest(const FString& Parameters)
+{
+	// Previous states from the cache: one checked-out file, one added file, and one private file with a different case than in the status
+	TArray<FSourceControlStateRef> PreviousStates;
+	PreviousStates.Add(MakeShareable(new FPlasticSourceControlState(TEXT("c:/Workspace/Content/CheckedOut.uasset"), EWorkspaceState::CheckedOutChanged)));
+	PreviousStates.Add(MakeShareable(new FPlasticSourceControlState(TEXT("c:/Workspace/Content/Added.uasset"), EWorkspaceState::Added)));
+	PreviousStates.Add(MakeShareable(new FPlasticSourceControlState(TEXT("c:/Workspace/Content/PRIVATE.uasset"), EWorkspaceState::Private)));
+
+	// New states from the status: the checked-out file is still checked-out, the added one has been checked-in, and a new file is locally deleted
+	TArray<FPlasticSourceControlState> NewStates;
+	NewStates.Emplace(TEXT("c:/Workspace/Content/CheckedOut.uasset"), EWorkspaceState::CheckedOutChanged);
+	NewStates.Emplace(TEXT("c:/Workspace/Content/Private.uasset"), EWorkspaceState::Added);
+	NewStates.Emplace(TEXT("c:/Workspace/Content/Deleted.uasset"), EWorkspaceState::LocallyDeleted);
+
+	const PlasticSourceControlParsers::FDirectoryStatusDiff StatusDiff = PlasticSourceControlParsers::DiffDirectoryStatus(PreviousStates, NewStates);
+
+	TestEqual(TEXT("Number of added"), StatusDiff.Added.Num(), 1);
+	TestTrue(TEXT("Added"), (StatusDiff.Added.Num() == 1) && (StatusDiff.Added[0] == 2));
+	TestEqual(TEXT("Number of removed"), StatusDiff.Removed.Num(), 1);
+	TestTrue(TEXT("Removed"), (StatusDiff.Removed.Num() == 1) && (StatusDiff.Removed[0] == PreviousStates[1]));
+	TestEqual(TEXT("Number of changed"), StatusDiff.Changed.Num(), 1);
+	TestTrue(TEXT("Changed (ignoring case)"), (StatusDiff.Changed.Num() == 1) && (StatusDiff.Changed[0].Key == 1) && (StatusDiff.Changed[0].Value == 2));
+
+	return true; // actual results are returned by TestXxx() macros
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStatusParserBenchmarkUnitTest, "PlasticSCM.StatusParserBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::PerfFilter)
+
+bool FStatusParserBenchmarkUnitTest::RunTest(const FString& Parameters)
+{
+	// Synthetic dump of a "cm status --machinereadable" of 100k files, starting with the workspace status header
+	static const int32 NumFiles = 100000;
+	static const TCHAR* FileStatuses[] = { TEXT("CO"), TEXT("CO+CH"), TEXT("CH"), TEXT("AD"), TEXT("PR"), TEXT("IG"), TEXT("DE"), TEXT("LD"), TEXT("CO+CP"), TEXT("CO+RP") };
+	TArray<FString> Lines;
+	Lines.Reserve(NumFiles + 1);
+	Lines.Add(TEXT("STATUS;41;UEPlasticPluginDev;localhost:8087"));
+	for (int32 Index = 0; Index < NumFiles; Index++)
+	{
+		if (Index % 100 == 0)
+		{
+			Lines.Add(FString::Printf(TEXT("MV;100%%;c:\\Workspace\\UEPlasticPluginDev\\Content\\Folder%d\\ToMove_%d.uasset;c:\\Workspace\\UEPlasticPluginDev\\Content\\Folder%d\\Moved_%d.uasset;False;NO_MERGES"), Index / 100, Index, Index / 100, Index));
+		}
+		else
+		{
+			Lines.Add(FString::Printf(TEXT("%s;c:\\Workspace\\UEPlasticPluginDev\\Content\\Folder%d\\Asset_%d.uasset;False;NO_MERGES"), FileStatuses[Index % UE_ARRAY_COUNT(FileStatuses)], Index / 100, Index));
+		}
+	}
+
+	// The same dump as raw UTF-8 bytes, as received from the pipe of the 'cm shell'
+	TArray<ANSICHAR> Utf8Dump;
+	for (const FString& Line : Lines)
+	{
+		const FTCHARToUTF8 Utf8Line(*Line);
+		Utf8Dump.Append(Utf8Line.Get(), Utf8Line.Length());
+		Utf8Dump.Add('\n');
+	}
+
+	// 1) Parse each line from an FString, as given by RunCommand() with the whole output split in an array of lines
+	const double StringStartTime = FPlatformTime::Seconds();
+	PlasticSourceControlParsers::FStatusResultParser StringParser;
+	for (const FString& Line : Lines)
+	{
+		FString Result = Line;
+		StringParser.ParseLine(MoveTemp(Result));
+	}
+	const double StringElapsedTime = FPlatformTime::Seconds() - StringStartTime;
+
+	// 2) Parse each line directly from the raw UTF-8 bytes, as given by RunCommandUtf8()
+	const double Utf8StartTime = FPlatformTime::Seconds();
+	PlasticSourceControlParsers::FStatusResultParser Utf8Parser;
+	int32 LineStart = 0;
+	for (int32 Index = 0; Index < Utf8Dump.Num(); Index++)
+	{
+		if (Utf8Dump[Index] == '\n')
+		{
+			Utf8Parser.ParseLine(FAnsiStringView(Utf8Dump.GetData() + LineStart, Index - LineStart));
+			LineStart = Index + 1;
+		}
+	}
+	const double Utf8ElapsedTime = FPlatformTime::Seconds() - Utf8StartTime;
+
+	AddInfo(FString::Printf(TEXT("Parsed %d status lines: %.3lfs from FString vs %.3lfs from UTF-8"), NumFiles, StringElapsedTime, Utf8ElapsedTime));
+
+	TestEqual(TEXT("Changeset"), Utf8Parser.Changeset, StringParser.Changeset);
+	TestEqual(TEXT("Number of states"), Utf8Parser.States.Num(), StringParser.States.Num());
+	TestEqual(TEXT("Number of states"), Utf8Parser.States.Num(), NumFiles);
+	if (Utf8Parser.States.Num() == StringParser.States.Num())
+	{
+		int32 NumDifferences = 0;
+		for (int32 Index = 0; Index < Utf8Parser.States.Num(); Index++)
+		{
+			const FPlasticSourceControlState& Utf8State = Utf8Parser.States[Index];
+			const FPlasticSourceControlState& StringState = StringParser.States[Index];
+			if ((Utf8State.LocalFilename != StringState.LocalFilename) || (Utf8State.WorkspaceState != StringState.WorkspaceState) || (Utf8State.MovedFrom != StringState.MovedFrom))
+			{
+				NumDifferences++;
+			}
+		}
+		TestEqual(TEXT("Same states"), NumDifferences, 0);
+	}
+	TestEqual(TEXT("Normalized filename"), Utf8Parser.States[1].LocalFilename, FString(TEXT("c:/Workspace/UEPlasticPluginDev/Content/Folder0/Asset_1.uasset")));
+	TestTrue(TEXT("Moved state"), Utf8Parser.States[0].WorkspaceState == EWorkspaceState::Moved);
+	TestEqual(TEXT("Moved from"), Utf8Parser.States[0].MovedFrom, FString(TEXT("c:/Workspace/UEPlasticPluginDev/Content/Folder0/ToMove_0.uasset")));
+
+	return true; // actual results are returned by TestXxx() macros
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLocksIndexBenchmarkUnitTest, "PlasticSCM.LocksIndexBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::PerfFilter)
+
+bool FLocksIndexBenchmarkUnitTest::RunTest(const FString& Parameters)
+{
+	// 50k locks on server paths, and 20k files in the workspace, only half of them being locked
+	const int32 NumLocks = 50000;
+	const int32 NumFiles = 20000;
+	TArray<FPlasticSourceControlLockRef> Locks;
+	Locks.Reserve(NumLocks);
+	for (int32 Index = 0; Index < NumLocks; Index++)
+	{
+		FPlasticSourceControlLockRef Lock = MakeShareable(new FPlasticSourceControlLock());
+		Lock->ItemId = Index;
+		Lock->Path = FString::Printf(TEXT("/Content/Folder%d/Asset_%d.uasset"), Index / 100, Index * 2);
+		Locks.Add(Lock);
+	}
+	TArray<FString> Files;
+	Files.Reserve(NumFiles);
+	for (int32 Index = 0; Index < NumFiles; Index++)
+	{
+		Files.Add(FString::Printf(TEXT("c:/Workspace/UEPlasticPluginDev/Content/Folder%d/Asset_%d.uasset"), Index / 200, Index));
+	}
+
+	const double IndexStartTime = FPlatformTime::Seconds();
+	const FPlasticSourceControlLocksIndex LocksIndex(Locks);
+	const double IndexBuildTime = FPlatformTime::Seconds() - IndexStartTime;
+
+	const double SuffixStartTime = FPlatformTime::Seconds();
+	TArray<FPlasticSourceControlLockPtr> MatchingLocks;
+	MatchingLocks.Reserve(NumFiles);
+	for (const FString& File : Files)
+	{
+		MatchingLocks.Add(LocksIndex.FindBySuffix(File));
+	}
+	const double SuffixElapsedTime = FPlatformTime::Seconds() - SuffixStartTime;
+
+	const double PathStartTime = FPlatformTime::Seconds();
+	int32 NumMatchingPaths = 0;
+	for (int32 Index = 0; Index < NumFiles; Index++)
+	{
+		NumMatchingPaths += LocksIndex.FindByPath(FString::Printf(TEXT("/Content/Folder%d/Asset_%d.uasset"), Index / 200, Index)).Num();
+	}
+	const double PathElapsedTime = FPlatformTime::Seconds() - PathStartTime;
+
+	// Reference linear scan as previously done by GetLocksForWorkingBranch(), on a sample of the files to keep the test fast
+	const int32 NumSampleFiles = 200;
+	int32 NumDifferences = 0;
+	const double LinearStartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumSampleFiles; Index++)
+	{
+		const int32 FileIndex = Index * (NumFiles / NumSampleFiles);
+		FPlasticSourceControlLockPtr LinearMatchingLock;
+		for (const FPlasticSourceControlLockRef& Lock : Locks)
+		{
+			if (Files[FileIndex].EndsWith(Lock->Path))
+			{
+				LinearMatchingLock = Lock;
+				break;
+			}
+		}
+		if (LinearMatchingLock != MatchingLocks[FileIndex])
+		{
+			NumDifferences++;
+		}
+	}
+	const double LinearElapsedTime = (FPlatformTime::Seconds() - LinearStartTime) * (NumFiles / NumSampleFiles);
+
+	AddInfo(FString::Printf(TEXT("%d locks x %d files: index built in %.3lfs, suffix lookups in %.3lfs, path lookups in %.3lfs vs %.3lfs (estimated) for a linear scan"),
+		NumLocks, NumFiles, IndexBuildTime, SuffixElapsedTime, PathElapsedTime, LinearElapsedTime));
+
+	int32 NumMatchingLocks = 0;
+	for (const FPlasticSourceControlLockPtr& MatchingLock : MatchingLocks)
+	{
+		if (MatchingLock.IsValid())
+		{
+			NumMatchingLocks++;
+		}
+	}
+	TestEqual(TEXT("Number of locked files"), NumMatchingLocks, NumFiles / 2);
+	TestEqual(TEXT("Number of locked paths"), NumMatchingPaths, NumFiles / 2);
+	TestEqual(TEXT("Same locks as a linear scan"), NumDifferences, 0);
+	TestTrue(TEXT("Lock of an even file"), MatchingLocks[42].IsValid() && (MatchingLocks[42]->ItemId == 21));
+	TestFalse(TEXT("No lock for an odd file"), MatchingLocks[43].IsValid());
+	TestFalse(TEXT("No lock for a partial file name"), LocksIndex.FindBySuffix(TEXT("c:/Workspace/UEPlasticPluginDev/Content/Folder0/XAsset_42.uasset")).IsValid());
+
+	return true; // actual results are returned by TestXxx() macros
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXmlParserBenchmarkUnitTest, "PlasticSCM.XmlParserBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::PerfFilter)
+
+bool FXmlParserBenchmarkUnitTest::RunTest(const FString& Parameters)
+{
+	// Synthetic result file of a "cm find changesets --xml --encoding="utf-8"" of 20k changesets
+	static const int32 NumChangesets = 20000;
+	FString Xml;
+	Xml.Reserve(NumChangesets * 320);
+	Xml += TEXT("<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<PLASTICQUERY>\n");
+	for (int32 Index = 1; Index <= NumChangesets; Index++)
+	{
+		Xml += FString::Printf(TEXT("  <CHANGESET>\n    <ID>%d</ID>\n    <CHANGESETID>%d</CHANGESETID>\n    <COMMENT>Changeset %d: fix &amp; cleanup of Folder%d</COMMENT>\n    <BRANCH>/main/task%d</BRANCH>\n    <OWNER>user%d@unity3d.com</OWNER>\n    <DATE>2024-04-02T16:20:11+02:00</DATE>\n    <REPOSITORY>UEPlasticPluginDev</REPOSITORY>\n  </CHANGESET>\n"),
+			Index + 1000, Index, Index, Index / 100, Index % 50, Index % 10);
+	}
+	Xml += TEXT("</PLASTICQUERY>\n");
+
+	const FString XmlFilename = FPaths::CreateTempFilename(*FPaths::ProjectSavedDir(), TEXT("Changesets-"), TEXT(".xml"));
+	if (!FFileHelper::SaveStringToFile(Xml, *XmlFilename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		AddError(FString::Printf(TEXT("Failed to write '%s'"), *XmlFilename));
+		return false;
+	}
+	const int64 XmlSize = IFileManager::Get().FileSize(*XmlFilename);
+	Xml.Empty();
+
+	// 1) Reference DOM path, as previously done by ParseChangesetsResults(): load the whole document in a tree of FXmlNode then walk it
+	TArray<FPlasticSourceControlChangesetRef> DomChangesets;
+	uint64 DomMemory = 0;
+	const uint64 DomStartMemory = FPlatformMemory::GetStats().UsedPhysical;
+	const double DomStartTime = FPlatformTime::Seconds();
+	{
+		FXmlFile XmlFile;
+		if (XmlFile.LoadFile(XmlFilename))
+		{
+			const TArray<FXmlNode*>& ChangesetsNodes = XmlFile.GetRootNode()->GetChildrenNodes();
+			DomChangesets.Reserve(ChangesetsNodes.Num());
+			for (const FXmlNode* ChangesetNode : ChangesetsNodes)
+			{
+				FPlasticSourceControlChangesetRef ChangesetRef = MakeShareable(new FPlasticSourceControlChangeset());
+				ChangesetRef->ChangesetId = FCString::Atoi(*ChangesetNode->FindChildNode(TEXT("CHANGESETID"))->GetContent());
+				ChangesetRef->Comment = ChangesetNode->FindChildNode(TEXT("COMMENT"))->GetContent();
+				ChangesetRef->Branch = ChangesetNode->FindChildNode(TEXT("BRANCH"))->GetContent();
+				ChangesetRef->CreatedBy = ChangesetNode->FindChildNode(TEXT("OWNER"))->GetContent();
+				FDateTime::ParseIso8601(*ChangesetNode->FindChildNode(TEXT("DATE"))->GetContent(), ChangesetRef->Date);
+				DomChangesets.Add(MoveTemp(ChangesetRef));
+			}
+		}
+		// Peak memory is reached while both the DOM and the results are alive
+		const uint64 DomEndMemory = FPlatformMemory::GetStats().UsedPhysical;
+		DomMemory = (DomEndMemory > DomStartMemory) ? DomEndMemory - DomStartMemory : 0;
+	}
+	const double DomElapsedTime = FPlatformTime::Seconds() - DomStartTime;
+
+	// 2) Streaming reader, feeding the parser directly from the UTF-8 bytes of the file
+	TArray<FPlasticSourceControlChangesetRef> StreamChangesets;
+	const uint64 StreamStartMemory = FPlatformMemory::GetStats().UsedPhysical;
+	const double StreamStartTime = FPlatformTime::Seconds();
+	const bool bStreamResult = PlasticSourceControlParsers::ParseChangesetsResults(XmlFilename, StreamChangesets);
+	const double StreamElapsedTime = FPlatformTime::Seconds() - StreamStartTime;
+	const uint64 StreamEndMemory = FPlatformMemory::GetStats().UsedPhysical;
+	const uint64 StreamMemory = (StreamEndMemory > StreamStartMemory) ? StreamEndMemory - StreamStartMemory : 0;
+
+	IFileManager::Get().Delete(*XmlFilename);
+
+	AddInfo(FString::Printf(TEXT("Parsed %d changesets (%lld bytes of XML): DOM %.3lfs and %llu KiB vs streaming %.3lfs and %llu KiB"),
+		NumChangesets, XmlSize, DomElapsedTime, DomMemory / 1024, StreamElapsedTime, StreamMemory / 1024));
+
+	TestTrue(TEXT("Streaming parser result"), bStreamResult);
+	TestEqual(TEXT("Number of changesets"), DomChangesets.Num(), NumChangesets);
+	TestEqual(TEXT("Number of changesets"), StreamChangesets.Num(), NumChangesets);
+	if (StreamChangesets.Num() == DomChangesets.Num())
+	{
+		int32 NumDifferences = 0;
+		for (int32 Index = 0; Index < StreamChangesets.Num(); Index++)
+		{
+			const FPlasticSourceControlChangeset& StreamChangeset = StreamChangesets[Index].Get();
+			const FPlasticSourceControlChangeset& DomChangeset = DomChangesets[Index].Get();
+			if ((StreamChangeset.ChangesetId != DomChangeset.ChangesetId) || (StreamChangeset.Branch != DomChangeset.Branch) || (StreamChangeset.CreatedBy != DomChangeset.CreatedBy) || (StreamChangeset.Date != DomChangeset.Date))
+			{
+				NumDifferences++;
+			}
+		}
+		TestEqual(TEXT("Same changesets"), NumDifferences, 0);
+	}
+	if (StreamChangesets.Num() > 42)
+	{
+		// Note: FXmlFile does not decode XML entities, only the parser does
+		TestEqual(TEXT("Decoded comment"), StreamChangesets[42]->Comment, FString(TEXT("Changeset 43: fix & cleanup of Folder0")));
+	}
+
+	return true; // actual results are returned by TestXxx() macros
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXmlReaderCDataUnitTest, "PlasticSCM.XmlReaderCData", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter)
+
+bool FXmlReaderCDataUnitTest::RunTest(const FString& Parameters)
+{
+	static const FAnsiStringView Xml("<Root>\n  <Comment>\n    <![CDATA[ <b>bold</b> & ]]>\n  </Comment>\n  <Comment>Text <![CDATA[and <CDATA>]]><!-- note --> then text </Comment>\n  <Comment><Child>skipped</Child></Comment>\n</Root>\n");
+	static const FAnsiStringView Tags[] = { "Comment" };
+	FPlasticSourceControlXmlReader Reader(Xml, Tags);
+	TArray<FString> Comments;
+	while (Reader.Next())
+	{
+		if (Reader.IsStart() && (Reader.GetTagId() == 0))
+		{
+			const FAnsiStringView Content = Reader.ReadContent();
+			Comments.Add(FString(Content.Len(), Content.GetData()));
+		}
+	}
+
+	TestFalse(TEXT("No syntax error"), Reader.HasError());
+	TestEqual(TEXT("Number of comments"), Comments.Num(), 3);
+	if (Comments.Num() == 3)
+	{
+		TestEqual(TEXT("CDATA section as text, not trimmed"), Comments[0], FString(TEXT(" <b>bold</b> & ")));
+		TestEqual(TEXT("Text and CDATA sections concatenated"), Comments[1], FString(TEXT("Text and <CDATA> then text")));
+		TestEqual(TEXT("Child elements skipped"), Comments[2], FString());
+	}
+
+	return true; // actual results are returned by TestXxx() macros
+}
+
+// Write a synthetic result file of a "cm history --moveddeleted --xml --encoding="utf-8"" with two revisions for each file, and create the states of the files
+static FString WriteHistoryResultFile(FAutomationTestBase& InTest, const int32 InNumFiles, TArray<FPlasticSourceControlState>& OutStates)
+{
+	FString Xml;
+	Xml.Reserve(InNumFiles * 900);
+	Xml += TEXT("<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<RevisionHistoriesResult>\n  <RevisionHistories>\n");
+	OutStates.Reserve(InNumFiles);
+	for (int32 Index = 0; Index < InNumFiles; Index++)
+	{
+		FString Filename = FString::Printf(TEXT("C:/Workspace/UEPlasticPluginDev/Content/Folder%d/Asset_%d.uasset"), Index / 100, Index);
+		Xml += FString::Printf(TEXT("    <RevisionHistory>\n      <ItemName>%s</ItemName>\n      <Revisions>\n"), *Filename);
+		for (int32 Changeset = Index + 1; Changeset <= Index + 2; Changeset++)
+		{
+			Xml += FString::Printf(TEXT("        <Revision>\n          <RevisionSpec>%s#cs:%d</RevisionSpec>\n          <Branch>/main</Branch>\n          <CreationDate>2024-04-02T16:20:11+02:00</CreationDate>\n          <RevisionType>bin</RevisionType>\n          <ChangesetNumber>%d</ChangesetNumber>\n          <Owner>user%d@unity3d.com</Owner>\n          <Comment>Changeset %d</Comment>\n          <ItemId>%d</ItemId>\n          <Size>%d</Size>\n          <Hash>zzuB6G9fbWz1md12+tvBxg==</Hash>\n        </Revision>\n"),
+				*Filename, Changeset, Changeset, Index % 10, Changeset, Index, 1000 + Changeset);
+		}
+		Xml += TEXT("      </Revisions>\n    </RevisionHistory>\n");
+		OutStates.Emplace(MoveTemp(Filename));
+	}
+	Xml += TEXT("  </RevisionHistories>\n</RevisionHistoriesResult>\n");
+
+	const FString XmlFilename = FPaths::CreateTempFilename(*FPaths::ProjectSavedDir(), TEXT("History-"), TEXT(".xml"));
+	InTest.TestTrue(FString::Printf(TEXT("Write '%s'"), *XmlFilename), FFileHelper::SaveStringToFile(Xml, *XmlFilename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM));
+	return XmlFilename;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHistoryParserBenchmarkUnitTest, "PlasticSCM.HistoryParserBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::PerfFilter)
+
+bool FHistoryParserBenchmarkUnitTest::RunTest(const FString& Parameters)
+{
+	// Parse the history of 1k then 10k files, keeping the best of a few runs to reduce the noise of the measures
+	// Note: the timings depend on the load of the machine, so the linearity is only checked with a generous slack
+	// (10 times more files should take about 10 times longer, versus 100 times longer for a quadratic lookup)
+	static const int32 NumRuns = 3;
+	static const int32 NumFilesSmall = 1000;
+	static const int32 NumFilesLarge = 10000;
+	double ElapsedTimes[2] = { 0.0, 0.0 };
+	int32 NumRevisions[2] = { 0, 0 };
+	int32 NumMismatches[2] = { 0, 0 };
+	bool bResults[2] = { true, true };
+	for (int32 SizeIndex = 0; SizeIndex < 2; SizeIndex++)
+	{
+		const int32 NumFiles = (SizeIndex == 0) ? NumFilesSmall : NumFilesLarge;
+		for (int32 Run = 0; Run < NumRuns; Run++)
+		{
+			TArray<FPlasticSourceControlState> States;
+			const FString XmlFilename = WriteHistoryResultFile(*this, NumFiles, States);
+
+			const double StartTime = FPlatformTime::Seconds();
+			bResults[SizeIndex] &= PlasticSourceControlParsers::ParseHistoryResults(true, XmlFilename, States);
+			const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+			ElapsedTimes[SizeIndex] = (Run == 0) ? ElapsedTime : FMath::Min(ElapsedTimes[SizeIndex], ElapsedTime);
+
+			IFileManager::Get().Delete(*XmlFilename);
+
+			// Each file has the revisions of its own history, from changesets Index+1 and Index+2
+			NumRevisions[SizeIndex] = 0;
+			NumMismatches[SizeIndex] = 0;
+			for (int32 Index = 0; Index < States.Num(); Index++)
+			{
+				const FPlasticSourceControlState& State = States[Index];
+				NumRevisions[SizeIndex] += State.History.Num();
+				for (const auto& Revision : State.History)
+				{
+					if ((Revision->ChangesetNumber != Index + 1) && (Revision->ChangesetNumber != Index + 2))
+					{
+						NumMismatches[SizeIndex]++;
+					}
+				}
+			}
+		}
+	}
+
+	const double Ratio = ElapsedTimes[1] / FMath::Max(ElapsedTimes[0], 1e-6);
+	AddInfo(FString::Printf(TEXT("Parsed the history of %d files in %.3lfs and of %d files in %.3lfs (x%.1lf)"), NumFilesSmall, ElapsedTimes[0], NumFilesLarge, ElapsedTimes[1], Ratio));
+
+	TestTrue(TEXT("Parse result"), bResults[0] && bResults[1]);
+	TestEqual(TEXT("Number of revisions"), NumRevisions[0], NumFilesSmall * 2);
+	TestEqual(TEXT("Number of revisions"), NumRevisions[1], NumFilesLarge * 2);
+	TestEqual(TEXT("Revisions matched to their file"), NumMismatches[0] + NumMismatches[1], 0);
+	// A time too short to be measured reliably is not compared
+	if (ElapsedTimes[0] >= 0.001)
+	{
+		TestTrue(FString::Printf(TEXT("Linear parsing time (x%.1lf for x%d files)"), Ratio, NumFilesLarge / NumFilesSmall), Ratio < 30.0);
+	}
+
+	return true; // actual results are returned by TestXxx() macros
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStateCacheUnitTest, "PlasticSCM.StateCache", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::PerfFilter)
+
+bool FStateCacheUnitTest::RunTest(const FString& Parameters)
+{
+	// 100k files in 1000 folders of 10 top level directories, one file out of 50 being checked-out
+	static const int32 NumFiles = 100000;
+	FPlasticSourceControlStateCache StateCache;
+	for (int32 Index = 0; Index < NumFiles; Index++)
+	{
+		FPlasticSourceControlStateRef State = StateCache.FindOrAdd(FString::Printf(TEXT("c:/Workspace/Content/Dir%d/Folder%d/Asset_%d.uasset"), Index % 10, Index / 100, Index));
+		State->WorkspaceState = (Index % 50 == 0) ? EWorkspaceState::CheckedOutChanged : EWorkspaceState::Controlled;
+	}
+
+	auto IsCheckedOut = [](const FPlasticSourceControlStateRef& InState) { return InState->WorkspaceState == EWorkspaceState::CheckedOutChanged; };
+
+	// Reference full scan of the cache, filtering by path
+	static const FString Directory(TEXT("c:/Workspace/Content/Dir0/"));
+	const double ScanStartTime = FPlatformTime::Seconds();
+	const TArray<FPlasticSourceControlStateRef> ScanStates = StateCache.GetByPredicate([&IsCheckedOut](const FPlasticSourceControlStateRef& InState) {
+		return IsCheckedOut(InState) && InState->GetFilename().StartsWith(Directory);
+	});
+	const double ScanElapsedTime = FPlatformTime::Seconds() - ScanStartTime;
+
+	const double IndexStartTime = FPlatformTime::Seconds();
+	const TArray<FPlasticSourceControlStateRef> IndexStates = StateCache.GetUnderDirectory(Directory, IsCheckedOut);
+	const double IndexElapsedTime = FPlatformTime::Seconds() - IndexStartTime;
+
+	AddInfo(FString::Printf(TEXT("Checked-out files under a directory of a cache of %d files: %.3lfs for a scan vs %.3lfs with the index by directory"), NumFiles, ScanElapsedTime, IndexElapsedTime));
+
+	TestEqual(TEXT("Number of states"), StateCache.Num(), NumFiles);
+	TestEqual(TEXT("Number of checked-out files under the directory"), IndexStates.Num(), NumFiles / 50); // all the checked-out files are in Dir0
+	TestEqual(TEXT("Same states as a scan"), IndexStates.Num(), ScanStates.Num());
+	TestTrue(TEXT("Find ignoring case"), StateCache.Find(TEXT("C:/WORKSPACE/Content/Dir0/Folder0/Asset_0.uasset")).IsValid());
+	TestEqual(TEXT("Sub-directory without trailing slash"), StateCache.GetUnderDirectory(TEXT("c:/Workspace/Content/Dir0/Folder0"), IsCheckedOut).Num(), 2);
+	TestEqual(TEXT("Unknown directory"), StateCache.GetUnderDirectory(TEXT("c:/Workspace/Plugins"), IsCheckedOut).Num(), 0);
+
+	TestTrue(TEXT("Remove"), StateCache.Remove(TEXT("c:/Workspace/Content/Dir0/Folder0/Asset_0.uasset")));
+	TestFalse(TEXT("Removed"), StateCache.Find(TEXT("c:/Workspace/Content/Dir0/Folder0/Asset_0.uasset")).IsValid());
+	TestEqual(TEXT("Removed from the index"), StateCache.GetUnderDirectory(TEXT("c:/Workspace/Content/Dir0/Folder0"), IsCheckedOut).Num(), 1);
+
+	StateCache.Empty();
+	TestEqual(TEXT("Empty"), StateCache.Num(), 0);
+	TestEqual(TEXT("Empty index"), StateCache.GetUnderDirectory(Directory, IsCheckedOut).Num(), 0);
+
+	return true; // actual results are returned by TestXxx() macros
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInternedStringUnitTest, "PlasticSCM.InternedString", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter)
+
+bool FInternedStringUnitTest::RunTest(const FString& Parameters)
+{
+	const FPlasticSourceControlInternedString Branch(FString(TEXT("/main/task001")));
+	const FPlasticSourceControlInternedString SameBranch(FString(TEXT("/main/task001")));
+	const FPlasticSourceControlInternedString OtherCaseBranch(FString(TEXT("/main/TASK001")));
+	const FPlasticSourceControlInternedString Empty(FString(TEXT("")));
+
+	TestTrue(TEXT("Same string shared"), &Branch.Get() == &SameBranch.Get());
+	TestTrue(TEXT("Case preserved"), &Branch.Get() != &OtherCaseBranch.Get());
+	TestTrue(TEXT("Compare ignoring case"), Branch == OtherCaseBranch);
+	TestTrue(TEXT("Compare to FString"), Branch == FString(TEXT("/main/task001")));
+	TestTrue(TEXT("Different strings"), Branch != FString(TEXT("/main")));
+	TestTrue(TEXT("Empty"), Empty.IsEmpty() && Empty.Get().IsEmpty());
+
+	return true; // actual results are returned by TestXxx() macros
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMetadataCacheUnitTest, "PlasticSCM.MetadataCache", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter)
+
+bool FMetadataCacheUnitTest::RunTest(const FString& Parameters)
+{
+	// Use a temporary directory, to never touch the cache of the project
+	const FString CacheDir = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("PlasticSCM"), TEXT("MetadataCache"));
+	IFileManager::Get().DeleteDirectory(*CacheDir, false, true);
+	const FString RepositorySpecification = TEXT("UnitTestRepository@localhost:8087");
+
+	PlasticSourceControlMetadataCache::FChangesetsCache ChangesetsCache;
+	TestFalse(TEXT("No changesets cached"), PlasticSourceControlMetadataCache::LoadChangesets(CacheDir, RepositorySpecification, ChangesetsCache));
+
+	// Round-trip of the changesets
+	ChangesetsCache.FromDate = FDateTime(2024, 1, 1);
+	ChangesetsCache.FullRefreshDate = FDateTime(2024, 2, 3, 12, 0, 0);
+	for (int32 ChangesetId = 3; ChangesetId >= 1; ChangesetId--)
+	{
+		FPlasticSourceControlChangesetRef Changeset = MakeShareable(new FPlasticSourceControlChangeset());
+		Changeset->ChangesetId = ChangesetId;
+		Changeset->CreatedBy = TEXT("user@example.com");
+		Changeset->Date = FDateTime(2024, 2, ChangesetId);
+		Changeset->Comment = FString::Printf(TEXT("Comment %d"), ChangesetId);
+		Changeset->Branch = TEXT("/main");
+		ChangesetsCache.Changesets.Add(Changeset);
+	}
+	TestTrue(TEXT("Save changesets"), PlasticSourceControlMetadataCache::SaveChangesets(CacheDir, RepositorySpecification, ChangesetsCache));
+	PlasticSourceControlMetadataCache::FChangesetsCache LoadedChangesetsCache;
+	TestTrue(TEXT("Load changesets"), PlasticSourceControlMetadataCache::LoadChangesets(CacheDir, RepositorySpecification, LoadedChangesetsCache));
+	TestEqual(TEXT("Changesets from date"), LoadedChangesetsCache.FromDate, ChangesetsCache.FromDate);
+	TestEqual(TEXT("Changesets full refresh date"), LoadedChangesetsCache.FullRefreshDate, ChangesetsCache.FullRefreshDate);
+	if (TestEqual(TEXT("Number of changesets"), LoadedChangesetsCache.Changesets.Num(), ChangesetsCache.Changesets.Num()))
+	{
+		for (int32 Index = 0; Index < ChangesetsCache.Changesets.Num(); Index++)
+		{
+			TestEqual(TEXT("Changeset id"), LoadedChangesetsCache.Changesets[Index]->ChangesetId, ChangesetsCache.Changesets[Index]->ChangesetId);
+			TestEqual(TEXT("Changeset date"), LoadedChangesetsCache.Changesets[Index]->Date, ChangesetsCache.Changesets[Index]->Date);
+			TestEqual(TEXT("Changeset comment"), LoadedChangesetsCache.Changesets[Index]->Comment, ChangesetsCache.Changesets[Index]->Comment);
+			TestEqual(TEXT("Changeset branch"), LoadedChangesetsCache.Changesets[Index]->Branch, ChangesetsCache.Changesets[Index]->Branch);
+		}
+	}
+
+	// Round-trip of the branches
+	PlasticSourceControlMetadataCache::FBranchesCache BranchesCache;
+	BranchesCache.FromDate = FDateTime(2024, 1, 1);
+	BranchesCache.RefreshDate = FDateTime(2024, 3, 1, 12, 30);
+	FPlasticSourceControlBranchRef Branch = MakeShareable(new FPlasticSourceControlBranch());
+	Branch->Name = TEXT("/main/task001");
+	Branch->Repository = TEXT("UnitTestRepository");
+	Branch->CreatedBy = TEXT("user@example.com");
+	Branch->Date = FDateTime(2024, 2, 1);
+	Branch->Comment = TEXT("Task 1");
+	BranchesCache.Branches.Add(Branch);
+	TestTrue(TEXT("Save branches"), PlasticSourceControlMetadataCache::SaveBranches(CacheDir, RepositorySpecification, BranchesCache));
+	PlasticSourceControlMetadataCache::FBranchesCache LoadedBranchesCache;
+	TestTrue(TEXT("Load branches"), PlasticSourceControlMetadataCache::LoadBranches(CacheDir, RepositorySpecification, LoadedBranchesCache));
+	TestEqual(TEXT("Branches refresh date"), LoadedBranchesCache.RefreshDate, BranchesCache.RefreshDate);
+	if (TestEqual(TEXT("Number of branches"), LoadedBranchesCache.Branches.Num(), 1))
+	{
+		TestEqual(TEXT("Branch name"), LoadedBranchesCache.Branches[0]->Name, Branch->Name);
+		TestEqual(TEXT("Branch comment"), LoadedBranchesCache.Branches[0]->Comment, Branch->Comment);
+	}
+
+	// Another repository doesn't see these records, and the invalidation deletes them
+	PlasticSourceControlMetadataCache::FBranchesCache OtherBranchesCache;
+	TestFalse(TEXT("Other repository"), PlasticSourceControlMetadataCache::LoadBranches(CacheDir, TEXT("OtherRepository@localhost:8087"), OtherBranchesCache));
+	PlasticSourceControlMetadataCache::Invalidate(CacheDir, RepositorySpecification);
+	TestFalse(TEXT("Changesets invalidated"), PlasticSourceControlMetadataCache::LoadChangesets(CacheDir, RepositorySpecification, LoadedChangesetsCache));
+	TestFalse(TEXT("Branches invalidated"), PlasticSourceControlMetadataCache::LoadBranches(CacheDir, RepositorySpecification, LoadedBranchesCache));
+
+	IFileManager::Get().DeleteDirectory(*CacheDir, false, true);
+
+	return true; // actual results are returned by TestXxx() macros
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChangesetFilesCacheUnitTest, "PlasticSCM.ChangesetFilesCache", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter)
+
+bool FChangesetFilesCacheUnitTest::RunTest(const FString& Parameters)
+{
+	const FString RepositorySpecification = TEXT("UnitTestRepository@localhost:8087");
+	FPlasticSourceControlChangesetFilesCache Cache;
+	TArray<FPlasticSourceControlStateRef> Files;
+	Files.Add(MakeShareable(new FPlasticSourceControlState(FString(TEXT("/Game/Maps/Map.umap")))));
+
+	// Fill the cache, touching the first changeset so that the second one is the least recently used
+	Cache.Add(RepositorySpecification, 1, Files);
+	Cache.Add(RepositorySpecification, 2, Files);
+	TArray<FPlasticSourceControlStateRef> FoundFiles;
+	TestTrue(TEXT("Find cs:1"), Cache.Find(RepositorySpecification, 1, FoundFiles));
+	TestEqual(TEXT("Files of cs:1"), FoundFiles.Num(), 1);
+	for (int32 ChangesetId = 3; ChangesetId <= FPlasticSourceControlChangesetFilesCache::MaxNumChangesets + 1; ChangesetId++)
+	{
+		Cache.Add(RepositorySpecification, ChangesetId, TArray<FPlasticSourceControlStateRef>());
+	}
+	TestEqual(TEXT("Cache bounded"), Cache.Num(), FPlasticSourceControlChangesetFilesCache::MaxNumChangesets);
+	TestTrue(TEXT("Most recently used kept"), Cache.Find(RepositorySpecification, 1, FoundFiles));
+	TestFalse(TEXT("Least recently used evicted"), Cache.Find(RepositorySpecification, 2, FoundFiles));
+
+	// Changesets of another repository replace the ones cached
+	TestFalse(TEXT("Other repository"), Cache.Find(TEXT("OtherRepository@localhost:8087"), 1, FoundFiles));
+	Cache.Add(TEXT("OtherRepository@localhost:8087"), 1, TArray<FPlasticSourceControlStateRef>());
+	TestEqual(TEXT("Cache of the other repository"), Cache.Num(), 1);
+	TestFalse(TEXT("Changesets of the first repository removed"), Cache.Find(RepositorySpecification, 1, FoundFiles));
+
+	return true; // actual results are returned by TestXxx() macros
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FListFilterUnitTest, "PlasticSCM.ListFilter", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter)
+
+bool FListFilterUnitTest::RunTest(const FString& Parameters)
+{
+	auto PopulateSearchStrings = [](const FString& InItem, TArray<FString>& OutStrings) { OutStrings.Add(InItem); };
+	auto IsLessDescending = [](const FString& InLhs, const FString& InRhs) { return InLhs > InRhs; };
+	TArray<FString> Rows;
+
+	TPlasticSourceControlListFilter<FString> ListFilter;
+	ListFilter.SetItems({ TEXT("/main"), TEXT("/main/task001"), TEXT("/main/task002"), TEXT("/main/Release") }, PopulateSearchStrings);
+
+	// Simple search texts, refined incrementally
+	TestTrue(TEXT("Filter task"), ListFilter.Filter(TEXT("task"), [](const FString&) { return false; }));
+	ListFilter.GetRows(Rows);
+	TestEqual(TEXT("Rows matching task"), Rows.Num(), 2);
+	ListFilter.GetSortedRows(TEXT("Descending"), IsLessDescending, Rows);
+	if (TestEqual(TEXT("Sorted rows matching task"), Rows.Num(), 2))
+	{
+		TestEqual(TEXT("First sorted row"), Rows[0], FString(TEXT("/main/task002")));
+	}
+	ListFilter.Filter(TEXT("task001"), [](const FString&) { return false; });
+	ListFilter.GetSortedRows(TEXT("Descending"), IsLessDescending, Rows);
+	TestEqual(TEXT("Rows matching task001"), Rows.Num(), 1);
+	ListFilter.Filter(TEXT("TASK"), [](const FString&) { return false; });
+	ListFilter.GetRows(Rows);
+	TestEqual(TEXT("Rows matching TASK, ignoring case"), Rows.Num(), 2);
+	ListFilter.Filter(TEXT("main release"), [](const FString&) { return false; });
+	ListFilter.GetRows(Rows);
+	TestEqual(TEXT("Rows matching all the words"), Rows.Num(), 1);
+
+	// Search texts using the syntax of TTextFilter are evaluated by the full filter
+	TArray<FString> Words;
+	TestFalse(TEXT("Operator not simple"), TPlasticSourceControlListFilter<FString>::ParseSimpleFilterText(TEXT("-task"), Words));
+	TestTrue(TEXT("Filter -task"), ListFilter.Filter(TEXT("-task"), [](const FString& InItem) { return !InItem.Contains(TEXT("task")); }));
+	ListFilter.GetRows(Rows);
+	TestEqual(TEXT("Rows matching -task"), Rows.Num(), 2);
+
+	// Many items are filtered in the background
+	TArray<FString> Items;
+	for (int32 Index = 0; Index < 2 * TPlasticSourceControlListFilter<FString>::MinNumItemsToFilterAsync; Index++)
+	{
+		Items.Add(FString::Printf(TEXT("Item%d"), Index));
+	}
+	ListFilter.SetItems(Items, PopulateSearchStrings);
+	TestFalse(TEXT("Filter in the background"), ListFilter.Filter(TEXT("item59"), [](const FString&) { return false; }));
+	const double StartTime = FPlatformTime::Seconds();
+	while (!ListFilter.Tick() && (FPlatformTime::Seconds() - StartTime < 10.0))
+	{
+		FPlatformProcess::Sleep(0.01f);
+	}
+	TestFalse(TEXT("Filter completed"), ListFilter.IsFiltering());
+	ListFilter.GetRows(Rows);
+	TestEqual(TEXT("Rows matching item59"), Rows.Num(), 111);
+
+	return true; // actual results are returned by TestXxx() macros
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRevisionCacheUnitTest, "PlasticSCM.RevisionCache", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter)
+
+bool FRevisionCacheUnitTest::RunTest(const FString& Parameters)
+{
+	const FString TestDir = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("PlasticSCM"), TEXT("RevisionCache"));
+	IFileManager::Get().DeleteDirectory(*TestDir, false, true);
+	const FPlasticSourceControlRevisionCache Cache(FPaths::Combine(TestDir, TEXT("Cache")));
+	const FString DownloadedFilename = FPaths::Combine(TestDir, TEXT("temp-cs12-BP.uasset"));
+	const FString FoundFilename = FPaths::Combine(TestDir, TEXT("temp-rev920-BP.uasset"));
+	const FString Content = TEXT("0123456789");
+	const FString Content2 = TEXT("abcdefghij");
+	const FString Hash1 = TEXT("eB5eJF1ptWaXm4bijSPyxw=="); // MD5 of Content
+	const FString Hash2 = TEXT("qSVXaULpSy71egZhAbSIdg=="); // MD5 of Content2
+	const int64 MaxSizeBytes = 1024;
+
+	// The content downloaded under a revision specification is found under another one
+	FFileHelper::SaveStringToFile(Content, *DownloadedFilename);
+	TestFalse(TEXT("Not cached yet"), Cache.Find(Hash1, FoundFilename));
+	TestTrue(TEXT("Add"), Cache.Add(Hash1, DownloadedFilename, MaxSizeBytes));
+	TestTrue(TEXT("Find"), Cache.Find(Hash1, FoundFilename));
+	FString FoundContent;
+	FFileHelper::LoadFileToString(FoundContent, *FoundFilename);
+	TestEqual(TEXT("Content found"), FoundContent, Content);
+	TestTrue(TEXT("Add again"), Cache.Add(Hash1, DownloadedFilename, MaxSizeBytes));
+	TestFalse(TEXT("Invalid hash"), Cache.Add(TEXT("not a hash"), DownloadedFilename, MaxSizeBytes));
+	TestFalse(TEXT("Empty hash"), Cache.Find(FString(), FoundFilename));
+	TestFalse(TEXT("Cache disabled"), Cache.Add(Hash2, DownloadedFilename, 0));
+	TestFalse(TEXT("Content not matching its hash"), Cache.Add(Hash2, DownloadedFilename, MaxSizeBytes));
+	TestFalse(TEXT("Content not cached under another hash"), Cache.Find(Hash2, FoundFilename));
+
+	// Above the size limit, the least recently used content is evicted
+	IFileManager::Get().SetTimeStamp(*FPaths::Combine(Cache.GetCacheDir(), TEXT("78"), TEXT("781e5e245d69b566979b86e28d23f2c7")), FDateTime::UtcNow() - FTimespan::FromMinutes(1.0));
+	FFileHelper::SaveStringToFile(Content2, *DownloadedFilename);
+	TestTrue(TEXT("Add a second content"), Cache.Add(Hash2, DownloadedFilename, Content.Len() * 2));
+	TestEqual(TEXT("Within the size limit"), Cache.Trim(Content.Len()), static_cast<int64>(Content.Len()));
+	TestFalse(TEXT("Least recently used evicted"), Cache.Find(Hash1, FoundFilename));
+	TestTrue(TEXT("Most recently used kept"), Cache.Find(Hash2, FoundFilename));
+
+	IFileManager::Get().DeleteDirectory(*TestDir, false, true);
+
+	return true; // actual results are returned by TestXxx() macros
+}
+
+#if PLATFORM_LINUX || PLATFORM_MAC
+
+// Worker of the "Connect" operations of a test provider: the first one runs a command on a dedicated fake 'cm shell', the other ones only wait to be cancelled
+class FShellCancellationTestWorker final : public IPlasticSourceControlWorker
+{
+public:
+	FShellCancellationTestWorker(FPlasticSourceControlProvider& InProvider, PlasticSourceControlShell::FDedicatedShell& InShell, std::atomic<int32>& InNumExecuted)
+		: IPlasticSourceControlWorker(InProvider)
+		, Shell(InShell)
+		, NumExecuted(InNumExecuted)
+	{
+	}
+
+	virtual FName GetName() const override
+	{
+		return "Connect";
+	}
+
+	virtual bool Execute(FPlasticSourceControlCommand& InCommand) override
+	{
+		if (NumExecuted++ == 0)
+		{
+			FString Results;
+			FString Errors;
+			return Shell.RunCommand(TEXT("history"), TArray<FString>(), TArray<FString>(), Results, Errors);
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		while (!PlasticSourceControlShell::IsCancelRequested() && (FPlatformTime::Seconds() - StartTime < 30.0))
+		{
+			FPlatformProcess::Sleep(0.01f);
+		}
+		return false;
+	}
+
+	virtual bool UpdateStates() override
+	{
+		return false;
+	}
+
+private:
+	PlasticSourceControlShell::FDedicatedShell& Shell;
+	std::atomic<int32>& NumExecuted;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FShellCancellationUnitTest, "PlasticSCM.ShellCancellation", EAutomationTestFlags::EditorContext | EAutomationTestFlags::CommandletContext | EAutomationTestFlags::ProductFilter)
+
+bool FShellCancellationUnitTest::RunTest(const FString& Parameters)
+{
+	// Fake 'cm shell' taking 30s to run any command, on a dedicated shell, so that the shells of the provider are left untouched
+	const FString WorkingDirectory = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir());
+	const FString FakeCmPath = FPaths::Combine(WorkingDirectory, TEXT("fake_cm.sh"));
+	FFileHelper::SaveStringToFile(TEXT("#!/bin/sh\nwhile read -r line; do\n  [ \"$line\" = \"exit\" ] && exit 0\n  sleep 30\n  echo \"CommandResult 0\"\ndone\n"), *FakeCmPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	FPlatformProcess::ExecProcess(TEXT("/bin/chmod"), *FString::Printf(TEXT("+x \"%s\""), *FakeCmPath), nullptr, nullptr, nullptr);
+	PlasticSourceControlShell::FDedicatedShell Shell;
+	TestTrue(TEXT("Launch the fake cm shell"), Shell.Launch(FakeCmPath, WorkingDirectory));
+
+	// Cancel a command running in the background
+	volatile int32 bCancelled = 0;
+	FString Errors;
+	TFuture<bool> Result = Async(EAsyncExecution::Thread, [&bCancelled, &Errors, &Shell]()
+	{
+		PlasticSourceControlShell::FScopedCancellation Cancellation(&bCancelled);
+		FString Results;
+		return Shell.RunCommand(TEXT("history"), TArray<FString>(), TArray<FString>(), Results, Errors);
+	});
+	FPlatformProcess::Sleep(0.2f);
+	const double CancelStartTime = FPlatformTime::Seconds();
+	FPlatformAtomics::InterlockedExchange(&bCancelled, 1);
+	const bool bResult = Result.Get();
+	const double CancelElapsedTime = FPlatformTime::Seconds() - CancelStartTime;
+
+	AddInfo(FString::Printf(TEXT("Command stopped %.3lfs after its cancellation"), CancelElapsedTime));
+	TestFalse(TEXT("Cancelled command result"), bResult);
+	TestEqual(TEXT("Cancelled command errors"), Errors, FString(TEXT("Cancelled")));
+	TestTrue(TEXT("Cancelled command stopped before its end"), CancelElapsedTime < 5.0);
+
+	// A command run after the cancellation fails immediately, without being sent to a shell
+	{
+		PlasticSourceControlShell::FScopedCancellation Cancellation(&bCancelled);
+		FString Results;
+		FString NextErrors;
+		const double NextStartTime = FPlatformTime::Seconds();
+		TestFalse(TEXT("Next command result"), Shell.RunCommand(TEXT("status"), TArray<FString>(), TArray<FString>(), Results, NextErrors));
+		TestTrue(TEXT("Next command not run"), FPlatformTime::Seconds() - NextStartTime < 1.0);
+	}
+
+	// A command run by a task of the pool of threads is cancelled with the thread that started the task
+	volatile int32 bTaskCancelled = 0;
+	TFuture<bool> TaskResult = Async(EAsyncExecution::Thread, [&bTaskCancelled, &Shell]()
+	{
+		PlasticSourceControlShell::FScopedCancellation Cancellation(&bTaskCancelled);
+		bool bTaskResult = true;
+		PlasticSourceControlShell::FCommandTask Task([&bTaskResult, &Shell]()
+		{
+			FString Results;
+			FString TaskErrors;
+			bTaskResult = Shell.RunCommand(TEXT("history"), TArray<FString>(), TArray<FString>(), Results, TaskErrors);
+		});
+		// Let a thread of the pool start the task, instead of running it on this thread
+		FPlatformProcess::Sleep(0.1f);
+		Task.Wait();
+		return bTaskResult;
+	});
+	FPlatformProcess::Sleep(0.2f);
+	const double TaskCancelStartTime = FPlatformTime::Seconds();
+	FPlatformAtomics::InterlockedExchange(&bTaskCancelled, 1);
+	TestFalse(TEXT("Cancelled task result"), TaskResult.Get());
+	TestTrue(TEXT("Cancelled task stopped before its end"), FPlatformTime::Seconds() - TaskCancelStartTime < 5.0);
+
+	// Cancel the operations of a provider of its own, running or waiting in its queue
+	if (GThreadPool != nullptr)
+	{
+		FPlasticSourceControlProvider TestProvider;
+		std::atomic<int32> NumExecuted(0);
+		TestProvider.RegisterWorker("Connect", FGetPlasticSourceControlWorker::CreateLambda([&Shell, &NumExecuted](FPlasticSourceControlProvider& InProvider) -> FPlasticSourceControlWorkerRef
+		{
+			return MakeShareable(new FShellCancellationTestWorker(InProvider, Shell, NumExecuted));
+		}));
+
+		// Fill the slots of the background commands, so that the last operation waits in the queue
+		const int32 NumRunning = PlasticSourceControlShell::GetShellPoolSize();
+		TArray<FSourceControlOperationRef> Operations;
+		TArray<int32> OperationResults;
+		OperationResults.Init(INDEX_NONE, NumRunning + 1);
+		for (int32 Index = 0; Index < NumRunning + 1; Index++)
+		{
+			Operations.Add(ISourceControlOperation::Create<FConnect>());
+			static_cast<ISourceControlProvider&>(TestProvider).Execute(Operations[Index], EConcurrency::Asynchronous, FSourceControlOperationComplete::CreateLambda([&OperationResults, Index](const FSourceControlOperationRef&, ECommandResult::Type InResult)
+			{
+				OperationResults[Index] = InResult;
+			}));
+		}
+		TestEqual(TEXT("Operation waiting in the queue"), TestProvider.GetCommandQueueStats(EPlasticCommandPriority::Background).QueueDepth, 1);
+
+		// An operation waiting in the queue is removed from it, and completed on next Tick()
+		TestTrue(TEXT("Can cancel the waiting operation"), TestProvider.CanCancelOperation(Operations[NumRunning]));
+		TestProvider.CancelOperation(Operations[NumRunning]);
+		TestEqual(TEXT("Operation removed from the queue"), TestProvider.GetCommandQueueStats(EPlasticCommandPriority::Background).QueueDepth, 0);
+		TestEqual(TEXT("Operation not completed from CancelOperation"), OperationResults[NumRunning], static_cast<int32>(INDEX_NONE));
+		TestFalse(TEXT("Can't cancel the operation again"), TestProvider.CanCancelOperation(Operations[NumRunning]));
+
+		// Running operations complete as soon as their command has been stopped
+		FPlatformProcess::Sleep(0.2f);
+		const double OperationsCancelStartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumRunning; Index++)
+		{
+			TestProvider.CancelOperation(Operations[Index]);
+		}
+		while (OperationResults.Contains(INDEX_NONE) && (FPlatformTime::Seconds() - OperationsCancelStartTime < 10.0))
+		{
+			TestProvider.Tick();
+			FPlatformProcess::Sleep(0.01f);
+		}
+		AddInfo(FString::Printf(TEXT("Operations completed %.3lfs after their cancellation"), FPlatformTime::Seconds() - OperationsCancelStartTime));
+		for (int32 Index = 0; Index < NumRunning + 1; Index++)
+		{
+			TestEqual(TEXT("Cancelled operation result"), OperationResults[Index], static_cast<int32>(ECommandResult::Cancelled));
+		}
+		TestTrue(TEXT("Waiting operation not executed"), NumExecuted <= NumRunning);
+	}
+
+	Shell.Terminate();
+	IFileManager::Get().Delete(*FakeCmPath);
+
+	return true; // actual results are returned by TestXxx() macros
+}
+
+#endif
+
 #endif
@@ -0,0 +1,258 @@
+// Copyright (c) 2025 Unity Technologies
+
+#include "PlasticSourceControlWorkspaceWatcher.h"
+
+#include "PlasticSourceControlModule.h"
+#include "PlasticSourceControlProjectSettings.h"
+#include "PlasticSourceControlProvider.h"
+
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+
+#include "ISourceControlModule.h" // LogSourceControl
+
+// Above this number of files changed on disk, a full status is faster than a status of each of them
+static const int32 MaxDirtyFiles = 5000;
+
+void FPlasticSourceControlWorkspaceWatcher::Start(const FString& InWorkspaceRoot)
+{
+	check(IsInGameThread());
+
+	Stop();
+
+	FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+	IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get();
+	if (DirectoryWatcher == nullptr)
+		return;
+
+	const bool bWatching = DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(
+		InWorkspaceRoot,
+		IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FPlasticSourceControlWorkspaceWatcher::OnDirectoryChanged),
+		DirectoryChangedHandle,
+		IDirectoryWatcher::WatchOptions::IncludeDirectoryChanges
+	);
+	if (bWatching)
+	{
+		UE_LOG(LogSourceControl, Log, TEXT("Watching the workspace %s for changes"), *InWorkspaceRoot);
+		FScopeLock Lock(&CriticalSection);
+		WorkspaceRoot = InWorkspaceRoot;
+		MetadataDir = FPaths::Combine(InWorkspaceRoot, TEXT(".plastic/"));
+	}
+	else
+	{
+		UE_LOG(LogSourceControl, Warning, TEXT("Failed to watch the workspace %s for changes"), *InWorkspaceRoot);
+	}
+}
+
+void FPlasticSourceControlWorkspaceWatcher::Stop()
+{
+	FString PreviousWorkspaceRoot;
+	{
+		FScopeLock Lock(&CriticalSection);
+		PreviousWorkspaceRoot = MoveTemp(WorkspaceRoot);
+		WorkspaceRoot.Reset();
+		DirtyFiles.Reset();
+		DirtyDirectories.Reset();
+		WatchedDirectories.Reset();
+		FullStatusTimes.Reset();
+	}
+
+	if (!PreviousWorkspaceRoot.IsEmpty())
+	{
+		// The module might already have been unloaded when shutting down the Editor
+		if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+		{
+			if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+			{
+				DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(PreviousWorkspaceRoot, DirectoryChangedHandle);
+			}
+		}
+		DirectoryChangedHandle.Reset();
+	}
+}
+
+bool FPlasticSourceControlWorkspaceWatcher::ConsumeDirtyFiles(const FString& InDir, TArray<FString>& OutDirtyFiles)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	if (WorkspaceRoot.IsEmpty())
+		return false;
+
+	WatchedDirectories.Add(InDir);
+
+	bool bFullStatusRequired = true;
+	if (const double* FullStatusTime = FullStatusTimes.Find(InDir))
+	{
+		const double FullStatusInterval = GetDefault<UPlasticSourceControlProjectSettings>()->WorkspaceWatcherFullStatusIntervalMinutes * 60.0;
+		bFullStatusRequired = (FPlatformTime::Seconds() - *FullStatusTime) > FullStatusInterval;
+	}
+	for (const FString& DirtyDirectory : DirtyDirectories)
+	{
+		if (DirtyDirectory.StartsWith(InDir))
+		{
+			bFullStatusRequired = true;
+			break;
+		}
+	}
+
+	// Forget about the changes in the directory since it is about to get a status, either full or restricted to these files
+	for (auto It = DirtyFiles.CreateIterator(); It; ++It)
+	{
+		if (It->StartsWith(InDir))
+		{
+			if (!bFullStatusRequired)
+			{
+				OutDirtyFiles.Add(*It);
+			}
+			It.RemoveCurrent();
+		}
+	}
+	DirtyDirectories.Remove(InDir);
+	for (auto It = DirtyDirectories.CreateIterator(); It; ++It)
+	{
+		if (It->StartsWith(InDir))
+		{
+			It.RemoveCurrent();
+		}
+	}
+	if (bFullStatusRequired)
+	{
+		FullStatusTimes.Remove(InDir);
+	}
+
+	return !bFullStatusRequired;
+}
+
+void FPlasticSourceControlWorkspaceWatcher::MarkDirtyFiles(const TArray<FString>& InFiles)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	if (WorkspaceRoot.IsEmpty())
+		return;
+
+	for (const FString& File : InFiles)
+	{
+		const bool bIsDirectory = !File.IsEmpty() && (File[File.Len() - 1] == TEXT('/'));
+		if (bIsDirectory || !File.StartsWith(WorkspaceRoot))
+		{
+			continue;
+		}
+		if (DirtyFiles.Num() < MaxDirtyFiles)
+		{
+			DirtyFiles.Add(File);
+		}
+		else
+		{
+			FullStatusTimes.Reset();
+			break;
+		}
+	}
+}
+
+void FPlasticSourceControlWorkspaceWatcher::Flush()
+{
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (WorkspaceRoot.IsEmpty())
+			return;
+	}
+
+	if (!IsInGameThread())
+	{
+		// Changes on disk might still be waiting to be notified on the Game Thread
+		Invalidate();
+		return;
+	}
+
+	if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+	{
+		if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+		{
+			// Calls back OnDirectoryChanged() with the changes already reported by the system
+			DirectoryWatcher->Tick(0.0f);
+		}
+	}
+}
+
+void FPlasticSourceControlWorkspaceWatcher::OnFullStatus(const FString& InDir)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	if (!WorkspaceRoot.IsEmpty())
+	{
+		FullStatusTimes.Add(InDir, FPlatformTime::Seconds());
+	}
+}
+
+void FPlasticSourceControlWorkspaceWatcher::Invalidate()
+{
+	FScopeLock Lock(&CriticalSection);
+
+	FullStatusTimes.Reset();
+}
+
+void FPlasticSourceControlWorkspaceWatcher::OnDirectoryChanged(const TArray<FFileChangeData>& InFileChanges)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	for (const FFileChangeData& FileChange : InFileChanges)
+	{
+		FString Filename = FPaths::ConvertRelativePathToFull(FileChange.Filename);
+		FPaths::NormalizeFilename(Filename);
+
+		// Any change to the workspace metadata (checkin, update, switch, or any other operation, even from outside of the Editor) requires a full status
+		if (Filename.StartsWith(MetadataDir))
+		{
+			FullStatusTimes.Reset();
+			continue;
+		}
+
+		// Only track changes in directories getting a status (eg not in Saved/ nor Intermediate/)
+		bool bInWatchedDirectory = false;
+		for (const FString& WatchedDirectory : WatchedDirectories)
+		{
+			if (Filename.StartsWith(WatchedDirectory))
+			{
+				bInWatchedDirectory = true;
+				break;
+			}
+		}
+		if (!bInWatchedDirectory)
+		{
+			continue;
+		}
+
+		switch (FileChange.Action)
+		{
+		case FFileChangeData::FCA_Added:
+		case FFileChangeData::FCA_Modified:
+		case FFileChangeData::FCA_Removed:
+		{
+			// A directory added, removed or renamed requires a full status: tell files from directories by what is on disk,
+			// or for a path that doesn't exist anymore, by whether it was known as a file (else it might have been a directory)
+			const FFileStatData StatData = IFileManager::Get().GetStatData(*Filename);
+			const bool bIsDirectory = StatData.bIsValid ? StatData.bIsDirectory : !FPlasticSourceControlModule::Get().GetProvider().GetStateCache().Find(Filename).IsValid();
+			if (bIsDirectory)
+			{
+				DirtyDirectories.Add(Filename / TEXT(""));
+			}
+			else if (DirtyFiles.Num() < MaxDirtyFiles)
+			{
+				DirtyFiles.Add(MoveTemp(Filename));
+			}
+			else
+			{
+				FullStatusTimes.Reset();
+			}
+			break;
+		}
+		default:
+			// The watcher lost track of some changes (eg FCA_RescanRequired after an overflow of its events)
+			FullStatusTimes.Reset();
+			break;
+		}
+	}
+}
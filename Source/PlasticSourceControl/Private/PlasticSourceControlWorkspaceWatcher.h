@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Unity Technologies
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FFileChangeData;
+
+/**
+ * Watch the files changed on disk in the workspace, to restrict the "status" of a whole directory to the files changed since its last full status.
+ *
+ * The states of all other files are kept from the cache. As a safety net, a full status of the directory is still required:
+ * - periodically (see WorkspaceWatcherFullStatusIntervalMinutes in the Project Settings)
+ * - as soon as something changes in the ".plastic" metadata directory of the workspace (checkin, update, switch... even from the Desktop application)
+ * - when a directory is added, removed or renamed, or when too many files changed at once
+ * - when an operation is issued outside of the Game Thread, where pending notifications of the directory watcher can't be flushed
+ *
+ * Since these notifications arrive late, the files saved by the Editor and the files of operations are also marked as changed directly.
+ */
+class FPlasticSourceControlWorkspaceWatcher
+{
+public:
+	/** Start watching the workspace for changes (on the Game Thread, where the directory watcher calls back) */
+	void Start(const FString& InWorkspaceRoot);
+
+	/** Stop watching the workspace and forget about all changes */
+	void Stop();
+
+	/**
+	 * Get the files changed on disk in a directory since its last full status, and forget about them.
+	 *
+	 * @param	InDir			The directory about to get a status, slash terminated
+	 * @param	OutDirtyFiles	The files changed since the last full status of the directory, if any
+	 * @returns false if a full status of the directory is required instead
+	 */
+	bool ConsumeDirtyFiles(const FString& InDir, TArray<FString>& OutDirtyFiles);
+
+	/** Mark files as changed on disk without waiting for the notifications of the directory watcher (eg a package just saved) */
+	void MarkDirtyFiles(const TArray<FString>& InFiles);
+
+	/** Process the pending notifications of the directory watcher before issuing an operation, or require a full status if not on the Game Thread */
+	void Flush();
+
+	/** Record that a full status of the directory just succeeded, to be used as the reference for the next ones */
+	void OnFullStatus(const FString& InDir);
+
+	/** Require a full status of all directories for their next update */
+	void Invalidate();
+
+private:
+	void OnDirectoryChanged(const TArray<FFileChangeData>& InFileChanges);
+
+	/** Critical section for thread safety, since the status is run by background workers */
+	FCriticalSection CriticalSection;
+
+	/** Path to the root of the workspace being watched, empty if not watching */
+	FString WorkspaceRoot;
+
+	/** Path to the metadata directory of the workspace */
+	FString MetadataDir;
+
+	FDelegateHandle DirectoryChangedHandle;
+
+	/** Files changed on disk since the last full status of their directory */
+	TSet<FString> DirtyFiles;
+
+	/** Directories added, removed or renamed, requiring a full status of any directory containing them */
+	TSet<FString> DirtyDirectories;
+
+	/** Directories getting a status, where changes are tracked */
+	TSet<FString> WatchedDirectories;
+
+	/** Time of the last full status of each directory */
+	TMap<FString, double> FullStatusTimes;
+};
@@ -0,0 +1,321 @@
+// Copyright (c) 2025 Unity Technologies
+
+#include "PlasticSourceControlXmlReader.h"
+
+static bool IsXmlWhitespace(const ANSICHAR InChar)
+{
+	return (InChar == ' ') || (InChar == '\t') || (InChar == '\r') || (InChar == '\n');
+}
+
+FPlasticSourceControlXmlReader::FPlasticSourceControlXmlReader(const FAnsiStringView InXml, TArrayView<const FAnsiStringView> InTags)
+	: Xml(InXml)
+	, Tags(InTags)
+{
+	// Skip the UTF-8 Byte Order Mark if any
+	if ((Xml.Len() >= 3) && (static_cast<uint8>(Xml[0]) == 0xEF) && (static_cast<uint8>(Xml[1]) == 0xBB) && (static_cast<uint8>(Xml[2]) == 0xBF))
+	{
+		Position = 3;
+	}
+}
+
+int32 FPlasticSourceControlXmlReader::FindTagId(const FAnsiStringView InName) const
+{
+	// The tables of tags are small (a dozen of tags at most) so a linear search comparing lengths first is faster than hashing
+	for (int32 Index = 0; Index < Tags.Num(); Index++)
+	{
+		if ((Tags[Index].Len() == InName.Len()) && (FMemory::Memcmp(Tags[Index].GetData(), InName.GetData(), InName.Len()) == 0))
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+// Find a string in the document from a position (a naive search is enough for the short terminators of markups)
+static int32 FindFrom(const FAnsiStringView InXml, const int32 InPosition, const FAnsiStringView InSearch)
+{
+	const int32 LastPosition = InXml.Len() - InSearch.Len();
+	for (int32 Index = InPosition; Index <= LastPosition; Index++)
+	{
+		if ((InXml[Index] == InSearch[0]) && (FMemory::Memcmp(InXml.GetData() + Index, InSearch.GetData(), InSearch.Len()) == 0))
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+bool FPlasticSourceControlXmlReader::SkipPast(const FAnsiStringView InTerminator)
+{
+	const int32 Index = FindFrom(Xml, Position, InTerminator);
+	if (Index == INDEX_NONE)
+	{
+		SetError(TEXT("unterminated markup"));
+		return false;
+	}
+	Position = Index + InTerminator.Len();
+	return true;
+}
+
+void FPlasticSourceControlXmlReader::SetError(const TCHAR* InError)
+{
+	Error = FString::Printf(TEXT("XML syntax error at offset %d: %s"), Position, InError);
+}
+
+bool FPlasticSourceControlXmlReader::Next()
+{
+	if (HasError())
+	{
+		return false;
+	}
+
+	// The end of an empty element is reported right after its start
+	if (bIsEmptyElement)
+	{
+		bIsEmptyElement = false;
+		bIsStart = false;
+		OpenElements.Pop();
+		return true;
+	}
+
+	const int32 XmlLen = Xml.Len();
+	while (Position < XmlLen)
+	{
+		// Skip the text up to the next markup
+		if (Xml[Position] != '<')
+		{
+			Position++;
+			continue;
+		}
+		Position++;
+		if (Position >= XmlLen)
+		{
+			break;
+		}
+
+		const ANSICHAR MarkupChar = Xml[Position];
+		if (MarkupChar == '?')
+		{
+			// XML declaration or processing instruction
+			if (!SkipPast("?>"))
+			{
+				return false;
+			}
+		}
+		else if (MarkupChar == '!')
+		{
+			// Comment, CDATA section or DOCTYPE declaration
+			const FAnsiStringView Markup = Xml.RightChop(Position);
+			if (Markup.StartsWith("!--"))
+			{
+				if (!SkipPast("-->"))
+				{
+					return false;
+				}
+			}
+			else if (Markup.StartsWith("![CDATA["))
+			{
+				if (!SkipPast("]]>"))
+				{
+					return false;
+				}
+			}
+			else if (!SkipPast(">"))
+			{
+				return false;
+			}
+		}
+		else if (MarkupChar == '/')
+		{
+			// End of an element, that needs to match the element currently open
+			const int32 NameStart = Position + 1;
+			if (!SkipPast(">"))
+			{
+				return false;
+			}
+			FAnsiStringView Name = Xml.Mid(NameStart, Position - 1 - NameStart);
+			while ((Name.Len() > 0) && IsXmlWhitespace(Name[Name.Len() - 1]))
+			{
+				Name.RemoveSuffix(1);
+			}
+			if ((OpenElements.Num() == 0) || !OpenElements.Last().Key.Equals(Name, ESearchCase::CaseSensitive))
+			{
+				SetError(TEXT("mismatched end tag"));
+				return false;
+			}
+			bIsStart = false;
+			TagId = OpenElements.Last().Value;
+			Depth = OpenElements.Num();
+			OpenElements.Pop();
+			return true;
+		}
+		else
+		{
+			// Start of an element, ignoring its attributes
+			const int32 NameStart = Position;
+			while ((Position < XmlLen) && !IsXmlWhitespace(Xml[Position]) && (Xml[Position] != '/') && (Xml[Position] != '>'))
+			{
+				Position++;
+			}
+			const FAnsiStringView Name = Xml.Mid(NameStart, Position - NameStart);
+			ANSICHAR Quote = 0;
+			while ((Position < XmlLen) && ((Quote != 0) || (Xml[Position] != '>')))
+			{
+				if (Quote != 0)
+				{
+					if (Xml[Position] == Quote)
+					{
+						Quote = 0;
+					}
+				}
+				else if ((Xml[Position] == '"') || (Xml[Position] == '\''))
+				{
+					Quote = Xml[Position];
+				}
+				Position++;
+			}
+			if ((Position >= XmlLen) || Name.IsEmpty())
+			{
+				SetError(TEXT("malformed start tag"));
+				return false;
+			}
+			bIsEmptyElement = (Xml[Position - 1] == '/');
+			Position++;
+
+			bIsStart = true;
+			TagId = FindTagId(Name);
+			OpenElements.Emplace(Name, TagId);
+			Depth = OpenElements.Num();
+			return true;
+		}
+	}
+
+	if (OpenElements.Num() > 0)
+	{
+		SetError(TEXT("unexpected end of document"));
+	}
+	return false;
+}
+
+FAnsiStringView FPlasticSourceControlXmlReader::ReadContent()
+{
+	check(bIsStart);
+
+	if (bIsEmptyElement)
+	{
+		Next();
+		return FAnsiStringView();
+	}
+
+	// The content is made of text and CDATA sections, up to the end of this element, else it has child elements
+	static const FAnsiStringView CDataStart("<![CDATA[");
+	static const FAnsiStringView CDataEnd("]]>");
+	struct FContentPart
+	{
+		FAnsiStringView Text;
+		bool bIsCData;
+	};
+	TArray<FContentPart, TInlineAllocator<4>> Parts;
+	int32 Cursor = Position;
+	for (;;)
+	{
+		const int32 Index = FindFrom(Xml, Cursor, "<");
+		const int32 TextEnd = (Index == INDEX_NONE) ? Xml.Len() : Index;
+		if (TextEnd > Cursor)
+		{
+			Parts.Add({ Xml.Mid(Cursor, TextEnd - Cursor), false });
+		}
+		if (Index == INDEX_NONE)
+		{
+			break;
+		}
+
+		const FAnsiStringView Markup = Xml.RightChop(Index);
+		if (Markup.StartsWith(CDataStart))
+		{
+			// The text of a CDATA section is returned as is, without being trimmed
+			const int32 CDataTextStart = Index + CDataStart.Len();
+			const int32 CDataTextEnd = FindFrom(Xml, CDataTextStart, CDataEnd);
+			if (CDataTextEnd == INDEX_NONE)
+			{
+				Position = Index;
+				SetError(TEXT("unterminated CDATA section"));
+				return FAnsiStringView();
+			}
+			Parts.Add({ Xml.Mid(CDataTextStart, CDataTextEnd - CDataTextStart), true });
+			Cursor = CDataTextEnd + CDataEnd.Len();
+		}
+		else if (Markup.StartsWith("<!--"))
+		{
+			const int32 CommentEnd = FindFrom(Xml, Index, "-->");
+			if (CommentEnd == INDEX_NONE)
+			{
+				Position = Index;
+				SetError(TEXT("unterminated markup"));
+				return FAnsiStringView();
+			}
+			Cursor = CommentEnd + 3;
+		}
+		else if (Markup.StartsWith("</"))
+		{
+			// Trim the text (not the CDATA sections) at both ends of the content
+			if ((Parts.Num() > 0) && !Parts[0].bIsCData)
+			{
+				FAnsiStringView& Text = Parts[0].Text;
+				while ((Text.Len() > 0) && IsXmlWhitespace(Text[0]))
+				{
+					Text.RemovePrefix(1);
+				}
+			}
+			if ((Parts.Num() > 0) && !Parts.Last().bIsCData)
+			{
+				FAnsiStringView& Text = Parts.Last().Text;
+				while ((Text.Len() > 0) && IsXmlWhitespace(Text[Text.Len() - 1]))
+				{
+					Text.RemoveSuffix(1);
+				}
+			}
+			Parts.RemoveAll([](const FContentPart& InPart) { return InPart.Text.IsEmpty(); });
+
+			Position = Index;
+			Next();
+
+			// The content is a view of the document, unless made of multiple parts that then need to be concatenated
+			if (Parts.Num() == 0)
+			{
+				return FAnsiStringView();
+			}
+			if (Parts.Num() == 1)
+			{
+				return Parts[0].Text;
+			}
+			ContentBuffer.Reset();
+			for (const FContentPart& Part : Parts)
+			{
+				ContentBuffer.Append(Part.Text.GetData(), Part.Text.Len());
+			}
+			return FAnsiStringView(ContentBuffer.GetData(), ContentBuffer.Num());
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	SkipElement();
+	return FAnsiStringView();
+}
+
+void FPlasticSourceControlXmlReader::SkipElement()
+{
+	check(bIsStart);
+
+	const int32 ElementDepth = Depth;
+	while (Next())
+	{
+		if (!bIsStart && (Depth == ElementDepth))
+		{
+			return;
+		}
+	}
+}
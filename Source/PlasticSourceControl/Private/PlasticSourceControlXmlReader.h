@@ -0,0 +1,112 @@
+// Copyright (c) 2025 Unity Technologies
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+
+/**
+ * Forward-only streaming reader of the XML results of cm commands, reading the UTF-8 bytes in place without building a DOM.
+ *
+ * Elements are identified by fixed ids, the index of their tag in the table given to the constructor (INDEX_NONE for any other tag),
+ * so that parsers switch on integers instead of comparing strings of each node.
+ *
+ * Only the subset of XML written by cm is supported: attributes are skipped, and the content of elements is returned as is, like FXmlFile,
+ * so XML entities need to be decoded by the caller where relevant, and the text of CDATA sections is part of the content.
+ *
+ * Typical use:
+ *	while (Reader.Next())
+ *	{
+ *		if (Reader.IsStart() && (Reader.GetTagId() == ETag::Comment))
+ *		{
+ *			Comment = Reader.ReadContent();
+ *		}
+ *	}
+ */
+class FPlasticSourceControlXmlReader
+{
+public:
+	/**
+	 * @param	InXml	The UTF-8 XML document, that needs to outlive the reader and the content views it returns
+	 * @param	InTags	The tags of the elements of interest, their index being their id (needs to outlive the reader)
+	 */
+	FPlasticSourceControlXmlReader(const FAnsiStringView InXml, TArrayView<const FAnsiStringView> InTags);
+
+	/**
+	 * Move to the next start or end of an element (an empty element "<Tag />" is reported as a start immediately followed by an end).
+	 * @returns false at the end of the document, or on a syntax error
+	 */
+	bool Next();
+
+	/** The current node is the start of an element */
+	bool IsStart() const
+	{
+		return bIsStart;
+	}
+
+	/** The current node is the end of an element */
+	bool IsEnd() const
+	{
+		return !bIsStart;
+	}
+
+	/** Id of the tag of the current element, or INDEX_NONE if not in the table of tags */
+	int32 GetTagId() const
+	{
+		return TagId;
+	}
+
+	/** Depth of the current element, 1 for the root element */
+	int32 GetDepth() const
+	{
+		return Depth;
+	}
+
+	/**
+	 * Read the text content of the current element and move to its end.
+	 *
+	 * The text of CDATA sections is part of the content, as is; the view is then only valid until the next call if the content is made of multiple parts.
+	 * @returns the content, trimmed of whitespaces, or an empty view if the element has child elements (which are skipped)
+	 */
+	FAnsiStringView ReadContent();
+
+	/** Skip all the child elements of the current element, moving to its end */
+	void SkipElement();
+
+	/** A syntax error stopped the reading of the document */
+	bool HasError() const
+	{
+		return !Error.IsEmpty();
+	}
+
+	const FString& GetError() const
+	{
+		return Error;
+	}
+
+private:
+	int32 FindTagId(const FAnsiStringView InName) const;
+	bool SkipPast(const FAnsiStringView InTerminator);
+	void SetError(const TCHAR* InError);
+
+	FAnsiStringView Xml;
+	TArrayView<const FAnsiStringView> Tags;
+
+	/** Position of the next character to read */
+	int32 Position = 0;
+
+	/** Names and ids of the elements currently open, from the root */
+	TArray<TPair<FAnsiStringView, int32>, TInlineAllocator<16>> OpenElements;
+
+	bool bIsStart = false;
+	int32 TagId = INDEX_NONE;
+	int32 Depth = 0;
+
+	/** The current element is an empty element, which end is to be reported next */
+	bool bIsEmptyElement = false;
+
+	/** Content of the last element read, when made of text and CDATA sections to concatenate */
+	TArray<ANSICHAR> ContentBuffer;
+
+	FString Error;
+};
@@ -445,16 +445,16 @@ void SPlasticSourceControlBranchesWidget::OnRefreshUI()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(SPlasticSourceControlBranchesWidget::OnRefreshUI);
 
-	const int32 ItemCount = SourceControlBranches.Num();
-	BranchRows.Empty(ItemCount);
-	for (int32 ItemIndex = 0; ItemIndex < ItemCount; ++ItemIndex)
+	// Filter the branches in the background if there are many of them, in which case their rows are refreshed later by Tick()
+	if (BranchesListFilter.Filter(SearchTextFilter->GetRawFilterText().ToString(), [this](const FPlasticSourceControlBranchRef& InItem) { return SearchTextFilter->PassesFilter(InItem.Get()); }))
 	{
-		const FPlasticSourceControlBranchRef& Item = SourceControlBranches[ItemIndex];
-		if (SearchTextFilter->PassesFilter(Item.Get()))
-		{
-			BranchRows.Emplace(Item);
-		}
+		OnRowsRefreshUI();
 	}
+}
+
+void SPlasticSourceControlBranchesWidget::OnRowsRefreshUI()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(SPlasticSourceControlBranchesWidget::OnRowsRefreshUI);
 
 	if (GetListView())
 	{
@@ -521,11 +521,15 @@ void SPlasticSourceControlBranchesWidget::SortBranchView()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(SPlasticSourceControlBranchesWidget::SortBranchView);
 
-	if (PrimarySortedColumn.IsNone() || BranchRows.Num() == 0)
+	if (PrimarySortedColumn.IsNone())
 	{
-		return; // No column selected for sorting or nothing to sort.
+		BranchesListFilter.GetRows(BranchRows);
+		return; // No column selected for sorting.
 	}
 
+	// The order of all the branches is cached by the filter for each sort, so that it is computed only once
+	const FString SortKey = FString::Printf(TEXT("%s %d %s %d"), *PrimarySortedColumn.ToString(), static_cast<int32>(PrimarySortMode), *SecondarySortedColumn.ToString(), static_cast<int32>(SecondarySortMode));
+
 	auto CompareNames = [](const FPlasticSourceControlBranch* Lhs, const FPlasticSourceControlBranch* Rhs)
 	{
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
@@ -600,9 +604,9 @@ void SPlasticSourceControlBranchesWidget::SortBranchView()
 		// NOTE: StableSort() would give a better experience when the sorted columns(s) has the same values and new values gets added, but it is slower
 		//       with large changelists (7600 items was about 1.8x slower in average measured with Unreal Insight). Because this code runs in the main
 		//       thread and can be invoked a lot, the trade off went if favor of speed.
-		BranchRows.Sort([this, &PrimaryCompare, &SecondaryCompare](const FPlasticSourceControlBranchPtr& Lhs, const FPlasticSourceControlBranchPtr& Rhs)
+		BranchesListFilter.GetSortedRows(SortKey, [this, &PrimaryCompare, &SecondaryCompare](const FPlasticSourceControlBranchRef& Lhs, const FPlasticSourceControlBranchRef& Rhs)
 		{
-			int32 Result = PrimaryCompare(static_cast<FPlasticSourceControlBranch*>(Lhs.Get()), static_cast<FPlasticSourceControlBranch*>(Rhs.Get()));
+			int32 Result = PrimaryCompare(&Lhs.Get(), &Rhs.Get());
 			if (Result < 0)
 			{
 				return true;
@@ -613,19 +617,19 @@ void SPlasticSourceControlBranchesWidget::SortBranchView()
 			}
 			else if (SecondarySortMode == EColumnSortMode::Ascending)
 			{
-				return SecondaryCompare(static_cast<FPlasticSourceControlBranch*>(Lhs.Get()), static_cast<FPlasticSourceControlBranch*>(Rhs.Get())) < 0;
+				return SecondaryCompare(&Lhs.Get(), &Rhs.Get()) < 0;
 			}
 			else
 			{
-				return SecondaryCompare(static_cast<FPlasticSourceControlBranch*>(Lhs.Get()), static_cast<FPlasticSourceControlBranch*>(Rhs.Get())) > 0;
+				return SecondaryCompare(&Lhs.Get(), &Rhs.Get()) > 0;
 			}
-		});
+		}, BranchRows);
 	}
 	else
 	{
-		BranchRows.Sort([this, &PrimaryCompare, &SecondaryCompare](const FPlasticSourceControlBranchPtr& Lhs, const FPlasticSourceControlBranchPtr& Rhs)
+		BranchesListFilter.GetSortedRows(SortKey, [this, &PrimaryCompare, &SecondaryCompare](const FPlasticSourceControlBranchRef& Lhs, const FPlasticSourceControlBranchRef& Rhs)
 		{
-			int32 Result = PrimaryCompare(static_cast<FPlasticSourceControlBranch*>(Lhs.Get()), static_cast<FPlasticSourceControlBranch*>(Rhs.Get()));
+			int32 Result = PrimaryCompare(&Lhs.Get(), &Rhs.Get());
 			if (Result > 0)
 			{
 				return true;
@@ -636,13 +640,13 @@ void SPlasticSourceControlBranchesWidget::SortBranchView()
 			}
 			else if (SecondarySortMode == EColumnSortMode::Ascending)
 			{
-				return SecondaryCompare(static_cast<FPlasticSourceControlBranch*>(Lhs.Get()), static_cast<FPlasticSourceControlBranch*>(Rhs.Get())) < 0;
+				return SecondaryCompare(&Lhs.Get(), &Rhs.Get()) < 0;
 			}
 			else
 			{
-				return SecondaryCompare(static_cast<FPlasticSourceControlBranch*>(Lhs.Get()), static_cast<FPlasticSourceControlBranch*>(Rhs.Get())) > 0;
+				return SecondaryCompare(&Lhs.Get(), &Rhs.Get()) > 0;
 			}
-		});
+		}, BranchRows);
 	}
 }
 
@@ -1015,6 +1019,12 @@ void SPlasticSourceControlBranchesWidget::DeleteBranches(const TArray<FString>&
 
 void SPlasticSourceControlBranchesWidget::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
 {
+	// Publish the rows of the branches filtered in the background
+	if (BranchesListFilter.Tick())
+	{
+		OnRowsRefreshUI();
+	}
+
 	if (!ISourceControlModule::Get().IsEnabled() || (!FPlasticSourceControlModule::Get().GetProvider().IsAvailable()))
 	{
 		return;
@@ -1106,6 +1116,7 @@ void SPlasticSourceControlBranchesWidget::OnGetBranchesOperationComplete(const F
 
 	TSharedRef<FPlasticGetBranches, ESPMode::ThreadSafe> OperationGetBranches = StaticCastSharedRef<FPlasticGetBranches>(InOperation);
 	SourceControlBranches = MoveTemp(OperationGetBranches->Branches);
+	BranchesListFilter.SetItems(SourceControlBranches, [this](const FPlasticSourceControlBranchRef& InItem, TArray<FString>& OutStrings) { PopulateItemSearchStrings(InItem.Get(), OutStrings); });
 
 	WorkspaceSelector = FPlasticSourceControlModule::Get().GetProvider().GetWorkspaceSelector();
 
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 
 #include "Notification.h"
+#include "PlasticSourceControlListFilter.h"
 
 #include "Misc/TextFilter.h"
 #include "Widgets/DeclarativeSyntaxSupport.h"
@@ -49,6 +50,7 @@ private:
 	void OnFromDateChanged(int32 InFromDateInDays);
 
 	void OnRefreshUI();
+	void OnRowsRefreshUI();
 
 	EColumnSortPriority::Type GetColumnSortPriority(const FName InColumnId) const;
 	EColumnSortMode::Type GetColumnSortMode(const FName InColumnId) const;
@@ -131,6 +133,7 @@ private:
 
 	TArray<FPlasticSourceControlBranchRef> SourceControlBranches; // Full list from source (filtered by date)
 	TArray<FPlasticSourceControlBranchRef> BranchRows; // Filtered list to display based on the search text filter
+	TPlasticSourceControlListFilter<FPlasticSourceControlBranchRef> BranchesListFilter; // Search index and cached sorts of the full list, to filter it incrementally
 
 	/** Delegate handle for the HandleSourceControlStateChanged function callback */
 	FDelegateHandle SourceControlStateChangedDelegateHandle;
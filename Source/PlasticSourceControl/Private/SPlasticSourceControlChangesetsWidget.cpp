@@ -328,6 +328,7 @@ TSharedRef<SWidget> SPlasticSourceControlChangesetsWidget::CreateChangesetsListV
 		.OnGenerateRow(this, &SPlasticSourceControlChangesetsWidget::OnGenerateRow)
 		.SelectionMode(ESelectionMode::Multi)
 		.OnSelectionChanged(this, &SPlasticSourceControlChangesetsWidget::OnSelectionChanged)
+		.OnListViewScrolled(this, &SPlasticSourceControlChangesetsWidget::OnChangesetsListViewScrolled)
 		.OnContextMenuOpening(this, &SPlasticSourceControlChangesetsWidget::OnOpenChangesetContextMenu)
 		.OnMouseButtonDoubleClick(this, &SPlasticSourceControlChangesetsWidget::OnItemDoubleClicked)
 		.OnItemToString_Debug_Lambda([this](FPlasticSourceControlChangesetRef Changeset) { return FString::FromInt(Changeset->ChangesetId); })
@@ -541,6 +542,7 @@ void SPlasticSourceControlChangesetsWidget::PopulateItemSearchStrings(const FPla
 void SPlasticSourceControlChangesetsWidget::OnFromDateChanged(int32 InFromDateInDays)
 {
 	FromDateInDays = InFromDateInDays;
+	NumChangesetsPages = 0;
 	bShouldRefresh = true;
 }
 
@@ -561,16 +563,16 @@ void SPlasticSourceControlChangesetsWidget::OnChangesetsRefreshUI()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(SPlasticSourceControlChangesetsWidget::OnChangesetsRefreshUI);
 
-	const int32 ItemCount = SourceControlChangesets.Num();
-	ChangesetRows.Empty(ItemCount);
-	for (int32 ItemIndex = 0; ItemIndex < ItemCount; ++ItemIndex)
+	// Filter the changesets in the background if there are many of them, in which case their rows are refreshed later by Tick()
+	if (ChangesetsListFilter.Filter(ChangesetsSearchTextFilter->GetRawFilterText().ToString(), [this](const FPlasticSourceControlChangesetRef& InItem) { return ChangesetsSearchTextFilter->PassesFilter(InItem.Get()); }))
 	{
-		const FPlasticSourceControlChangesetRef& Item = SourceControlChangesets[ItemIndex];
-		if (ChangesetsSearchTextFilter->PassesFilter(Item.Get()))
-		{
-			ChangesetRows.Emplace(Item);
-		}
+		OnChangesetRowsRefreshUI();
 	}
+}
+
+void SPlasticSourceControlChangesetsWidget::OnChangesetRowsRefreshUI()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(SPlasticSourceControlChangesetsWidget::OnChangesetRowsRefreshUI);
 
 	if (ChangesetsListView)
 	{
@@ -689,11 +691,18 @@ void SPlasticSourceControlChangesetsWidget::SortChangesetsView()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(SPlasticSourceControlChangesetsWidget::SortChangesetsView);
 
-	if (ChangesetsPrimarySortedColumn.IsNone() || ChangesetRows.Num() == 0)
+	// The changesets around the selected one can change
+	bPrefetchRequested = true;
+
+	if (ChangesetsPrimarySortedColumn.IsNone())
 	{
-		return; // No column selected for sorting or nothing to sort.
+		ChangesetsListFilter.GetRows(ChangesetRows);
+		return; // No column selected for sorting.
 	}
 
+	// The order of all the changesets is cached by the filter for each sort, so that it is computed only once
+	const FString SortKey = FString::Printf(TEXT("%s %d %s %d"), *ChangesetsPrimarySortedColumn.ToString(), static_cast<int32>(ChangesetsPrimarySortMode), *ChangesetsSecondarySortedColumn.ToString(), static_cast<int32>(ChangesetsSecondarySortMode));
+
 	auto CompareChangesetIds = [](const FPlasticSourceControlChangeset* Lhs, const FPlasticSourceControlChangeset* Rhs)
 	{
 		return Lhs->ChangesetId < Rhs->ChangesetId ? -1 : (Lhs->ChangesetId == Rhs->ChangesetId ? 0 : 1);
@@ -764,9 +773,9 @@ void SPlasticSourceControlChangesetsWidget::SortChangesetsView()
 		// NOTE: StableSort() would give a better experience when the sorted columns(s) has the same values and new values gets added, but it is slower
 		//       with large changelists (7600 items was about 1.8x slower in average measured with Unreal Insight). Because this code runs in the main
 		//       thread and can be invoked a lot, the trade off went if favor of speed.
-		ChangesetRows.Sort([this, &PrimaryCompare, &SecondaryCompare](const FPlasticSourceControlChangesetPtr& Lhs, const FPlasticSourceControlChangesetPtr& Rhs)
+		ChangesetsListFilter.GetSortedRows(SortKey, [this, &PrimaryCompare, &SecondaryCompare](const FPlasticSourceControlChangesetRef& Lhs, const FPlasticSourceControlChangesetRef& Rhs)
 		{
-			int32 Result = PrimaryCompare(static_cast<FPlasticSourceControlChangeset*>(Lhs.Get()), static_cast<FPlasticSourceControlChangeset*>(Rhs.Get()));
+			int32 Result = PrimaryCompare(&Lhs.Get(), &Rhs.Get());
 			if (Result < 0)
 			{
 				return true;
@@ -777,19 +786,19 @@ void SPlasticSourceControlChangesetsWidget::SortChangesetsView()
 			}
 			else if (ChangesetsSecondarySortMode == EColumnSortMode::Ascending)
 			{
-				return SecondaryCompare(static_cast<FPlasticSourceControlChangeset*>(Lhs.Get()), static_cast<FPlasticSourceControlChangeset*>(Rhs.Get())) < 0;
+				return SecondaryCompare(&Lhs.Get(), &Rhs.Get()) < 0;
 			}
 			else
 			{
-				return SecondaryCompare(static_cast<FPlasticSourceControlChangeset*>(Lhs.Get()), static_cast<FPlasticSourceControlChangeset*>(Rhs.Get())) > 0;
+				return SecondaryCompare(&Lhs.Get(), &Rhs.Get()) > 0;
 			}
-		});
+		}, ChangesetRows);
 	}
 	else
 	{
-		ChangesetRows.Sort([this, &PrimaryCompare, &SecondaryCompare](const FPlasticSourceControlChangesetPtr& Lhs, const FPlasticSourceControlChangesetPtr& Rhs)
+		ChangesetsListFilter.GetSortedRows(SortKey, [this, &PrimaryCompare, &SecondaryCompare](const FPlasticSourceControlChangesetRef& Lhs, const FPlasticSourceControlChangesetRef& Rhs)
 		{
-			int32 Result = PrimaryCompare(static_cast<FPlasticSourceControlChangeset*>(Lhs.Get()), static_cast<FPlasticSourceControlChangeset*>(Rhs.Get()));
+			int32 Result = PrimaryCompare(&Lhs.Get(), &Rhs.Get());
 			if (Result > 0)
 			{
 				return true;
@@ -800,13 +809,13 @@ void SPlasticSourceControlChangesetsWidget::SortChangesetsView()
 			}
 			else if (ChangesetsSecondarySortMode == EColumnSortMode::Ascending)
 			{
-				return SecondaryCompare(static_cast<FPlasticSourceControlChangeset*>(Lhs.Get()), static_cast<FPlasticSourceControlChangeset*>(Rhs.Get())) < 0;
+				return SecondaryCompare(&Lhs.Get(), &Rhs.Get()) < 0;
 			}
 			else
 			{
-				return SecondaryCompare(static_cast<FPlasticSourceControlChangeset*>(Lhs.Get()), static_cast<FPlasticSourceControlChangeset*>(Rhs.Get())) > 0;
+				return SecondaryCompare(&Lhs.Get(), &Rhs.Get()) > 0;
 			}
-		});
+		}, ChangesetRows);
 	}
 }
 
@@ -1813,6 +1822,12 @@ void SPlasticSourceControlChangesetsWidget::BrowseToAssets(const TArray<FAssetDa
 
 void SPlasticSourceControlChangesetsWidget::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
 {
+	// Publish the rows of the changesets filtered in the background
+	if (ChangesetsListFilter.Tick())
+	{
+		OnChangesetRowsRefreshUI();
+	}
+
 	if (!ISourceControlModule::Get().IsEnabled() || (!FPlasticSourceControlModule::Get().GetProvider().IsAvailable()))
 	{
 		return;
@@ -1845,6 +1860,10 @@ void SPlasticSourceControlChangesetsWidget::Tick(const FGeometry& AllottedGeomet
 	{
 		TickRefreshStatus(InDeltaTime);
 	}
+	else
+	{
+		TickPrefetchChangesetFiles(CurrentTime);
+	}
 }
 
 void SPlasticSourceControlChangesetsWidget::StartRefreshStatus()
@@ -1882,11 +1901,35 @@ void SPlasticSourceControlChangesetsWidget::RequestChangesetsRefresh()
 	{
 		GetChangesetsOperation->FromDate = FDateTime::Now() - FTimespan::FromDays(FromDateInDays);
 	}
+	else
+	{
+		// List all the changesets by pages, reloading as many pages as already loaded
+		GetChangesetsOperation->PageSize = FMath::Max(NumChangesetsPages, 1) * ChangesetsPageSize;
+	}
 
 	FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
 	Provider.Execute(GetChangesetsOperation, EConcurrency::Asynchronous, FSourceControlOperationComplete::CreateSP(this, &SPlasticSourceControlChangesetsWidget::OnGetChangesetsOperationComplete));
 }
 
+void SPlasticSourceControlChangesetsWidget::RequestChangesetsNextPage()
+{
+	if (!ISourceControlModule::Get().IsEnabled() || (!FPlasticSourceControlModule::Get().GetProvider().IsAvailable()) || (SourceControlChangesets.Num() == 0))
+	{
+		return;
+	}
+
+	StartRefreshStatus();
+	bIsLoadingChangesetsPage = true;
+
+	// The changesets are listed by descending ChangesetId, so the next page starts before the last one
+	TSharedRef<FPlasticGetChangesets, ESPMode::ThreadSafe> GetChangesetsOperation = ISourceControlOperation::Create<FPlasticGetChangesets>();
+	GetChangesetsOperation->PageSize = ChangesetsPageSize;
+	GetChangesetsOperation->BeforeChangesetId = SourceControlChangesets.Last()->ChangesetId;
+
+	FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
+	Provider.Execute(GetChangesetsOperation, EConcurrency::Asynchronous, FSourceControlOperationComplete::CreateSP(this, &SPlasticSourceControlChangesetsWidget::OnGetChangesetsPageOperationComplete));
+}
+
 void SPlasticSourceControlChangesetsWidget::RequestGetChangesetFiles(const FPlasticSourceControlChangesetPtr& InSelectedChangeset)
 {
 	if (!ISourceControlModule::Get().IsEnabled() || (!FPlasticSourceControlModule::Get().GetProvider().IsAvailable()))
@@ -1902,10 +1945,67 @@ void SPlasticSourceControlChangesetsWidget::RequestGetChangesetFiles(const FPlas
 	Provider.Execute(GetChangesetFilesOperation, EConcurrency::Asynchronous, FSourceControlOperationComplete::CreateSP(this, &SPlasticSourceControlChangesetsWidget::OnGetChangesetFilesOperationComplete));
 }
 
+// While the user idles on a changeset, get in the background the files of the changesets around it in the sorted list, so that moving the selection is instant
+void SPlasticSourceControlChangesetsWidget::TickPrefetchChangesetFiles(const double InCurrentTime)
+{
+	if (!bPrefetchRequested || bIsPrefetching || (InCurrentTime - LastSelectionChangeTime < PrefetchIdleDelaySeconds))
+	{
+		return;
+	}
+	bPrefetchRequested = false;
+	if (!SourceSelectedChangeset.IsValid())
+	{
+		return;
+	}
+
+	const int32 SelectedIndex = ChangesetRows.IndexOfByPredicate([this](const FPlasticSourceControlChangesetRef& InChangeset) { return InChangeset == SourceSelectedChangeset; });
+	if (SelectedIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
+	const FString RepositorySpecification = Provider.GetRepositorySpecification();
+	for (int32 Distance = 1; Distance <= PrefetchDistance; Distance++)
+	{
+		for (const int32 Index : { SelectedIndex + Distance, SelectedIndex - Distance })
+		{
+			if (!ChangesetRows.IsValidIndex(Index))
+			{
+				continue;
+			}
+			const FPlasticSourceControlChangesetRef& Changeset = ChangesetRows[Index];
+			bool bAlreadyPrefetched = false;
+			PrefetchedChangesetIds.Add(Changeset->ChangesetId, &bAlreadyPrefetched);
+			if (bAlreadyPrefetched || (Changeset->Files.Num() > 0) || Provider.GetChangesetFilesCache().Find(RepositorySpecification, Changeset->ChangesetId, Changeset->Files))
+			{
+				continue;
+			}
+
+			// Prefetch one changeset at a time, to leave the worker threads to other commands
+			bIsPrefetching = true;
+			TSharedRef<FPlasticGetChangesetFiles, ESPMode::ThreadSafe> GetChangesetFilesOperation = ISourceControlOperation::Create<FPlasticGetChangesetFiles>();
+			GetChangesetFilesOperation->Changeset = Changeset;
+			GetChangesetFilesOperation->bPrefetch = true;
+			if (Provider.Execute(GetChangesetFilesOperation, EConcurrency::Asynchronous, FSourceControlOperationComplete::CreateSP(this, &SPlasticSourceControlChangesetsWidget::OnPrefetchChangesetFilesOperationComplete)) == ECommandResult::Failed)
+			{
+				// The operation might have failed without calling its delegate: don't wait for it, but move on to the next changeset
+				bIsPrefetching = false;
+				bPrefetchRequested = true;
+			}
+			return;
+		}
+	}
+}
+
 void SPlasticSourceControlChangesetsWidget::OnGetChangesetsOperationComplete(const FSourceControlOperationRef& InOperation, ECommandResult::Type InResult)
 {
 	TSharedRef<FPlasticGetChangesets, ESPMode::ThreadSafe> GetChangesetsOperation = StaticCastSharedRef<FPlasticGetChangesets>(InOperation);
 	SourceControlChangesets = MoveTemp(GetChangesetsOperation->Changesets);
+	ChangesetsListFilter.SetItems(SourceControlChangesets, [this](const FPlasticSourceControlChangesetRef& InItem, TArray<FString>& OutStrings) { PopulateItemSearchStrings(InItem.Get(), OutStrings); });
+	PrefetchedChangesetIds.Reset();
+	NumChangesetsPages = GetChangesetsOperation->PageSize / ChangesetsPageSize;
+	bHasMoreChangesets = GetChangesetsOperation->bHasMoreChangesets;
 
 	CurrentChangesetId = FPlasticSourceControlModule::Get().GetProvider().GetChangesetNumber();
 
@@ -1913,6 +2013,26 @@ void SPlasticSourceControlChangesetsWidget::OnGetChangesetsOperationComplete(con
 	OnChangesetsRefreshUI();
 }
 
+void SPlasticSourceControlChangesetsWidget::OnGetChangesetsPageOperationComplete(const FSourceControlOperationRef& InOperation, ECommandResult::Type InResult)
+{
+	bIsLoadingChangesetsPage = false;
+	EndRefreshStatus();
+
+	// Discard the page if the list has been refreshed meanwhile
+	TSharedRef<FPlasticGetChangesets, ESPMode::ThreadSafe> GetChangesetsOperation = StaticCastSharedRef<FPlasticGetChangesets>(InOperation);
+	if ((InResult != ECommandResult::Succeeded) || (SourceControlChangesets.Num() == 0) || (SourceControlChangesets.Last()->ChangesetId != GetChangesetsOperation->BeforeChangesetId))
+	{
+		return;
+	}
+
+	SourceControlChangesets.Append(MoveTemp(GetChangesetsOperation->Changesets));
+	ChangesetsListFilter.SetItems(SourceControlChangesets, [this](const FPlasticSourceControlChangesetRef& InItem, TArray<FString>& OutStrings) { PopulateItemSearchStrings(InItem.Get(), OutStrings); });
+	NumChangesetsPages++;
+	bHasMoreChangesets = GetChangesetsOperation->bHasMoreChangesets;
+
+	OnChangesetsRefreshUI();
+}
+
 void SPlasticSourceControlChangesetsWidget::OnGetChangesetFilesOperationComplete(const FSourceControlOperationRef& InOperation, ECommandResult::Type InResult)
 {
 	TSharedRef<FPlasticGetChangesetFiles, ESPMode::ThreadSafe> GetChangesetFilesOperation = StaticCastSharedRef<FPlasticGetChangesetFiles>(InOperation);
@@ -1922,6 +2042,24 @@ void SPlasticSourceControlChangesetsWidget::OnGetChangesetFilesOperationComplete
 	OnFilesRefreshUI();
 }
 
+void SPlasticSourceControlChangesetsWidget::OnPrefetchChangesetFilesOperationComplete(const FSourceControlOperationRef& InOperation, ECommandResult::Type InResult)
+{
+	bIsPrefetching = false;
+	bPrefetchRequested = true;
+
+	TSharedRef<FPlasticGetChangesetFiles, ESPMode::ThreadSafe> GetChangesetFilesOperation = StaticCastSharedRef<FPlasticGetChangesetFiles>(InOperation);
+	if ((InResult == ECommandResult::Succeeded) && (GetChangesetFilesOperation->Changeset->Files.Num() == 0))
+	{
+		GetChangesetFilesOperation->Changeset->Files = MoveTemp(GetChangesetFilesOperation->Files);
+
+		// The user could have selected the changeset while it was being prefetched
+		if (GetChangesetFilesOperation->Changeset == SourceSelectedChangeset)
+		{
+			OnFilesRefreshUI();
+		}
+	}
+}
+
 void SPlasticSourceControlChangesetsWidget::OnSwitchToBranchOperationComplete(const FSourceControlOperationRef& InOperation, ECommandResult::Type InResult)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(SPlasticSourceControlChangesetsWidget::OnSwitchToBranchOperationComplete);
@@ -2013,6 +2151,15 @@ void SPlasticSourceControlChangesetsWidget::HandleSourceControlStateChanged()
 void SPlasticSourceControlChangesetsWidget::OnSelectionChanged(FPlasticSourceControlChangesetPtr InSelectedChangeset, ESelectInfo::Type SelectInfo)
 {
 	SourceSelectedChangeset = InSelectedChangeset;
+	LastSelectionChangeTime = FPlatformTime::Seconds();
+	bPrefetchRequested = true;
+
+	// Get the files from the cache of the provider if they have been listed recently, to display them without waiting for a command
+	if (InSelectedChangeset.IsValid() && SourceSelectedChangeset->Files.Num() == 0)
+	{
+		FPlasticSourceControlProvider& Provider = FPlasticSourceControlModule::Get().GetProvider();
+		Provider.GetChangesetFilesCache().Find(Provider.GetRepositorySpecification(), SourceSelectedChangeset->ChangesetId, SourceSelectedChangeset->Files);
+	}
 
 	if (InSelectedChangeset.IsValid() && SourceSelectedChangeset->Files.Num() == 0)
 	{
@@ -2026,6 +2173,17 @@ void SPlasticSourceControlChangesetsWidget::OnSelectionChanged(FPlasticSourceCon
 	}
 }
 
+void SPlasticSourceControlChangesetsWidget::OnChangesetsListViewScrolled(double InScrollOffset)
+{
+	// The scroll offset is the index of the first row in view, and the rows in view are the ones with a widget generated
+	// (GetNumItemsBeingObserved() would be the number of all the rows of the list)
+	if (bHasMoreChangesets && !bIsLoadingChangesetsPage && !bIsRefreshing && ChangesetsListView.IsValid()
+		&& (InScrollOffset + ChangesetsListView->GetNumLiveWidgets() + ChangesetsPageLoadThreshold >= ChangesetRows.Num()))
+	{
+		RequestChangesetsNextPage();
+	}
+}
+
 void SPlasticSourceControlChangesetsWidget::OnItemDoubleClicked(FPlasticSourceControlChangesetRef InSelectedChangeset)
 {
 	OnDiffChangesetClicked(InSelectedChangeset);
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 
 #include "Notification.h"
+#include "PlasticSourceControlListFilter.h"
 
 #include "Misc/TextFilter.h"
 #include "Widgets/DeclarativeSyntaxSupport.h"
@@ -51,6 +52,7 @@ private:
 	void OnFromDateChanged(int32 InFromDateInDays);
 
 	void OnChangesetsRefreshUI();
+	void OnChangesetRowsRefreshUI();
 	void OnFilesRefreshUI();
 
 	EColumnSortPriority::Type GetChangesetsColumnSortPriority(const FName InColumnId) const;
@@ -88,11 +90,15 @@ private:
 	void EndRefreshStatus();
 
 	void RequestChangesetsRefresh();
+	void RequestChangesetsNextPage();
 	void RequestGetChangesetFiles(const FPlasticSourceControlChangesetPtr& InSelectedChangeset);
+	void TickPrefetchChangesetFiles(const double InCurrentTime);
 
 	/** Source control callbacks */
 	void OnGetChangesetsOperationComplete(const FSourceControlOperationRef& InOperation, ECommandResult::Type InResult);
+	void OnGetChangesetsPageOperationComplete(const FSourceControlOperationRef& InOperation, ECommandResult::Type InResult);
 	void OnGetChangesetFilesOperationComplete(const FSourceControlOperationRef& InOperation, ECommandResult::Type InResult);
+	void OnPrefetchChangesetFilesOperationComplete(const FSourceControlOperationRef& InOperation, ECommandResult::Type InResult);
 	void OnSwitchToBranchOperationComplete(const FSourceControlOperationRef& InOperation, ECommandResult::Type InResult);
 	void OnSwitchToChangesetOperationComplete(const FSourceControlOperationRef& InOperation, ECommandResult::Type InResult);
 	void OnRevertToRevisionOperationComplete(const FSourceControlOperationRef& InOperation, ECommandResult::Type InResult);
@@ -103,6 +109,9 @@ private:
 
 	void OnSelectionChanged(FPlasticSourceControlChangesetPtr InSelectedChangeset, ESelectInfo::Type SelectInfo);
 
+	/** Load the next page of changesets when scrolling near the end of the list */
+	void OnChangesetsListViewScrolled(double InScrollOffset);
+
 	/** Double click to diff the selected changeset */
 	void OnItemDoubleClicked(FPlasticSourceControlChangesetRef InChangeset);
 
@@ -144,13 +153,29 @@ private:
 	TMap<int32, FText> FromDateInDaysValues;
 	int32 FromDateInDays = 30;
 
+	/** When listing all the changesets, they are listed by pages, the next ones being loaded on demand when scrolling near the end of the list */
+	static constexpr int32 ChangesetsPageSize = 500;
+	static constexpr int32 ChangesetsPageLoadThreshold = 50; // Number of rows left below the view under which the next page is loaded
+	int32 NumChangesetsPages = 0; // Number of pages loaded, so that a refresh reloads as many changesets
+	bool bHasMoreChangesets = false;
+	bool bIsLoadingChangesetsPage = false;
+
 	TArray<FPlasticSourceControlChangesetRef> SourceControlChangesets; // Full list from source (filtered by date)
 	TArray<FPlasticSourceControlChangesetRef> ChangesetRows; // Filtered list to display based on the search text filter
+	TPlasticSourceControlListFilter<FPlasticSourceControlChangesetRef> ChangesetsListFilter; // Search index and cached sorts of the full list, to filter it incrementally
 
 	TSharedPtr<SListView<FPlasticSourceControlStateRef>> FilesListView;
 	TSharedPtr<TTextFilter<const FPlasticSourceControlState&>> FilesSearchTextFilter;
 
 	FPlasticSourceControlChangesetPtr SourceSelectedChangeset; // Current selected changeset from source control if any, with full list of files
+
+	/** Prefetch the files of the changesets adjacent to the selected one, once the selection has not changed for this delay */
+	static constexpr double PrefetchIdleDelaySeconds = 0.5;
+	static constexpr int32 PrefetchDistance = 2;
+	double LastSelectionChangeTime = 0.0;
+	bool bIsPrefetching = false;
+	bool bPrefetchRequested = false; // Look for a changeset to prefetch only when the selection or the rows changed, or after a prefetch
+	TSet<int32> PrefetchedChangesetIds; // Changesets already prefetched (or tried) since the last refresh of the list
 	TArray<FPlasticSourceControlStateRef> FileRows; // Filtered list to display based on the search text filter
 
 	/** Delegate handle for the HandleSourceControlStateChanged function callback */
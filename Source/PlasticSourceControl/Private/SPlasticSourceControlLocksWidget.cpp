@@ -377,16 +377,16 @@ void SPlasticSourceControlLocksWidget::OnRefreshUI()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(SPlasticSourceControlLocksWidget::OnRefreshUI);
 
-	const int32 ItemCount = SourceControlLocks.Num();
-	LockRows.Empty(ItemCount);
-	for (int32 ItemIndex = 0; ItemIndex < ItemCount; ++ItemIndex)
+	// Filter the locks in the background if there are many of them, in which case their rows are refreshed later by Tick()
+	if (LocksListFilter.Filter(SearchTextFilter->GetRawFilterText().ToString(), [this](const FPlasticSourceControlLockRef& InItem) { return SearchTextFilter->PassesFilter(InItem.Get()); }))
 	{
-		const FPlasticSourceControlLockRef& Item = SourceControlLocks[ItemIndex];
-		if (SearchTextFilter->PassesFilter(Item.Get()))
-		{
-			LockRows.Emplace(Item);
-		}
+		OnRowsRefreshUI();
 	}
+}
+
+void SPlasticSourceControlLocksWidget::OnRowsRefreshUI()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(SPlasticSourceControlLocksWidget::OnRowsRefreshUI);
 
 	if (GetListView())
 	{
@@ -453,11 +453,15 @@ void SPlasticSourceControlLocksWidget::SortLockView()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(SPlasticSourceControlLocksWidget::SortLockView);
 
-	if (PrimarySortedColumn.IsNone() || LockRows.Num() == 0)
+	if (PrimarySortedColumn.IsNone())
 	{
-		return; // No column selected for sorting or nothing to sort.
+		LocksListFilter.GetRows(LockRows);
+		return; // No column selected for sorting.
 	}
 
+	// The order of all the locks is cached by the filter for each sort, so that it is computed only once
+	const FString SortKey = FString::Printf(TEXT("%s %d %s %d"), *PrimarySortedColumn.ToString(), static_cast<int32>(PrimarySortMode), *SecondarySortedColumn.ToString(), static_cast<int32>(SecondarySortMode));
+
 	auto CompareItemIds = [](const FPlasticSourceControlLock* Lhs, const FPlasticSourceControlLock* Rhs)
 	{
 		return Lhs->ItemId < Rhs->ItemId ? -1 : (Lhs->ItemId == Rhs->ItemId ? 0 : 1);
@@ -555,9 +559,9 @@ void SPlasticSourceControlLocksWidget::SortLockView()
 		// NOTE: StableSort() would give a better experience when the sorted columns(s) has the same values and new values gets added, but it is slower
 		//       with large changelists (7600 items was about 1.8x slower in average measured with Unreal Insight). Because this code runs in the main
 		//       thread and can be invoked a lot, the trade off went if favor of speed.
-		LockRows.Sort([this, &PrimaryCompare, &SecondaryCompare](const FPlasticSourceControlLockPtr& Lhs, const FPlasticSourceControlLockPtr& Rhs)
+		LocksListFilter.GetSortedRows(SortKey, [this, &PrimaryCompare, &SecondaryCompare](const FPlasticSourceControlLockRef& Lhs, const FPlasticSourceControlLockRef& Rhs)
 		{
-			int32 Result = PrimaryCompare(static_cast<FPlasticSourceControlLock*>(Lhs.Get()), static_cast<FPlasticSourceControlLock*>(Rhs.Get()));
+			int32 Result = PrimaryCompare(&Lhs.Get(), &Rhs.Get());
 			if (Result < 0)
 			{
 				return true;
@@ -568,19 +572,19 @@ void SPlasticSourceControlLocksWidget::SortLockView()
 			}
 			else if (SecondarySortMode == EColumnSortMode::Ascending)
 			{
-				return SecondaryCompare(static_cast<FPlasticSourceControlLock*>(Lhs.Get()), static_cast<FPlasticSourceControlLock*>(Rhs.Get())) < 0;
+				return SecondaryCompare(&Lhs.Get(), &Rhs.Get()) < 0;
 			}
 			else
 			{
-				return SecondaryCompare(static_cast<FPlasticSourceControlLock*>(Lhs.Get()), static_cast<FPlasticSourceControlLock*>(Rhs.Get())) > 0;
+				return SecondaryCompare(&Lhs.Get(), &Rhs.Get()) > 0;
 			}
-		});
+		}, LockRows);
 	}
 	else
 	{
-		LockRows.Sort([this, &PrimaryCompare, &SecondaryCompare](const FPlasticSourceControlLockPtr& Lhs, const FPlasticSourceControlLockPtr& Rhs)
+		LocksListFilter.GetSortedRows(SortKey, [this, &PrimaryCompare, &SecondaryCompare](const FPlasticSourceControlLockRef& Lhs, const FPlasticSourceControlLockRef& Rhs)
 		{
-			int32 Result = PrimaryCompare(static_cast<FPlasticSourceControlLock*>(Lhs.Get()), static_cast<FPlasticSourceControlLock*>(Rhs.Get()));
+			int32 Result = PrimaryCompare(&Lhs.Get(), &Rhs.Get());
 			if (Result > 0)
 			{
 				return true;
@@ -591,13 +595,13 @@ void SPlasticSourceControlLocksWidget::SortLockView()
 			}
 			else if (SecondarySortMode == EColumnSortMode::Ascending)
 			{
-				return SecondaryCompare(static_cast<FPlasticSourceControlLock*>(Lhs.Get()), static_cast<FPlasticSourceControlLock*>(Rhs.Get())) < 0;
+				return SecondaryCompare(&Lhs.Get(), &Rhs.Get()) < 0;
 			}
 			else
 			{
-				return SecondaryCompare(static_cast<FPlasticSourceControlLock*>(Lhs.Get()), static_cast<FPlasticSourceControlLock*>(Rhs.Get())) > 0;
+				return SecondaryCompare(&Lhs.Get(), &Rhs.Get()) > 0;
 			}
-		});
+		}, LockRows);
 	}
 }
 
@@ -728,6 +732,12 @@ void SPlasticSourceControlLocksWidget::ExecuteUnlock(TArray<FPlasticSourceContro
 
 void SPlasticSourceControlLocksWidget::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
 {
+	// Publish the rows of the locks filtered in the background
+	if (LocksListFilter.Tick())
+	{
+		OnRowsRefreshUI();
+	}
+
 	if (!ISourceControlModule::Get().IsEnabled() || (!FPlasticSourceControlModule::Get().GetProvider().IsAvailable()))
 	{
 		return;
@@ -802,6 +812,7 @@ void SPlasticSourceControlLocksWidget::OnGetLocksOperationComplete(const FSource
 
 	TSharedRef<FPlasticGetLocks, ESPMode::ThreadSafe> OperationGetLocks = StaticCastSharedRef<FPlasticGetLocks>(InOperation);
 	SourceControlLocks = MoveTemp(OperationGetLocks->Locks);
+	LocksListFilter.SetItems(SourceControlLocks, [this](const FPlasticSourceControlLockRef& InItem, TArray<FString>& OutStrings) { PopulateItemSearchStrings(InItem.Get(), OutStrings); });
 
 	WorkspaceSelector = FPlasticSourceControlModule::Get().GetProvider().GetWorkspaceSelector();
 
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 
 #include "Notification.h"
+#include "PlasticSourceControlListFilter.h"
 
 #include "Misc/TextFilter.h"
 #include "Widgets/DeclarativeSyntaxSupport.h"
@@ -39,6 +40,7 @@ private:
 	void PopulateItemSearchStrings(const FPlasticSourceControlLock& InItem, TArray<FString>& OutStrings);
 
 	void OnRefreshUI();
+	void OnRowsRefreshUI();
 
 	EColumnSortPriority::Type GetColumnSortPriority(const FName InColumnId) const;
 	EColumnSortMode::Type GetColumnSortMode(const FName InColumnId) const;
@@ -104,6 +106,7 @@ private:
 
 	TArray<FPlasticSourceControlLockRef> SourceControlLocks; // Full list from source (filtered by date)
 	TArray<FPlasticSourceControlLockRef> LockRows; // Filtered list to display based on the search text filter
+	TPlasticSourceControlListFilter<FPlasticSourceControlLockRef> LocksListFilter; // Search index and cached sorts of the full list, to filter it incrementally
 
 	/** Delegate handle for the HandleSourceControlStateChanged function callback */
 	FDelegateHandle SourceControlStateChangedDelegateHandle;